@@ -5,6 +5,7 @@ set( ARTIFACTS
     ${SOURCE_DIR}/byte.hpp
     ${SOURCE_DIR}/http.hpp
     ${SOURCE_DIR}/rule.hpp
+    ${SOURCE_DIR}/route.hpp
     ${SOURCE_DIR}/common.hpp
     ${SOURCE_DIR}/string.hpp
     ${SOURCE_DIR}/logger.hpp
@@ -13,11 +14,17 @@ set( ARTIFACTS
     ${SOURCE_DIR}/session.hpp
     ${SOURCE_DIR}/settings.hpp
     ${SOURCE_DIR}/response.hpp
+    ${SOURCE_DIR}/body_file.hpp
+    ${SOURCE_DIR}/multipart_parser.hpp
+    ${SOURCE_DIR}/urlencoded_parser.hpp
     ${SOURCE_DIR}/resource.hpp
     ${SOURCE_DIR}/web_socket.hpp
     ${SOURCE_DIR}/status_code.hpp
+    ${SOURCE_DIR}/trace_event.hpp
     ${SOURCE_DIR}/ssl_settings.hpp
+    ${SOURCE_DIR}/buffer_chain.hpp
     ${SOURCE_DIR}/context_value.hpp
+    ${SOURCE_DIR}/async_logger.hpp
     ${SOURCE_DIR}/session_manager.hpp
     ${SOURCE_DIR}/web_socket_message.hpp
     ${SOURCE_DIR}/context_placeholder.hpp
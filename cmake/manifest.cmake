@@ -5,20 +5,38 @@ set( MANIFEST
     ${SOURCE_DIR}/rule.cpp
     ${SOURCE_DIR}/http.cpp
     ${SOURCE_DIR}/string.cpp
+    ${SOURCE_DIR}/common.cpp
     ${SOURCE_DIR}/request.cpp
     ${SOURCE_DIR}/service.cpp
     ${SOURCE_DIR}/session.cpp
     ${SOURCE_DIR}/resource.cpp
     ${SOURCE_DIR}/response.cpp
+    ${SOURCE_DIR}/body_file.cpp
+    ${SOURCE_DIR}/multipart_parser.cpp
+    ${SOURCE_DIR}/urlencoded_parser.cpp
     ${SOURCE_DIR}/settings.cpp
     ${SOURCE_DIR}/web_socket.cpp
     ${SOURCE_DIR}/ssl_settings.cpp
+    ${SOURCE_DIR}/buffer_chain.cpp
     ${SOURCE_DIR}/session_manager.cpp
+    ${SOURCE_DIR}/async_logger.cpp
+    ${SOURCE_DIR}/detail/uri_impl.cpp
+    ${SOURCE_DIR}/detail/filter_impl.cpp
+    ${SOURCE_DIR}/detail/handler_allocator_impl.cpp
+    ${SOURCE_DIR}/detail/method_impl.cpp
+    ${SOURCE_DIR}/detail/rule_engine_impl.cpp
+    ${SOURCE_DIR}/detail/header_map_impl.cpp
     ${SOURCE_DIR}/detail/http_impl.cpp
+    ${SOURCE_DIR}/detail/body_file_impl.cpp
+    ${SOURCE_DIR}/detail/multipart_parser_impl.cpp
     ${SOURCE_DIR}/web_socket_message.cpp
     ${SOURCE_DIR}/detail/socket_impl.cpp
     ${SOURCE_DIR}/detail/service_impl.cpp
+    ${SOURCE_DIR}/detail/async_logger_impl.cpp
     ${SOURCE_DIR}/detail/session_impl.cpp
+    ${SOURCE_DIR}/detail/pipeline_impl.cpp
+    ${SOURCE_DIR}/detail/hpack_impl.cpp
+    ${SOURCE_DIR}/detail/http2_connection_impl.cpp
     ${SOURCE_DIR}/detail/web_socket_impl.cpp
     ${SOURCE_DIR}/detail/web_socket_manager_impl.cpp
 )
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <cstdarg>
+#include <ciso646>
+
+//Project Includes
+#include "corvusoft/restbed/async_logger.hpp"
+#include "corvusoft/restbed/detail/async_logger_impl.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::size_t;
+using std::string;
+using std::function;
+using std::shared_ptr;
+using std::chrono::milliseconds;
+
+//Project Namespaces
+using restbed::detail::AsyncLoggerImpl;
+
+//External Namespaces
+
+namespace restbed
+{
+    AsyncLogger::AsyncLogger( void ) : Logger( ),
+        m_pimpl( new AsyncLoggerImpl )
+    {
+        return;
+    }
+    
+    AsyncLogger::~AsyncLogger( void )
+    {
+        try
+        {
+            m_pimpl->stop( );
+        }
+        catch ( ... )
+        {
+            return;
+        }
+    }
+    
+    void AsyncLogger::stop( void )
+    {
+        m_pimpl->stop( );
+    }
+    
+    void AsyncLogger::start( const shared_ptr< const Settings >& )
+    {
+        m_pimpl->start( );
+    }
+    
+    void AsyncLogger::flush( void )
+    {
+        m_pimpl->flush( );
+    }
+    
+    void AsyncLogger::log( const Level level, const char* format, ... )
+    {
+        if ( not is_enabled( level ) )
+        {
+            return;
+        }
+        
+        va_list arguments;
+        va_start( arguments, format );
+        m_pimpl->write( level, format, arguments );
+        va_end( arguments );
+    }
+    
+    void AsyncLogger::log_if( bool expression, const Level level, const char* format, ... )
+    {
+        if ( not expression or not is_enabled( level ) )
+        {
+            return;
+        }
+        
+        va_list arguments;
+        va_start( arguments, format );
+        m_pimpl->write( level, format, arguments );
+        va_end( arguments );
+    }
+    
+    bool AsyncLogger::is_enabled( const Level level ) const
+    {
+        const auto index = static_cast< unsigned int >( level ) / 1000;
+        return index > 31 or ( m_pimpl->m_levels.load( std::memory_order_relaxed ) & ( 1u << index ) );
+    }
+    
+    AsyncLogger::Mode AsyncLogger::get_mode( void ) const
+    {
+        return m_pimpl->m_mode;
+    }
+    
+    size_t AsyncLogger::get_capacity( void ) const
+    {
+        return m_pimpl->m_capacity;
+    }
+    
+    milliseconds AsyncLogger::get_flush_interval( void ) const
+    {
+        return m_pimpl->m_flush_interval;
+    }
+    
+    void AsyncLogger::set_mode( const Mode value )
+    {
+        m_pimpl->m_mode = value;
+    }
+    
+    void AsyncLogger::set_capacity( const size_t value )
+    {
+        m_pimpl->m_capacity = value;
+    }
+    
+    void AsyncLogger::set_enabled( const Level level, const bool value )
+    {
+        const auto index = static_cast< unsigned int >( level ) / 1000;
+        
+        if ( index > 31 )
+        {
+            return;
+        }
+        
+        if ( value )
+        {
+            m_pimpl->m_levels.fetch_or( 1u << index );
+        }
+        else
+        {
+            m_pimpl->m_levels.fetch_and( ~( 1u << index ) );
+        }
+    }
+    
+    void AsyncLogger::set_flush_interval( const milliseconds& value )
+    {
+        m_pimpl->m_flush_interval = value;
+    }
+    
+    void AsyncLogger::set_sink( const function< void ( const Level, const string& ) >& value )
+    {
+        m_pimpl->m_sink = ( value == nullptr ) ? AsyncLoggerImpl::default_sink : value;
+    }
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <chrono>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <functional>
+
+//Project Includes
+#include <corvusoft/restbed/logger.hpp>
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    class Settings;
+    
+    namespace detail
+    {
+        class AsyncLoggerImpl;
+    }
+    
+    class AsyncLogger : public Logger
+    {
+        public:
+            //Friends
+            
+            //Definitions
+            enum Mode : int
+            {
+                IMMEDIATE = 0,
+                DEFERRED = 1
+            };
+            
+            //Constructors
+            AsyncLogger( void );
+            
+            virtual ~AsyncLogger( void );
+            
+            //Functionality
+            void stop( void );
+            
+            void start( const std::shared_ptr< const Settings >& settings );
+            
+            void flush( void );
+            
+            void log( const Level level, const char* format, ... );
+            
+            void log_if( bool expression, const Level level, const char* format, ... );
+            
+            bool is_enabled( const Level level ) const;
+            
+            //Getters
+            Mode get_mode( void ) const;
+            
+            std::size_t get_capacity( void ) const;
+            
+            std::chrono::milliseconds get_flush_interval( void ) const;
+            
+            //Setters
+            void set_mode( const Mode value );
+            
+            void set_capacity( const std::size_t value );
+            
+            void set_enabled( const Level level, const bool value );
+            
+            void set_flush_interval( const std::chrono::milliseconds& value );
+            
+            void set_sink( const std::function< void ( const Level, const std::string& ) >& value );
+            
+            //Operators
+            
+            //Properties
+        
+        protected:
+            //Friends
+            
+            //Definitions
+            
+            //Constructors
+            
+            //Functionality
+            
+            //Getters
+            
+            //Setters
+            
+            //Operators
+            
+            //Properties
+        
+        private:
+            //Friends
+            
+            //Definitions
+            
+            //Constructors
+            AsyncLogger( const AsyncLogger& original ) = delete;
+            
+            //Functionality
+            
+            //Getters
+            
+            //Setters
+            
+            //Operators
+            AsyncLogger& operator =( const AsyncLogger& value ) = delete;
+            
+            //Properties
+            std::unique_ptr< detail::AsyncLoggerImpl > m_pimpl;
+    };
+}
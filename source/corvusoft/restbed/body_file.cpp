@@ -0,0 +1,53 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+
+//Project Includes
+#include "corvusoft/restbed/body_file.hpp"
+#include "corvusoft/restbed/detail/body_file_impl.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::size_t;
+using std::string;
+
+//Project Namespaces
+using restbed::detail::BodyFileImpl;
+
+//External Namespaces
+
+namespace restbed
+{
+    BodyFile::~BodyFile( void )
+    {
+        m_pimpl->close( );
+    }
+    
+    Bytes BodyFile::read( const size_t offset, const size_t length ) const
+    {
+        return m_pimpl->read( offset, length );
+    }
+    
+    size_t BodyFile::get_size( void ) const
+    {
+        return m_pimpl->m_size;
+    }
+    
+    string BodyFile::get_path( void ) const
+    {
+        return m_pimpl->m_path;
+    }
+    
+    int BodyFile::get_descriptor( void ) const
+    {
+        return m_pimpl->m_descriptor;
+    }
+    
+    BodyFile::BodyFile( void ) : m_pimpl( new BodyFileImpl )
+    {
+        return;
+    }
+}
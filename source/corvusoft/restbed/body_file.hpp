@@ -0,0 +1,100 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <memory>
+#include <string>
+#include <cstddef>
+
+//Project Includes
+#include <corvusoft/restbed/byte.hpp>
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    namespace detail
+    {
+        class SessionImpl;
+        struct BodyFileImpl;
+        struct MultipartParserImpl;
+    }
+    
+    class BodyFile
+    {
+        public:
+            //Friends
+            
+            //Definitions
+            
+            //Constructors
+            virtual ~BodyFile( void );
+            
+            //Functionality
+            Bytes read( const std::size_t offset, const std::size_t length ) const;
+            
+            //Getters
+            std::size_t get_size( void ) const;
+            
+            std::string get_path( void ) const;
+            
+            int get_descriptor( void ) const;
+            
+            //Setters
+            
+            //Operators
+            
+            //Properties
+        
+        protected:
+            //Friends
+            
+            //Definitions
+            
+            //Constructors
+            
+            //Functionality
+            
+            //Getters
+            
+            //Setters
+            
+            //Operators
+            
+            //Properties
+        
+        private:
+            //Friends
+            friend detail::SessionImpl;
+            friend detail::MultipartParserImpl;
+            
+            //Definitions
+            
+            //Constructors
+            BodyFile( void );
+            
+            BodyFile( const BodyFile& original ) = delete;
+            
+            //Functionality
+            
+            //Getters
+            
+            //Setters
+            
+            //Operators
+            BodyFile& operator =( const BodyFile& value ) = delete;
+            
+            //Properties
+            std::unique_ptr< detail::BodyFileImpl > m_pimpl;
+    };
+}
@@ -0,0 +1,359 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <cstring>
+#include <ciso646>
+#include <algorithm>
+#include <stdexcept>
+
+//Project Includes
+#include "corvusoft/restbed/buffer_chain.hpp"
+#include "corvusoft/restbed/detail/pool_impl.hpp"
+#include "corvusoft/restbed/detail/buffer_chain_impl.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::min;
+using std::pair;
+using std::size_t;
+using std::memcmp;
+using std::memcpy;
+using std::string;
+using std::vector;
+using std::shared_ptr;
+using std::make_shared;
+using std::out_of_range;
+
+//Project Namespaces
+using restbed::detail::PoolImpl;
+using restbed::detail::SlabImpl;
+using restbed::detail::SegmentImpl;
+using restbed::detail::BufferChainImpl;
+
+//External Namespaces
+
+namespace restbed
+{
+    static SlabImpl* create_slab( void )
+    {
+        return new SlabImpl;
+    }
+    
+    static bool recycle_slab( SlabImpl& slab )
+    {
+        slab.m_length = 0;
+        return true;
+    }
+    
+    static SegmentImpl adopt( const shared_ptr< const Bytes >& value )
+    {
+        SegmentImpl segment;
+        segment.m_owner = value;
+        segment.m_data = value->data( );
+        segment.m_length = value->size( );
+        segment.m_bytes = value.get( );
+        
+        return segment;
+    }
+    
+    BufferChain::BufferChain( void ) : m_pimpl( new BufferChainImpl )
+    {
+        return;
+    }
+    
+    BufferChain::BufferChain( Bytes&& value ) : m_pimpl( new BufferChainImpl )
+    {
+        append( std::move( value ) );
+    }
+    
+    BufferChain::BufferChain( const Bytes& value ) : m_pimpl( new BufferChainImpl )
+    {
+        append( Bytes( value ) );
+    }
+    
+    BufferChain::BufferChain( const string& value ) : m_pimpl( new BufferChainImpl )
+    {
+        append( Bytes( value.begin( ), value.end( ) ) );
+    }
+    
+    BufferChain::BufferChain( const shared_ptr< const Bytes >& value ) : m_pimpl( new BufferChainImpl )
+    {
+        append( value );
+    }
+    
+    BufferChain::BufferChain( const BufferChain& original ) : m_pimpl( new BufferChainImpl( *original.m_pimpl ) )
+    {
+        return;
+    }
+    
+    BufferChain::~BufferChain( void )
+    {
+        return;
+    }
+    
+    void BufferChain::clear( void )
+    {
+        m_pimpl->m_length = 0;
+        m_pimpl->m_segments.clear( );
+    }
+    
+    bool BufferChain::is_empty( void ) const
+    {
+        return m_pimpl->m_length == 0;
+    }
+    
+    void BufferChain::append( Bytes&& value )
+    {
+        if ( not value.empty( ) )
+        {
+            append( make_shared< const Bytes >( std::move( value ) ) );
+        }
+    }
+    
+    void BufferChain::append( const Bytes& value )
+    {
+        append( value.data( ), value.size( ) );
+    }
+    
+    void BufferChain::append( const string& value )
+    {
+        append( reinterpret_cast< const Byte* >( value.data( ) ), value.size( ) );
+    }
+    
+    void BufferChain::append( const BufferChain& value )
+    {
+        const auto segments = value.m_pimpl->m_segments;
+        
+        m_pimpl->m_length += value.m_pimpl->m_length;
+        m_pimpl->m_segments.insert( m_pimpl->m_segments.end( ), segments.begin( ), segments.end( ) );
+    }
+    
+    void BufferChain::append( const shared_ptr< const Bytes >& value )
+    {
+        if ( value == nullptr or value->empty( ) )
+        {
+            return;
+        }
+        
+        m_pimpl->m_length += value->size( );
+        m_pimpl->m_segments.push_back( adopt( value ) );
+    }
+    
+    void BufferChain::append( const Byte* data, size_t length )
+    {
+        auto& segments = m_pimpl->m_segments;
+        
+        while ( length not_eq 0 )
+        {
+            if ( not segments.empty( ) and segments.back( ).m_slab not_eq nullptr )
+            {
+                auto& tail = segments.back( );
+                size_t end = static_cast< size_t >( tail.m_data - tail.m_slab->m_data ) + tail.m_length;
+                const size_t size = min( SlabImpl::CAPACITY - end, length );
+                
+                //Another chain sharing this slab may already have claimed the bytes after our tail.
+                if ( size not_eq 0 and tail.m_slab->m_length.compare_exchange_strong( end, end + size ) )
+                {
+                    memcpy( tail.m_slab->m_data + end, data, size );
+                    tail.m_length += size;
+                    m_pimpl->m_length += size;
+                    data += size;
+                    length -= size;
+                    continue;
+                }
+            }
+            
+            const auto slab = PoolImpl< SlabImpl, &create_slab, &recycle_slab, 128 >::acquire( );
+            const size_t size = min( SlabImpl::CAPACITY, length );
+            memcpy( slab->m_data, data, size );
+            slab->m_length = size;
+            
+            SegmentImpl segment;
+            segment.m_owner = slab;
+            segment.m_data = slab->m_data;
+            segment.m_length = size;
+            segment.m_slab = slab.get( );
+            segments.push_back( segment );
+            
+            m_pimpl->m_length += size;
+            data += size;
+            length -= size;
+        }
+    }
+    
+    void BufferChain::consume( size_t length )
+    {
+        auto& segments = m_pimpl->m_segments;
+        auto segment = segments.begin( );
+        
+        length = min( length, m_pimpl->m_length );
+        m_pimpl->m_length -= length;
+        
+        while ( segment not_eq segments.end( ) and length >= segment->m_length )
+        {
+            length -= segment->m_length;
+            segment++;
+        }
+        
+        segments.erase( segments.begin( ), segment );
+        
+        if ( length not_eq 0 )
+        {
+            segments.front( ).m_data += length;
+            segments.front( ).m_length -= length;
+        }
+    }
+    
+    BufferChain BufferChain::slice( size_t offset, size_t length ) const
+    {
+        if ( offset > m_pimpl->m_length or length > m_pimpl->m_length - offset )
+        {
+            throw out_of_range( "Buffer chain slice exceeds the chain length." );
+        }
+        
+        BufferChain result;
+        result.m_pimpl->m_length = length;
+        
+        for ( const auto& segment : m_pimpl->m_segments )
+        {
+            if ( length == 0 )
+            {
+                break;
+            }
+            
+            if ( offset >= segment.m_length )
+            {
+                offset -= segment.m_length;
+                continue;
+            }
+            
+            SegmentImpl part = segment;
+            part.m_data += offset;
+            part.m_length = min( segment.m_length - offset, length );
+            result.m_pimpl->m_segments.push_back( part );
+            
+            length -= part.m_length;
+            offset = 0;
+        }
+        
+        return result;
+    }
+    
+    const Bytes& BufferChain::flatten( void ) const
+    {
+        static const Bytes empty { };
+        
+        auto& segments = m_pimpl->m_segments;
+        
+        if ( segments.empty( ) )
+        {
+            return empty;
+        }
+        
+        const auto& front = segments.front( );
+        
+        if ( segments.size( ) == 1 and front.m_bytes not_eq nullptr and front.m_data == front.m_bytes->data( ) and front.m_length == front.m_bytes->size( ) )
+        {
+            return *front.m_bytes;
+        }
+        
+        auto bytes = make_shared< Bytes >( );
+        bytes->reserve( m_pimpl->m_length );
+        
+        for ( const auto& segment : segments )
+        {
+            bytes->insert( bytes->end( ), segment.m_data, segment.m_data + segment.m_length );
+        }
+        
+        segments.clear( );
+        segments.push_back( adopt( bytes ) );
+        
+        return *bytes;
+    }
+    
+    string BufferChain::to_string( void ) const
+    {
+        string value = "";
+        value.reserve( m_pimpl->m_length );
+        
+        for ( const auto& segment : m_pimpl->m_segments )
+        {
+            value.append( reinterpret_cast< const char* >( segment.m_data ), segment.m_length );
+        }
+        
+        return value;
+    }
+    
+    size_t BufferChain::get_size( void ) const
+    {
+        return m_pimpl->m_length;
+    }
+    
+    vector< pair< const Byte*, size_t > > BufferChain::get_segments( void ) const
+    {
+        vector< pair< const Byte*, size_t > > segments;
+        segments.reserve( m_pimpl->m_segments.size( ) );
+        
+        for ( const auto& segment : m_pimpl->m_segments )
+        {
+            segments.emplace_back( segment.m_data, segment.m_length );
+        }
+        
+        return segments;
+    }
+    
+    BufferChain& BufferChain::operator =( const BufferChain& rhs )
+    {
+        *m_pimpl = *rhs.m_pimpl;
+        
+        return *this;
+    }
+    
+    bool BufferChain::operator ==( const BufferChain& rhs ) const
+    {
+        if ( m_pimpl->m_length not_eq rhs.m_pimpl->m_length )
+        {
+            return false;
+        }
+        
+        auto left = m_pimpl->m_segments.begin( );
+        auto right = rhs.m_pimpl->m_segments.begin( );
+        size_t left_offset = 0;
+        size_t right_offset = 0;
+        
+        while ( left not_eq m_pimpl->m_segments.end( ) and right not_eq rhs.m_pimpl->m_segments.end( ) )
+        {
+            const auto size = min( left->m_length - left_offset, right->m_length - right_offset );
+            
+            if ( memcmp( left->m_data + left_offset, right->m_data + right_offset, size ) not_eq 0 )
+            {
+                return false;
+            }
+            
+            left_offset += size;
+            right_offset += size;
+            
+            if ( left_offset == left->m_length )
+            {
+                left++;
+                left_offset = 0;
+            }
+            
+            if ( right_offset == right->m_length )
+            {
+                right++;
+                right_offset = 0;
+            }
+        }
+        
+        return true;
+    }
+    
+    bool BufferChain::operator !=( const BufferChain& rhs ) const
+    {
+        return not ( *this == rhs );
+    }
+}
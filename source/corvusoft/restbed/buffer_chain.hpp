@@ -0,0 +1,131 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+//Project Includes
+#include <corvusoft/restbed/byte.hpp>
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    namespace detail
+    {
+        struct BufferChainImpl;
+    }
+    
+    class BufferChain
+    {
+        public:
+            //Friends
+            
+            //Definitions
+            
+            //Constructors
+            BufferChain( void );
+            
+            explicit BufferChain( Bytes&& value );
+            
+            explicit BufferChain( const Bytes& value );
+            
+            explicit BufferChain( const std::string& value );
+            
+            explicit BufferChain( const std::shared_ptr< const Bytes >& value );
+            
+            BufferChain( const BufferChain& original );
+            
+            virtual ~BufferChain( void );
+            
+            //Functionality
+            void clear( void );
+            
+            bool is_empty( void ) const;
+            
+            void append( Bytes&& value );
+            
+            void append( const Bytes& value );
+            
+            void append( const std::string& value );
+            
+            void append( const BufferChain& value );
+            
+            void append( const std::shared_ptr< const Bytes >& value );
+            
+            void append( const Byte* data, const std::size_t length );
+            
+            void consume( const std::size_t length );
+            
+            BufferChain slice( const std::size_t offset, const std::size_t length ) const;
+            
+            const Bytes& flatten( void ) const;
+            
+            std::string to_string( void ) const;
+            
+            //Getters
+            std::size_t get_size( void ) const;
+            
+            std::vector< std::pair< const Byte*, std::size_t > > get_segments( void ) const;
+            
+            //Setters
+            
+            //Operators
+            BufferChain& operator =( const BufferChain& rhs );
+            
+            bool operator ==( const BufferChain& rhs ) const;
+            
+            bool operator !=( const BufferChain& rhs ) const;
+            
+            //Properties
+        
+        protected:
+            //Friends
+            
+            //Definitions
+            
+            //Constructors
+            
+            //Functionality
+            
+            //Getters
+            
+            //Setters
+            
+            //Operators
+            
+            //Properties
+        
+        private:
+            //Friends
+            
+            //Definitions
+            
+            //Constructors
+            
+            //Functionality
+            
+            //Getters
+            
+            //Setters
+            
+            //Operators
+            
+            //Properties
+            std::unique_ptr< detail::BufferChainImpl > m_pimpl;
+    };
+}
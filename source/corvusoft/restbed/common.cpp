@@ -0,0 +1,302 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <cerrno>
+#include <cstdlib>
+#include <clocale>
+#include <ciso646>
+
+//Project Includes
+#include "corvusoft/restbed/common.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::string;
+using std::strtof;
+using std::strtod;
+using std::strtold;
+using std::int64_t;
+using std::uint64_t;
+using std::localeconv;
+using std::numeric_limits;
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    static bool is_digit( const char character )
+    {
+        return character >= '0' and character <= '9';
+    }
+    
+    static const char* skip_whitespace( const char* position, const char* end )
+    {
+        while ( position < end and ( *position == ' ' or ( *position >= '\t' and *position <= '\r' ) ) )
+        {
+            position++;
+        }
+        
+        return position;
+    }
+    
+    static bool has_prefix( const char* position, const char* end, const char* literal )
+    {
+        for ( ; *literal not_eq 0; position++, literal++ )
+        {
+            if ( position == end or ( *position | 0x20 ) not_eq *literal )
+            {
+                return false;
+            }
+        }
+        
+        return true;
+    }
+    
+    static bool parse_magnitude( const char* position, const char* end, uint64_t& result )
+    {
+        if ( position == end or not is_digit( *position ) )
+        {
+            return false;
+        }
+        
+        uint64_t value = 0;
+        
+        for ( ; position < end and is_digit( *position ); position++ )
+        {
+            const uint64_t digit = *position - '0';
+            
+            if ( value > ( numeric_limits< uint64_t >::max( ) - digit ) / 10 )
+            {
+                return false;
+            }
+            
+            value = value * 10 + digit;
+        }
+        
+        result = value;
+        return true;
+    }
+    
+    //Decimal fast path: exact when the significand and power of ten are both exactly representable.
+    template< typename Type >
+    static bool parse_floating( const string& value, Type& result, const int digits, const Type* powers, const int maximum_power, Type ( *convert )( const char*, char** ) )
+    {
+        const char* end = value.data( ) + value.length( );
+        const char* start = skip_whitespace( value.data( ), end );
+        const char* position = start;
+        
+        const bool negative = ( position < end and *position == '-' );
+        
+        if ( position < end and ( *position == '-' or *position == '+' ) )
+        {
+            position++;
+        }
+        
+        uint64_t significand = 0;
+        int significant = 0;
+        int exponent = 0;
+        bool truncated = false;
+        bool found = false;
+        
+        auto append = [ & ]( const int digit, const bool fraction )
+        {
+            found = true;
+            
+            if ( significand == 0 and digit == 0 )
+            {
+                exponent -= ( fraction ) ? 1 : 0;
+            }
+            else if ( significant < 19 )
+            {
+                significand = significand * 10 + digit;
+                significant++;
+                exponent -= ( fraction ) ? 1 : 0;
+            }
+            else
+            {
+                exponent += ( fraction ) ? 0 : 1;
+                truncated = truncated or digit not_eq 0;
+            }
+        };
+        
+        for ( ; position < end and is_digit( *position ); position++ )
+        {
+            append( *position - '0', false );
+        }
+        
+        if ( position < end and *position == '.' )
+        {
+            for ( position++; position < end and is_digit( *position ); position++ )
+            {
+                append( *position - '0', true );
+            }
+        }
+        
+        if ( not found )
+        {
+            return false;
+        }
+        
+        if ( position < end and ( *position == 'e' or *position == 'E' ) )
+        {
+            const char* marker = position + 1;
+            const bool negative_exponent = ( marker < end and *marker == '-' );
+            
+            if ( marker < end and ( *marker == '-' or *marker == '+' ) )
+            {
+                marker++;
+            }
+            
+            if ( marker < end and is_digit( *marker ) )
+            {
+                int explicit_exponent = 0;
+                
+                for ( ; marker < end and is_digit( *marker ); marker++ )
+                {
+                    explicit_exponent = ( explicit_exponent < 100000 ) ? explicit_exponent * 10 + ( *marker - '0' ) : explicit_exponent;
+                }
+                
+                exponent += ( negative_exponent ) ? -explicit_exponent : explicit_exponent;
+                position = marker;
+            }
+        }
+        
+        if ( significand == 0 )
+        {
+            result = ( negative ) ? -Type( 0 ) : Type( 0 );
+            return true;
+        }
+        
+        if ( not truncated and significant <= digits and exponent >= -maximum_power and exponent <= maximum_power )
+        {
+            Type number = static_cast< Type >( significand );
+            number = ( exponent < 0 ) ? number / powers[ -exponent ] : number * powers[ exponent ];
+            result = ( negative ) ? -number : number;
+            return true;
+        }
+        
+        string token( start, position );
+        const string decimal_point = localeconv( )->decimal_point;
+        
+        if ( decimal_point not_eq "." )
+        {
+            const auto index = token.find( '.' );
+            
+            if ( index not_eq string::npos )
+            {
+                token.replace( index, 1, decimal_point );
+            }
+        }
+        
+        errno = 0;
+        char* finish = nullptr;
+        const Type number = convert( token.data( ), &finish );
+        
+        if ( errno == ERANGE or finish == token.data( ) )
+        {
+            return false;
+        }
+        
+        result = number;
+        return true;
+    }
+    
+    bool Common::parse( const string& value, bool& result )
+    {
+        const char* end = value.data( ) + value.length( );
+        const char* position = skip_whitespace( value.data( ), end );
+        
+        if ( has_prefix( position, end, "true" ) or has_prefix( position, end, "false" ) )
+        {
+            result = ( *position == 't' or *position == 'T' );
+            return true;
+        }
+        
+        uint64_t number = 0;
+        
+        if ( not parse_magnitude( position, end, number ) or number > 1 )
+        {
+            return false;
+        }
+        
+        result = ( number == 1 );
+        return true;
+    }
+    
+    bool Common::parse( const string& value, float& result )
+    {
+        static const float powers[ ] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+        return parse_floating< float >( value, result, 7, powers, 10, strtof );
+    }
+    
+    bool Common::parse( const string& value, double& result )
+    {
+        static const double powers[ ] =
+        {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        
+        return parse_floating< double >( value, result, 15, powers, 22, strtod );
+    }
+    
+    bool Common::parse( const string& value, long double& result )
+    {
+        static const long double powers[ ] = { 1e0L };
+        return parse_floating< long double >( value, result, 0, powers, -1, strtold );
+    }
+    
+    bool Common::parse( const string& value, int64_t& result )
+    {
+        const char* end = value.data( ) + value.length( );
+        const char* position = skip_whitespace( value.data( ), end );
+        
+        const bool negative = ( position < end and *position == '-' );
+        
+        if ( position < end and ( *position == '-' or *position == '+' ) )
+        {
+            position++;
+        }
+        
+        uint64_t magnitude = 0;
+        
+        if ( not parse_magnitude( position, end, magnitude ) )
+        {
+            return false;
+        }
+        
+        const uint64_t limit = static_cast< uint64_t >( numeric_limits< int64_t >::max( ) );
+        
+        if ( negative and magnitude == limit + 1 )
+        {
+            result = numeric_limits< int64_t >::min( );
+            return true;
+        }
+        
+        if ( magnitude > limit )
+        {
+            return false;
+        }
+        
+        result = ( negative ) ? -static_cast< int64_t >( magnitude ) : static_cast< int64_t >( magnitude );
+        return true;
+    }
+    
+    bool Common::parse( const string& value, uint64_t& result )
+    {
+        const char* end = value.data( ) + value.length( );
+        const char* position = skip_whitespace( value.data( ), end );
+        
+        if ( position < end and *position == '+' )
+        {
+            position++;
+        }
+        
+        return parse_magnitude( position, end, result );
+    }
+}
@@ -5,10 +5,13 @@
 #pragma once
 
 //System Includes
+#include <limits>
 #include <string>
+#include <cstdint>
 #include <utility>
 #include <sstream>
 #include <algorithm>
+#include <functional>
 #include <type_traits>
 
 //Project Includes
@@ -36,29 +39,52 @@ namespace restbed
             //Constructors
             
             //Functionality
+            //Locale independent parsing of the number leading value, ignoring preceding whitespace; returns false if absent or out of range.
+            static bool parse( const std::string& value, bool& result );
+            
+            static bool parse( const std::string& value, float& result );
+            
+            static bool parse( const std::string& value, double& result );
+            
+            static bool parse( const std::string& value, long double& result );
+            
+            static bool parse( const std::string& value, std::int64_t& result );
+            
+            static bool parse( const std::string& value, std::uint64_t& result );
+            
+            template< typename Type >
+            static bool parse( const std::string& value, Type& result )
+            {
+                return parse_number( value, result, Category< Type >( ) );
+            }
+            
             template< typename Type >
             static Type parse_parameter( const std::string& value, const Type default_value )
             {
-                std::istringstream stream( value );
-                
-                Type parameter;
-                stream >> parameter;
-                
-                if ( stream.fail( ) )
+                Type parameter = default_value;
+                return ( parse_number( value, parameter, Category< Type >( ) ) ) ? parameter : default_value;
+            }
+            
+            template< typename Type >
+            static const std::string* find_parameter( const std::string& name, const Type& parameters )
+            {
+                for ( const auto& parameter : parameters )
                 {
-                    return default_value;
+                    if ( String::equals( name, parameter.first, String::CASE_INSENSITIVE ) )
+                    {
+                        return &parameter.second;
+                    }
                 }
                 
-                return parameter;
+                return nullptr;
             }
             
             template< typename Type >
             static bool has_parameter( const std::string& name, const Type& parameters )
             {
-                const auto key = String::lowercase( name );
-                const auto iterator = std::find_if( parameters.begin( ), parameters.end( ), [ &key ]( const std::pair< std::string, std::string >& value )
+                const auto iterator = std::find_if( parameters.begin( ), parameters.end( ), [ &name ]( const typename Type::value_type& value )
                 {
-                    return ( key == String::lowercase( value.first ) );
+                    return String::equals( name, value.first, String::CASE_INSENSITIVE );
                 } );
                 
                 return iterator not_eq parameters.end( );
@@ -78,12 +104,11 @@ namespace restbed
                     return parameters;
                 }
                 
-                const auto key = String::lowercase( name );
                 Type results;
                 
                 for ( const auto& parameter : parameters )
                 {
-                    if ( key == String::lowercase( parameter.first ) )
+                    if ( String::equals( name, parameter.first, String::CASE_INSENSITIVE ) )
                     {
                         results.insert( parameter );
                     }
@@ -119,6 +144,22 @@ namespace restbed
             //Friends
             
             //Definitions
+            enum Kind : int
+            {
+                EXACT = 0,
+                CHARACTER = 1,
+                SIGNED = 2,
+                UNSIGNED = 3
+            };
+            
+            template< typename Type >
+            struct Category : std::integral_constant < int,
+                    ( std::is_floating_point< Type >::value or std::is_same< Type, bool >::value ) ? EXACT :
+                    ( std::is_same< Type, char >::value or std::is_same< Type, signed char >::value or std::is_same< Type, unsigned char >::value or
+                      std::is_same< Type, wchar_t >::value or std::is_same< Type, char16_t >::value or std::is_same< Type, char32_t >::value ) ? CHARACTER :
+                    ( std::is_signed< Type >::value ) ? SIGNED : UNSIGNED >
+            {
+            };
             
             //Constructors
             Common( void ) = delete;
@@ -128,6 +169,48 @@ namespace restbed
             virtual ~Common( void ) = delete;
             
             //Functionality
+            template< typename Type >
+            static bool parse_number( const std::string& value, Type& result, std::integral_constant< int, EXACT > )
+            {
+                return parse( value, result );
+            }
+            
+            template< typename Type >
+            static bool parse_number( const std::string& value, Type& result, std::integral_constant< int, CHARACTER > )
+            {
+                std::istringstream stream( value );
+                stream >> result;
+                
+                return not stream.fail( );
+            }
+            
+            template< typename Type >
+            static bool parse_number( const std::string& value, Type& result, std::integral_constant< int, SIGNED > )
+            {
+                std::int64_t number = 0;
+                
+                if ( not parse( value, number ) or number < std::numeric_limits< Type >::min( ) or number > std::numeric_limits< Type >::max( ) )
+                {
+                    return false;
+                }
+                
+                result = static_cast< Type >( number );
+                return true;
+            }
+            
+            template< typename Type >
+            static bool parse_number( const std::string& value, Type& result, std::integral_constant< int, UNSIGNED > )
+            {
+                std::uint64_t number = 0;
+                
+                if ( not parse( value, number ) or number > std::numeric_limits< Type >::max( ) )
+                {
+                    return false;
+                }
+                
+                result = static_cast< Type >( number );
+                return true;
+            }
             
             //Getters
             
@@ -0,0 +1,762 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <ciso646>
+#include <algorithm>
+
+//Project Includes
+#include "corvusoft/restbed/detail/async_logger_impl.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::min;
+using std::pair;
+using std::mutex;
+using std::size_t;
+using std::string;
+using std::thread;
+using std::vector;
+using std::intmax_t;
+using std::uint16_t;
+using std::uint32_t;
+using std::uint64_t;
+using std::uintmax_t;
+using std::ptrdiff_t;
+using std::to_string;
+using std::exception;
+using std::make_pair;
+using std::unique_ptr;
+using std::lock_guard;
+using std::unique_lock;
+using std::make_shared;
+using std::chrono::milliseconds;
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    namespace detail
+    {
+        LogBuffer::LogBuffer( const size_t capacity ) : m_mask( 0 ),
+            m_entries( ),
+            m_head( 0 ),
+            m_tail( 0 )
+        {
+            size_t size = 2;
+            
+            while ( size < capacity )
+            {
+                size <<= 1;
+            }
+            
+            m_mask = size - 1;
+            m_entries.resize( size );
+        }
+        
+        LogBuffer::~LogBuffer( void )
+        {
+            return;
+        }
+        
+        LogEntry* LogBuffer::acquire( void )
+        {
+            const auto tail = m_tail.load( std::memory_order_relaxed );
+            
+            if ( tail - m_head.load( std::memory_order_acquire ) > m_mask )
+            {
+                return nullptr;
+            }
+            
+            return &m_entries[ tail & m_mask ];
+        }
+        
+        void LogBuffer::commit( void )
+        {
+            m_tail.store( m_tail.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+        }
+        
+        LogEntry* LogBuffer::peek( void )
+        {
+            const auto head = m_head.load( std::memory_order_relaxed );
+            
+            if ( head == m_tail.load( std::memory_order_acquire ) )
+            {
+                return nullptr;
+            }
+            
+            return &m_entries[ head & m_mask ];
+        }
+        
+        void LogBuffer::release( void )
+        {
+            m_head.store( m_head.load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+        }
+        
+        AsyncLoggerImpl::AsyncLoggerImpl( void ) : m_serial( next_serial( ) ),
+            m_is_running( false ),
+            m_levels( 0xFFFFFFFF ),
+            m_dropped_entries( 0 ),
+            m_mode( AsyncLogger::IMMEDIATE ),
+            m_capacity( 1024 ),
+            m_flush_interval( 10 ),
+            m_sink( AsyncLoggerImpl::default_sink ),
+            m_buffers_lock( ),
+            m_buffers( ),
+            m_drain_lock( ),
+            m_worker_lock( ),
+            m_worker_condition( ),
+            m_worker( nullptr )
+        {
+            return;
+        }
+        
+        AsyncLoggerImpl::~AsyncLoggerImpl( void )
+        {
+            return;
+        }
+        
+        void AsyncLoggerImpl::stop( void )
+        {
+            {
+                lock_guard< mutex > guard( m_worker_lock );
+                m_is_running = false;
+            }
+            
+            m_worker_condition.notify_all( );
+            
+            if ( m_worker not_eq nullptr )
+            {
+                m_worker->join( );
+                m_worker = nullptr;
+            }
+            
+            drain( );
+        }
+        
+        void AsyncLoggerImpl::start( void )
+        {
+            if ( m_worker not_eq nullptr )
+            {
+                return;
+            }
+            
+            m_is_running = true;
+            m_worker = make_shared< thread >( &AsyncLoggerImpl::run, this );
+        }
+        
+        void AsyncLoggerImpl::flush( void )
+        {
+            drain( );
+        }
+        
+        void AsyncLoggerImpl::write( const Logger::Level level, const char* format, va_list arguments )
+        {
+            auto buffer = get_buffer( );
+            auto entry = buffer->acquire( );
+            
+            if ( entry == nullptr )
+            {
+                m_dropped_entries++;
+                return;
+            }
+            
+            entry->level = level;
+            
+            if ( m_mode == AsyncLogger::DEFERRED )
+            {
+                encode( *entry, format, arguments );
+            }
+            else
+            {
+                const auto length = vsnprintf( entry->payload, sizeof( entry->payload ), format, arguments );
+                entry->format = nullptr;
+                entry->length = ( length < 0 ) ? 0 : min< size_t >( length, sizeof( entry->payload ) - 1 );
+            }
+            
+            buffer->commit( );
+            
+            if ( not m_is_running )
+            {
+                drain( );
+            }
+        }
+        
+        void AsyncLoggerImpl::encode( LogEntry& entry, const char* format, va_list arguments )
+        {
+            entry.format = format;
+            entry.length = 0;
+            
+            bool stored = true;
+            auto position = format;
+            LogSpecifier specifier;
+            
+            while ( stored and parse( position, specifier ) )
+            {
+                for ( int index = 0; stored and index < specifier.asterisks; index++ )
+                {
+                    stored = store( entry, va_arg( arguments, int ) );
+                }
+                
+                if ( not stored )
+                {
+                    break;
+                }
+                
+                switch ( specifier.conversion )
+                {
+                    case 'd':
+                    case 'i':
+                    {
+                        long long value = 0;
+                        
+                        switch ( specifier.length )
+                        {
+                            case 'H':
+                                value = static_cast< signed char >( va_arg( arguments, int ) );
+                                break;
+                            
+                            case 'h':
+                                value = static_cast< short >( va_arg( arguments, int ) );
+                                break;
+                            
+                            case 'l':
+                                value = va_arg( arguments, long );
+                                break;
+                            
+                            case 'q':
+                                value = va_arg( arguments, long long );
+                                break;
+                            
+                            case 'j':
+                                value = va_arg( arguments, intmax_t );
+                                break;
+                            
+                            case 'z':
+                                value = static_cast< long long >( va_arg( arguments, size_t ) );
+                                break;
+                            
+                            case 't':
+                                value = va_arg( arguments, ptrdiff_t );
+                                break;
+                            
+                            default:
+                                value = va_arg( arguments, int );
+                        }
+                        
+                        stored = store( entry, value );
+                        break;
+                    }
+                    
+                    case 'u':
+                    case 'o':
+                    case 'x':
+                    case 'X':
+                    {
+                        unsigned long long value = 0;
+                        
+                        switch ( specifier.length )
+                        {
+                            case 'H':
+                                value = static_cast< unsigned char >( va_arg( arguments, unsigned int ) );
+                                break;
+                            
+                            case 'h':
+                                value = static_cast< unsigned short >( va_arg( arguments, unsigned int ) );
+                                break;
+                            
+                            case 'l':
+                                value = va_arg( arguments, unsigned long );
+                                break;
+                            
+                            case 'q':
+                                value = va_arg( arguments, unsigned long long );
+                                break;
+                            
+                            case 'j':
+                                value = va_arg( arguments, uintmax_t );
+                                break;
+                            
+                            case 'z':
+                                value = va_arg( arguments, size_t );
+                                break;
+                            
+                            case 't':
+                                value = static_cast< unsigned long long >( va_arg( arguments, ptrdiff_t ) );
+                                break;
+                            
+                            default:
+                                value = va_arg( arguments, unsigned int );
+                        }
+                        
+                        stored = store( entry, value );
+                        break;
+                    }
+                    
+                    case 'e':
+                    case 'E':
+                    case 'f':
+                    case 'F':
+                    case 'g':
+                    case 'G':
+                    case 'a':
+                    case 'A':
+                        if ( specifier.length == 'L' )
+                        {
+                            stored = store( entry, va_arg( arguments, long double ) );
+                        }
+                        else
+                        {
+                            stored = store( entry, va_arg( arguments, double ) );
+                        }
+                        
+                        break;
+                    
+                    case 'c':
+                        stored = store( entry, va_arg( arguments, int ) );
+                        break;
+                    
+                    case 'p':
+                        stored = store( entry, va_arg( arguments, void* ) );
+                        break;
+                    
+                    case 'n':
+                        static_cast< void >( va_arg( arguments, void* ) );
+                        break;
+                    
+                    case 's':
+                    {
+                        auto value = va_arg( arguments, const char* );
+                        value = ( value == nullptr ) ? "(null)" : value;
+                        
+                        const size_t available = sizeof( entry.payload ) - entry.length;
+                        stored = available > sizeof( uint16_t );
+                        
+                        if ( stored )
+                        {
+                            const auto size = static_cast< uint16_t >( strnlen( value, available - sizeof( uint16_t ) ) );
+                            store( entry, size );
+                            memcpy( entry.payload + entry.length, value, size );
+                            entry.length += size;
+                        }
+                        
+                        break;
+                    }
+                    
+                    default:
+                        stored = false;
+                }
+            }
+        }
+        
+        string AsyncLoggerImpl::decode( const LogEntry& entry )
+        {
+            if ( entry.format == nullptr )
+            {
+                return string( entry.payload, entry.length );
+            }
+            
+            string message = "";
+            size_t offset = 0;
+            LogSpecifier specifier;
+            auto position = entry.format;
+            const char* literal = entry.format;
+            
+            while ( parse( position, specifier ) )
+            {
+                append( message, literal, specifier.start );
+                literal = specifier.end;
+                
+                bool fetched = true;
+                int asterisks[ 2 ] = { 0, 0 };
+                
+                for ( int index = 0; fetched and index < specifier.asterisks and index < 2; index++ )
+                {
+                    fetched = fetch( entry, offset, asterisks[ index ] );
+                }
+                
+                if ( fetched )
+                {
+                    switch ( specifier.conversion )
+                    {
+                        case 'd':
+                        case 'i':
+                        {
+                            long long value = 0;
+                            fetched = fetch( entry, offset, value );
+                            
+                            if ( fetched )
+                            {
+                                append( message, specifier, "ll", asterisks, value );
+                            }
+                            
+                            break;
+                        }
+                        
+                        case 'u':
+                        case 'o':
+                        case 'x':
+                        case 'X':
+                        {
+                            unsigned long long value = 0;
+                            fetched = fetch( entry, offset, value );
+                            
+                            if ( fetched )
+                            {
+                                append( message, specifier, "ll", asterisks, value );
+                            }
+                            
+                            break;
+                        }
+                        
+                        case 'e':
+                        case 'E':
+                        case 'f':
+                        case 'F':
+                        case 'g':
+                        case 'G':
+                        case 'a':
+                        case 'A':
+                            if ( specifier.length == 'L' )
+                            {
+                                long double value = 0;
+                                fetched = fetch( entry, offset, value );
+                                
+                                if ( fetched )
+                                {
+                                    append( message, specifier, "L", asterisks, value );
+                                }
+                            }
+                            else
+                            {
+                                double value = 0;
+                                fetched = fetch( entry, offset, value );
+                                
+                                if ( fetched )
+                                {
+                                    append( message, specifier, "", asterisks, value );
+                                }
+                            }
+                            
+                            break;
+                        
+                        case 'c':
+                        {
+                            int value = 0;
+                            fetched = fetch( entry, offset, value );
+                            
+                            if ( fetched )
+                            {
+                                append( message, specifier, "", asterisks, value );
+                            }
+                            
+                            break;
+                        }
+                        
+                        case 'p':
+                        {
+                            void* value = nullptr;
+                            fetched = fetch( entry, offset, value );
+                            
+                            if ( fetched )
+                            {
+                                append( message, specifier, "", asterisks, value );
+                            }
+                            
+                            break;
+                        }
+                        
+                        case 'n':
+                            break;
+                        
+                        case 's':
+                        {
+                            uint16_t size = 0;
+                            fetched = fetch( entry, offset, size ) and offset + size <= entry.length;
+                            
+                            if ( fetched )
+                            {
+                                const string value( entry.payload + offset, size );
+                                append( message, specifier, "", asterisks, value.data( ) );
+                                offset += size;
+                            }
+                            
+                            break;
+                        }
+                        
+                        default:
+                            fetched = false;
+                    }
+                }
+                
+                if ( not fetched )
+                {
+                    literal = specifier.start;
+                    break;
+                }
+            }
+            
+            append( message, literal, literal + strlen( literal ) );
+            
+            return message;
+        }
+        
+        bool AsyncLoggerImpl::parse( const char*& position, LogSpecifier& specifier )
+        {
+            while ( *position not_eq '\0' )
+            {
+                if ( *position not_eq '%' )
+                {
+                    position++;
+                    continue;
+                }
+                
+                if ( position[ 1 ] == '%' )
+                {
+                    position += 2;
+                    continue;
+                }
+                
+                specifier = LogSpecifier( );
+                specifier.start = position++;
+                
+                while ( *position not_eq '\0' and strchr( "-+ #0", *position ) not_eq nullptr )
+                {
+                    position++;
+                }
+                
+                if ( *position == '*' )
+                {
+                    specifier.asterisks++;
+                    position++;
+                }
+                
+                while ( isdigit( static_cast< unsigned char >( *position ) ) )
+                {
+                    position++;
+                }
+                
+                if ( *position == '.' )
+                {
+                    position++;
+                    
+                    if ( *position == '*' )
+                    {
+                        specifier.asterisks++;
+                        position++;
+                    }
+                    
+                    while ( isdigit( static_cast< unsigned char >( *position ) ) )
+                    {
+                        position++;
+                    }
+                }
+                
+                specifier.modifier = position;
+                
+                if ( *position == 'h' or *position == 'l' )
+                {
+                    specifier.length = *position++;
+                    
+                    if ( *position == specifier.length )
+                    {
+                        specifier.length = ( specifier.length == 'h' ) ? 'H' : 'q';
+                        position++;
+                    }
+                }
+                else if ( *position not_eq '\0' and strchr( "jztL", *position ) not_eq nullptr )
+                {
+                    specifier.length = *position++;
+                }
+                
+                if ( *position == '\0' )
+                {
+                    return false;
+                }
+                
+                specifier.conversion = *position++;
+                specifier.end = position;
+                
+                return true;
+            }
+            
+            return false;
+        }
+        
+        void AsyncLoggerImpl::default_sink( const Logger::Level, const string& message )
+        {
+            fprintf( stderr, "%s\n", message.data( ) );
+        }
+        
+        LogBuffer* AsyncLoggerImpl::get_buffer( void )
+        {
+            static thread_local vector< pair< uint64_t, LogBuffer* > > buffers;
+            
+            for ( const auto& buffer : buffers )
+            {
+                if ( buffer.first == m_serial )
+                {
+                    return buffer.second;
+                }
+            }
+            
+            unique_ptr< LogBuffer > buffer( new LogBuffer( m_capacity ) );
+            auto pointer = buffer.get( );
+            
+            {
+                lock_guard< mutex > guard( m_buffers_lock );
+                m_buffers.push_back( std::move( buffer ) );
+            }
+            
+            buffers.push_back( make_pair( m_serial, pointer ) );
+            
+            return pointer;
+        }
+        
+        void AsyncLoggerImpl::drain( void )
+        {
+            lock_guard< mutex > drain_guard( m_drain_lock );
+            
+            vector< LogBuffer* > buffers;
+            
+            {
+                lock_guard< mutex > guard( m_buffers_lock );
+                
+                for ( const auto& buffer : m_buffers )
+                {
+                    buffers.push_back( buffer.get( ) );
+                }
+            }
+            
+            for ( auto buffer : buffers )
+            {
+                for ( auto entry = buffer->peek( ); entry not_eq nullptr; entry = buffer->peek( ) )
+                {
+                    const auto level = entry->level;
+                    const auto message = decode( *entry );
+                    buffer->release( );
+                    
+                    try
+                    {
+                        m_sink( level, message );
+                    }
+                    catch ( ... )
+                    {
+                        fprintf( stderr, "Failed to create log entry: %s", message.data( ) );
+                    }
+                }
+            }
+            
+            const size_t dropped = m_dropped_entries.exchange( 0 );
+            
+            if ( dropped not_eq 0 )
+            {
+                try
+                {
+                    m_sink( Logger::WARNING, "Log buffer exhausted, discarded " + to_string( dropped ) + " entries." );
+                }
+                catch ( ... )
+                {
+                    fprintf( stderr, "Log buffer exhausted, discarded %zu entries.", dropped );
+                }
+            }
+        }
+        
+        void AsyncLoggerImpl::run( void )
+        {
+            while ( m_is_running )
+            {
+                drain( );
+                
+                unique_lock< mutex > guard( m_worker_lock );
+                m_worker_condition.wait_for( guard, m_flush_interval, [ this ]( )
+                {
+                    return not m_is_running;
+                } );
+            }
+        }
+        
+        uint64_t AsyncLoggerImpl::next_serial( void )
+        {
+            static std::atomic< uint64_t > serial( 0 );
+            return ++serial;
+        }
+        
+        template< typename Type >
+        bool AsyncLoggerImpl::store( LogEntry& entry, const Type value )
+        {
+            if ( entry.length + sizeof( Type ) > sizeof( entry.payload ) )
+            {
+                return false;
+            }
+            
+            memcpy( entry.payload + entry.length, &value, sizeof( Type ) );
+            entry.length += sizeof( Type );
+            
+            return true;
+        }
+        
+        template< typename Type >
+        bool AsyncLoggerImpl::fetch( const LogEntry& entry, size_t& offset, Type& value )
+        {
+            if ( offset + sizeof( Type ) > entry.length )
+            {
+                return false;
+            }
+            
+            memcpy( &value, entry.payload + offset, sizeof( Type ) );
+            offset += sizeof( Type );
+            
+            return true;
+        }
+        
+        void AsyncLoggerImpl::append( string& message, const char* start, const char* end )
+        {
+            for ( auto position = start; position < end; position++ )
+            {
+                message.push_back( *position );
+                
+                if ( *position == '%' and position + 1 < end and position[ 1 ] == '%' )
+                {
+                    position++;
+                }
+            }
+        }
+        
+        template< typename Type >
+        void AsyncLoggerImpl::append( string& message, const LogSpecifier& specifier, const char* modifier, const int* asterisks, const Type value )
+        {
+            const auto specification = string( specifier.start, specifier.modifier ) + modifier + specifier.conversion;
+            
+            int length = 0;
+            char buffer[ 1024 ] = { 0 };
+            
+            switch ( specifier.asterisks )
+            {
+                case 0:
+                    length = snprintf( buffer, sizeof( buffer ), specification.data( ), value );
+                    break;
+                
+                case 1:
+                    length = snprintf( buffer, sizeof( buffer ), specification.data( ), asterisks[ 0 ], value );
+                    break;
+                
+                default:
+                    length = snprintf( buffer, sizeof( buffer ), specification.data( ), asterisks[ 0 ], asterisks[ 1 ], value );
+            }
+            
+            if ( length > 0 )
+            {
+                message.append( buffer, min< size_t >( length, sizeof( buffer ) - 1 ) );
+            }
+        }
+    }
+}
@@ -0,0 +1,233 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <condition_variable>
+
+//Project Includes
+#include "corvusoft/restbed/logger.hpp"
+#include "corvusoft/restbed/async_logger.hpp"
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    
+    namespace detail
+    {
+        //Forward Declarations
+        
+        struct LogEntry
+        {
+            Logger::Level level = Logger::INFO;
+            const char* format = nullptr;
+            std::size_t length = 0;
+            char payload[ 512 ] { };
+        };
+        
+        struct LogSpecifier
+        {
+            const char* start = nullptr;
+            const char* modifier = nullptr;
+            const char* end = nullptr;
+            char length = 0;
+            char conversion = 0;
+            int asterisks = 0;
+        };
+        
+        class LogBuffer
+        {
+            public:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                explicit LogBuffer( const std::size_t capacity );
+                
+                virtual ~LogBuffer( void );
+                
+                //Functionality
+                LogEntry* acquire( void );
+                
+                void commit( void );
+                
+                LogEntry* peek( void );
+                
+                void release( void );
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+            
+            private:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                LogBuffer( const LogBuffer& original ) = delete;
+                
+                //Functionality
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                LogBuffer& operator =( const LogBuffer& value ) = delete;
+                
+                //Properties
+                std::size_t m_mask;
+                
+                std::vector< LogEntry > m_entries;
+                
+                std::atomic< std::size_t > m_head;
+                
+                std::atomic< std::size_t > m_tail;
+        };
+        
+        class AsyncLoggerImpl
+        {
+            public:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                AsyncLoggerImpl( void );
+                
+                virtual ~AsyncLoggerImpl( void );
+                
+                //Functionality
+                void stop( void );
+                
+                void start( void );
+                
+                void flush( void );
+                
+                void write( const Logger::Level level, const char* format, va_list arguments );
+                
+                static void encode( LogEntry& entry, const char* format, va_list arguments );
+                
+                static std::string decode( const LogEntry& entry );
+                
+                static bool parse( const char*& position, LogSpecifier& specifier );
+                
+                static void default_sink( const Logger::Level level, const std::string& message );
+                
+                //Getters
+                LogBuffer* get_buffer( void );
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+                const std::uint64_t m_serial;
+                
+                std::atomic< bool > m_is_running;
+                
+                std::atomic< std::uint32_t > m_levels;
+                
+                std::atomic< std::size_t > m_dropped_entries;
+                
+                AsyncLogger::Mode m_mode;
+                
+                std::size_t m_capacity;
+                
+                std::chrono::milliseconds m_flush_interval;
+                
+                std::function< void ( const Logger::Level, const std::string& ) > m_sink;
+                
+                std::mutex m_buffers_lock;
+                
+                std::vector< std::unique_ptr< LogBuffer > > m_buffers;
+                
+                std::mutex m_drain_lock;
+                
+                std::mutex m_worker_lock;
+                
+                std::condition_variable m_worker_condition;
+                
+                std::shared_ptr< std::thread > m_worker;
+            
+            protected:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                
+                //Functionality
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+            
+            private:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                AsyncLoggerImpl( const AsyncLoggerImpl& original ) = delete;
+                
+                //Functionality
+                void drain( void );
+                
+                void run( void );
+                
+                static std::uint64_t next_serial( void );
+                
+                template< typename Type >
+                static bool store( LogEntry& entry, const Type value );
+                
+                template< typename Type >
+                static bool fetch( const LogEntry& entry, std::size_t& offset, Type& value );
+                
+                static void append( std::string& message, const char* start, const char* end );
+                
+                template< typename Type >
+                static void append( std::string& message, const LogSpecifier& specifier, const char* modifier, const int* asterisks, const Type value );
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                AsyncLoggerImpl& operator =( const AsyncLoggerImpl& value ) = delete;
+                
+                //Properties
+        };
+    }
+}
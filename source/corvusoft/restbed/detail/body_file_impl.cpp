@@ -0,0 +1,169 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <cerrno>
+#include <vector>
+#include <stdexcept>
+#include <system_error>
+    
+#if defined(_WIN32)
+    #include <ciso646>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <stdlib.h>
+#endif
+
+//Project Includes
+#include "corvusoft/restbed/detail/body_file_impl.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::size_t;
+using std::string;
+using std::vector;
+using std::out_of_range;
+using std::system_error;
+using std::runtime_error;
+using std::generic_category;
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    namespace detail
+    {
+#if defined(_WIN32)
+        void BodyFileImpl::open( const string&, const size_t )
+        {
+            throw runtime_error( "Request body spilling is not supported on this platform." );
+        }
+        
+        void BodyFileImpl::write( const Byte*, const size_t )
+        {
+            throw runtime_error( "Request body spilling is not supported on this platform." );
+        }
+        
+        Bytes BodyFileImpl::read( const size_t, const size_t ) const
+        {
+            throw runtime_error( "Request body spilling is not supported on this platform." );
+        }
+        
+        void BodyFileImpl::close( void )
+        {
+            return;
+        }
+#else
+        static const size_t RELEASE_INTERVAL = 1024 * 1024;
+        
+        void BodyFileImpl::open( const string& directory, const size_t length )
+        {
+            string path = directory + "/restbed-body-XXXXXX";
+            vector< char > name( path.begin( ), path.end( ) );
+            name.push_back( '\0' );
+            
+            m_descriptor = ::mkstemp( name.data( ) );
+            
+            if ( m_descriptor == -1 )
+            {
+                throw system_error( errno, generic_category( ), "Failed to create request body file in '" + directory + "'" );
+            }
+            
+            m_path = name.data( );
+            
+#if defined(__linux__) || defined(__FreeBSD__)
+            const int status = ( length == 0 ) ? 0 : ::posix_fallocate( m_descriptor, 0, static_cast< off_t >( length ) );
+            
+            //Filesystems without allocation support report EINVAL or EOPNOTSUPP; only a real shortage of space is fatal.
+            if ( status == ENOSPC or status == EFBIG )
+            {
+                close( );
+                throw system_error( status, generic_category( ), "Failed to reserve request body file space" );
+            }
+            
+            ::posix_fadvise( m_descriptor, 0, 0, POSIX_FADV_SEQUENTIAL );
+#else
+            ( void ) length;
+#endif
+        }
+        
+        void BodyFileImpl::write( const Byte* data, size_t length )
+        {
+            while ( length not_eq 0 )
+            {
+                const auto written = ::pwrite( m_descriptor, data, length, static_cast< off_t >( m_size ) );
+                
+                if ( written == -1 )
+                {
+                    if ( errno == EINTR )
+                    {
+                        continue;
+                    }
+                    
+                    throw system_error( errno, generic_category( ), "Failed to write request body file" );
+                }
+                
+                data += written;
+                length -= static_cast< size_t >( written );
+                m_size += static_cast< size_t >( written );
+            }
+            
+#if defined(__linux__) || defined(__FreeBSD__)
+            
+            //Pages already written back are dropped so a large upload does not grow the page cache.
+            if ( m_size - m_released >= RELEASE_INTERVAL )
+            {
+                ::posix_fadvise( m_descriptor, static_cast< off_t >( m_released ), static_cast< off_t >( m_size - m_released ), POSIX_FADV_DONTNEED );
+                m_released = m_size;
+            }
+        
+#endif
+        }
+        
+        Bytes BodyFileImpl::read( size_t offset, size_t length ) const
+        {
+            if ( offset > m_size or length > m_size - offset )
+            {
+                throw out_of_range( "Request body file read exceeds the body length." );
+            }
+            
+            Bytes data( length );
+            size_t position = 0;
+            
+            while ( position < length )
+            {
+                const auto count = ::pread( m_descriptor, data.data( ) + position, length - position, static_cast< off_t >( offset + position ) );
+                
+                if ( count == -1 and errno == EINTR )
+                {
+                    continue;
+                }
+                
+                if ( count <= 0 )
+                {
+                    throw system_error( ( count == 0 ) ? EIO : errno, generic_category( ), "Failed to read request body file" );
+                }
+                
+                position += static_cast< size_t >( count );
+            }
+            
+            return data;
+        }
+        
+        void BodyFileImpl::close( void )
+        {
+            if ( m_descriptor not_eq -1 )
+            {
+                ::close( m_descriptor );
+                ::unlink( m_path.data( ) );
+                m_descriptor = -1;
+            }
+        }
+#endif
+    }
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <string>
+#include <cstddef>
+
+//Project Includes
+#include "corvusoft/restbed/byte.hpp"
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    
+    namespace detail
+    {
+        //Forward Declarations
+        
+        struct BodyFileImpl
+        {
+            //Creates a temporary file in directory, removed again on close, with length bytes reserved up front.
+            void open( const std::string& directory, const std::size_t length );
+            
+            void write( const Byte* data, const std::size_t length );
+            
+            Bytes read( const std::size_t offset, const std::size_t length ) const;
+            
+            void close( void );
+            
+            int m_descriptor = -1;
+            
+            std::size_t m_size = 0;
+            
+            //Bytes already advised out of the page cache.
+            std::size_t m_released = 0;
+            
+            std::string m_path = "";
+        };
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+//Project Includes
+#include "corvusoft/restbed/byte.hpp"
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    
+    namespace detail
+    {
+        //Forward Declarations
+        
+        //Fixed-size block drawn from a per-thread pool; bytes below m_length are written once and never modified.
+        struct SlabImpl
+        {
+            static const std::size_t CAPACITY = 8 * 1024;
+            
+            std::atomic< std::size_t > m_length { 0 };
+            
+            Byte m_data[ CAPACITY ];
+        };
+        
+        struct SegmentImpl
+        {
+            //Keeps m_data alive; either a SlabImpl or an adopted Bytes.
+            std::shared_ptr< const void > m_owner = nullptr;
+            
+            const Byte* m_data = nullptr;
+            
+            std::size_t m_length = 0;
+            
+            //Set when the segment may grow in place by claiming the remainder of its slab.
+            SlabImpl* m_slab = nullptr;
+            
+            //Set when the segment was adopted from a Bytes buffer, letting a single whole segment be handed out without copying.
+            const Bytes* m_bytes = nullptr;
+        };
+        
+        struct BufferChainImpl
+        {
+            std::size_t m_length = 0;
+            
+            std::vector< SegmentImpl > m_segments { };
+        };
+    }
+}
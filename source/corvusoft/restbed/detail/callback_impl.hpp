@@ -0,0 +1,284 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+//Project Includes
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    
+    namespace detail
+    {
+        //Forward Declarations
+        template< typename Signature >
+        class CallbackImpl;
+        
+        //Move-only callable; functors up to CAPACITY bytes, including a wrapped std::function, are stored inline without allocating.
+        template< typename Result, typename... Arguments >
+        class CallbackImpl< Result ( Arguments... ) >
+        {
+            public:
+                //Friends
+                
+                //Definitions
+                static const std::size_t CAPACITY = 64;
+                
+                //Constructors
+                CallbackImpl( void ) : m_storage( ),
+                    m_operations( nullptr )
+                {
+                    return;
+                }
+                
+                CallbackImpl( std::nullptr_t ) : m_storage( ),
+                    m_operations( nullptr )
+                {
+                    return;
+                }
+                
+                template< typename Functor, typename = typename std::enable_if< not std::is_same< typename std::decay< Functor >::type, CallbackImpl >::value >::type >
+                CallbackImpl( Functor&& functor ) : m_storage( ),
+                    m_operations( nullptr )
+                {
+                    typedef typename std::decay< Functor >::type Type;
+                    
+                    if ( not is_null( functor ) )
+                    {
+                        assign< Type >( std::forward< Functor >( functor ), std::integral_constant< bool, ( sizeof( Type ) <= CAPACITY and alignof( Type ) <= alignof( Storage ) and std::is_nothrow_move_constructible< Type >::value ) >( ) );
+                    }
+                }
+                
+                CallbackImpl( CallbackImpl&& original ) noexcept : m_storage( ),
+                    m_operations( original.m_operations )
+                {
+                    if ( m_operations not_eq nullptr )
+                    {
+                        m_operations->move( &m_storage, &original.m_storage );
+                        original.m_operations = nullptr;
+                    }
+                }
+                
+                ~CallbackImpl( void )
+                {
+                    reset( );
+                }
+                
+                //Functionality
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                Result operator ( )( Arguments... arguments ) const
+                {
+                    if ( m_operations == nullptr )
+                    {
+                        throw std::bad_function_call( );
+                    }
+                    
+                    return m_operations->invoke( &m_storage, std::forward< Arguments >( arguments )... );
+                }
+                
+                CallbackImpl& operator =( CallbackImpl&& value ) noexcept
+                {
+                    if ( this not_eq &value )
+                    {
+                        reset( );
+                        
+                        if ( value.m_operations not_eq nullptr )
+                        {
+                            value.m_operations->move( &m_storage, &value.m_storage );
+                            m_operations = value.m_operations;
+                            value.m_operations = nullptr;
+                        }
+                    }
+                    
+                    return *this;
+                }
+                
+                CallbackImpl& operator =( std::nullptr_t )
+                {
+                    reset( );
+                    return *this;
+                }
+                
+                explicit operator bool( void ) const
+                {
+                    return m_operations not_eq nullptr;
+                }
+                
+                friend bool operator ==( const CallbackImpl& value, std::nullptr_t )
+                {
+                    return value.m_operations == nullptr;
+                }
+                
+                friend bool operator ==( std::nullptr_t, const CallbackImpl& value )
+                {
+                    return value.m_operations == nullptr;
+                }
+                
+                friend bool operator !=( const CallbackImpl& value, std::nullptr_t )
+                {
+                    return value.m_operations not_eq nullptr;
+                }
+                
+                friend bool operator !=( std::nullptr_t, const CallbackImpl& value )
+                {
+                    return value.m_operations not_eq nullptr;
+                }
+                
+                //Properties
+            
+            protected:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                
+                //Functionality
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+            
+            private:
+                //Friends
+                
+                //Definitions
+                typedef typename std::aligned_storage< CAPACITY, alignof( std::max_align_t ) >::type Storage;
+                
+                struct Operations
+                {
+                    Result ( *invoke )( void* storage, Arguments&& ... arguments );
+                    
+                    void ( *move )( void* destination, void* source );
+                    
+                    void ( *destroy )( void* storage );
+                };
+                
+                template< typename Type >
+                struct Inline
+                {
+                    static Result invoke( void* storage, Arguments&& ... arguments )
+                    {
+                        return ( *static_cast< Type* >( storage ) )( std::forward< Arguments >( arguments )... );
+                    }
+                    
+                    static void move( void* destination, void* source )
+                    {
+                        new ( destination ) Type( std::move( *static_cast< Type* >( source ) ) );
+                        static_cast< Type* >( source )->~Type( );
+                    }
+                    
+                    static void destroy( void* storage )
+                    {
+                        static_cast< Type* >( storage )->~Type( );
+                    }
+                };
+                
+                template< typename Type >
+                struct Allocated
+                {
+                    static Result invoke( void* storage, Arguments&& ... arguments )
+                    {
+                        return ( **static_cast< Type** >( storage ) )( std::forward< Arguments >( arguments )... );
+                    }
+                    
+                    static void move( void* destination, void* source )
+                    {
+                        new ( destination ) Type*( *static_cast< Type** >( source ) );
+                    }
+                    
+                    static void destroy( void* storage )
+                    {
+                        delete *static_cast< Type** >( storage );
+                    }
+                };
+                
+                //Constructors
+                CallbackImpl( const CallbackImpl& original ) = delete;
+                
+                //Functionality
+                void reset( void )
+                {
+                    if ( m_operations not_eq nullptr )
+                    {
+                        m_operations->destroy( &m_storage );
+                        m_operations = nullptr;
+                    }
+                }
+                
+                template< typename Type, typename Functor >
+                void assign( Functor&& functor, std::true_type )
+                {
+                    static const Operations operations = { &Inline< Type >::invoke, &Inline< Type >::move, &Inline< Type >::destroy };
+                    
+                    new ( &m_storage ) Type( std::forward< Functor >( functor ) );
+                    m_operations = &operations;
+                }
+                
+                template< typename Type, typename Functor >
+                void assign( Functor&& functor, std::false_type )
+                {
+                    static const Operations operations = { &Allocated< Type >::invoke, &Allocated< Type >::move, &Allocated< Type >::destroy };
+                    
+                    new ( &m_storage ) Type*( new Type( std::forward< Functor >( functor ) ) );
+                    m_operations = &operations;
+                }
+                
+                template< typename Type >
+                static bool is_null( const Type& )
+                {
+                    return false;
+                }
+                
+                template< typename Type >
+                static bool is_null( Type* const value )
+                {
+                    return value == nullptr;
+                }
+                
+                template< typename Signature >
+                static bool is_null( const std::function< Signature >& value )
+                {
+                    return not value;
+                }
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                CallbackImpl& operator =( const CallbackImpl& value ) = delete;
+                
+                //Properties
+                mutable Storage m_storage;
+                
+                const Operations* m_operations;
+        };
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <ciso646>
+
+//Project Includes
+#include "corvusoft/restbed/string.hpp"
+#include "corvusoft/restbed/detail/filter_impl.hpp"
+#include "corvusoft/restbed/detail/header_map_impl.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::regex;
+using std::string;
+using std::regex_match;
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    namespace detail
+    {
+        static bool is_literal( const string& value )
+        {
+            return value.find_first_of( ".^$|()[]{}*+?\\" ) == string::npos;
+        }
+        
+        FilterImpl::FilterImpl( const string& name, const string& pattern ) : m_name( name ),
+            m_hash( HeaderMapImpl::hash( name ) ),
+            m_mode( EXPRESSION ),
+            m_literal( ),
+            m_expression( )
+        {
+            const auto length = pattern.length( );
+            
+            if ( is_literal( pattern ) )
+            {
+                m_mode = EXACT;
+                m_literal = pattern;
+            }
+            else if ( length >= 2 and pattern.compare( length - 2, 2, ".*" ) == 0 and is_literal( pattern.substr( 0, length - 2 ) ) )
+            {
+                m_mode = PREFIX;
+                m_literal = pattern.substr( 0, length - 2 );
+            }
+            else
+            {
+                m_expression = regex( pattern );
+            }
+        }
+        
+        bool FilterImpl::is_match( const string& value ) const
+        {
+            switch ( m_mode )
+            {
+                case EXACT:
+                    return value == m_literal;
+                
+                case PREFIX:
+                    return value.compare( 0, m_literal.length( ), m_literal ) == 0 and value.find_first_of( "\r\n" ) == string::npos;
+                
+                default:
+                    return regex_match( value, m_expression );
+            }
+        }
+        
+        bool FilterImpl::is_satisfied( const HeaderMapImpl& headers ) const
+        {
+            for ( const auto& entry : headers.get_entries( ) )
+            {
+                if ( entry.hash == m_hash and String::equals( entry.name, m_name, String::CASE_INSENSITIVE ) and not is_match( entry.value ) )
+                {
+                    return false;
+                }
+            }
+            
+            return true;
+        }
+    }
+}
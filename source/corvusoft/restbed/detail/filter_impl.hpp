@@ -0,0 +1,106 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <regex>
+#include <string>
+#include <cstddef>
+
+//Project Includes
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    
+    namespace detail
+    {
+        //Forward Declarations
+        class HeaderMapImpl;
+        
+        //A method handler header filter, compiled once at registration.
+        class FilterImpl
+        {
+            public:
+                //Friends
+                
+                //Definitions
+                enum Mode : int
+                {
+                    EXACT = 0,
+                    PREFIX = 1,
+                    EXPRESSION = 2
+                };
+                
+                //Constructors
+                FilterImpl( const std::string& name, const std::string& pattern );
+                
+                //Functionality
+                bool is_match( const std::string& value ) const;
+                
+                //Headers named after the filter must all match; a request without the header passes.
+                bool is_satisfied( const HeaderMapImpl& headers ) const;
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+            
+            protected:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                
+                //Functionality
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+            
+            private:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                
+                //Functionality
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+                std::string m_name;
+                
+                std::size_t m_hash;
+                
+                Mode m_mode;
+                
+                std::string m_literal;
+                
+                std::regex m_expression;
+        };
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <new>
+#include <ciso646>
+
+//Project Includes
+#include "corvusoft/restbed/detail/handler_allocator_impl.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::size_t;
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    namespace detail
+    {
+        HandlerAllocatorImpl::HandlerAllocatorImpl( void ) : m_in_use( ),
+            m_slots( )
+        {
+            for ( auto& in_use : m_in_use )
+            {
+                in_use = false;
+            }
+        }
+        
+        HandlerAllocatorImpl::~HandlerAllocatorImpl( void )
+        {
+            return;
+        }
+        
+        void* HandlerAllocatorImpl::allocate( const size_t size )
+        {
+            if ( size <= SLOT_SIZE )
+            {
+                for ( size_t index = 0; index < SLOT_COUNT; index++ )
+                {
+                    if ( not m_in_use[ index ].exchange( true ) )
+                    {
+                        return &m_slots[ index ];
+                    }
+                }
+            }
+            
+            return ::operator new( size );
+        }
+        
+        void HandlerAllocatorImpl::deallocate( void* pointer )
+        {
+            for ( size_t index = 0; index < SLOT_COUNT; index++ )
+            {
+                if ( pointer == &m_slots[ index ] )
+                {
+                    m_in_use[ index ] = false;
+                    return;
+                }
+            }
+            
+            ::operator delete( pointer );
+        }
+    }
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <array>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+//Project Includes
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    
+    namespace detail
+    {
+        //Forward Declarations
+        
+        //Per-connection slab for asio operation state; requests it cannot satisfy fall back to the global heap.
+        class HandlerAllocatorImpl
+        {
+            public:
+                //Friends
+                
+                //Definitions
+                static const std::size_t SLOT_SIZE = 512;
+                
+                static const std::size_t SLOT_COUNT = 4;
+                
+                //Constructors
+                HandlerAllocatorImpl( void );
+                
+                virtual ~HandlerAllocatorImpl( void );
+                
+                //Functionality
+                void* allocate( const std::size_t size );
+                
+                void deallocate( void* pointer );
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+            
+            protected:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                
+                //Functionality
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+            
+            private:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                HandlerAllocatorImpl( const HandlerAllocatorImpl& original ) = delete;
+                
+                //Functionality
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                HandlerAllocatorImpl& operator =( const HandlerAllocatorImpl& value ) = delete;
+                
+                //Properties
+                std::array< std::atomic< bool >, SLOT_COUNT > m_in_use;
+                
+                std::array< typename std::aligned_storage< SLOT_SIZE >::type, SLOT_COUNT > m_slots;
+        };
+        
+        //Completion handler wrapper routing asio's allocation hooks to a HandlerAllocatorImpl.
+        template< typename Handler >
+        class AllocatedHandlerImpl
+        {
+            public:
+                AllocatedHandlerImpl( const std::shared_ptr< HandlerAllocatorImpl >& allocator, Handler handler ) : m_allocator( allocator ),
+                    m_handler( std::move( handler ) )
+                {
+                    return;
+                }
+                
+                template< typename... Arguments >
+                void operator ( )( Arguments&& ... arguments )
+                {
+                    m_handler( std::forward< Arguments >( arguments )... );
+                }
+                
+                friend void* asio_handler_allocate( std::size_t size, AllocatedHandlerImpl< Handler >* context )
+                {
+                    return context->m_allocator->allocate( size );
+                }
+                
+                friend void asio_handler_deallocate( void* pointer, std::size_t, AllocatedHandlerImpl< Handler >* context )
+                {
+                    context->m_allocator->deallocate( pointer );
+                }
+            
+            private:
+                std::shared_ptr< HandlerAllocatorImpl > m_allocator;
+                
+                Handler m_handler;
+        };
+        
+        template< typename Handler >
+        inline AllocatedHandlerImpl< Handler > make_allocated_handler( const std::shared_ptr< HandlerAllocatorImpl >& allocator, Handler handler )
+        {
+            return AllocatedHandlerImpl< Handler >( allocator, std::move( handler ) );
+        }
+    }
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <ciso646>
+#include <algorithm>
+
+//Project Includes
+#include "corvusoft/restbed/string.hpp"
+#include "corvusoft/restbed/detail/header_map_impl.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::size_t;
+using std::string;
+using std::vector;
+using std::multimap;
+using std::remove_if;
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    namespace detail
+    {
+        HeaderMapImpl::HeaderMapImpl( void ) : m_entries( )
+        {
+            return;
+        }
+        
+        HeaderMapImpl::HeaderMapImpl( const multimap< string, string >& values ) : m_entries( )
+        {
+            set_values( values );
+        }
+        
+        void HeaderMapImpl::add( const string& name, const string& value )
+        {
+            m_entries.push_back( Entry { hash( name ), name, value } );
+        }
+        
+        void HeaderMapImpl::set( const string& name, const string& value )
+        {
+            erase( name );
+            add( name, value );
+        }
+        
+        void HeaderMapImpl::erase( const string& name )
+        {
+            const auto key = hash( name );
+            
+            m_entries.erase( remove_if( m_entries.begin( ), m_entries.end( ), [ key, &name ]( const Entry & entry )
+            {
+                return is_match( entry, key, name );
+            } ), m_entries.end( ) );
+        }
+        
+        void HeaderMapImpl::clear( void )
+        {
+            m_entries.clear( );
+        }
+        
+        bool HeaderMapImpl::empty( void ) const
+        {
+            return m_entries.empty( );
+        }
+        
+        bool HeaderMapImpl::contains( const string& name ) const
+        {
+            return find( name ) not_eq nullptr;
+        }
+        
+        const string* HeaderMapImpl::find( const string& name ) const
+        {
+            const auto key = hash( name );
+            
+            for ( const auto& entry : m_entries )
+            {
+                if ( is_match( entry, key, name ) )
+                {
+                    return &entry.value;
+                }
+            }
+            
+            return nullptr;
+        }
+        
+        size_t HeaderMapImpl::hash( const string& name )
+        {
+            size_t value = 2166136261u;
+            
+            for ( const char character : name )
+            {
+                const char folded = ( character >= 'A' and character <= 'Z' ) ? static_cast< char >( character - 'A' + 'a' ) : character;
+                value = ( value ^ static_cast< unsigned char >( folded ) ) * 16777619u;
+            }
+            
+            return value;
+        }
+        
+        const vector< HeaderMapImpl::Entry >& HeaderMapImpl::get_entries( void ) const
+        {
+            return m_entries;
+        }
+        
+        multimap< string, string > HeaderMapImpl::get_values( const string& name ) const
+        {
+            multimap< string, string > values;
+            const auto key = hash( name );
+            
+            for ( const auto& entry : m_entries )
+            {
+                if ( name.empty( ) or is_match( entry, key, name ) )
+                {
+                    values.insert( make_pair( entry.name, entry.value ) );
+                }
+            }
+            
+            return values;
+        }
+        
+        void HeaderMapImpl::set_values( const multimap< string, string >& values )
+        {
+            m_entries.clear( );
+            m_entries.reserve( values.size( ) );
+            
+            for ( const auto& value : values )
+            {
+                add( value.first, value.second );
+            }
+        }
+        
+        bool HeaderMapImpl::is_match( const Entry& entry, const size_t hash, const string& name )
+        {
+            return entry.hash == hash and String::equals( entry.name, name, String::CASE_INSENSITIVE );
+        }
+    }
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <map>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+//Project Includes
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    
+    namespace detail
+    {
+        //Forward Declarations
+        
+        //Insertion ordered header fields; names are matched case-insensitively via a pre-computed folded hash.
+        class HeaderMapImpl
+        {
+            public:
+                //Friends
+                
+                //Definitions
+                struct Entry
+                {
+                    std::size_t hash;
+                    std::string name;
+                    std::string value;
+                };
+                
+                //Constructors
+                HeaderMapImpl( void );
+                
+                HeaderMapImpl( const std::multimap< std::string, std::string >& values );
+                
+                //Functionality
+                void add( const std::string& name, const std::string& value );
+                
+                void set( const std::string& name, const std::string& value );
+                
+                void erase( const std::string& name );
+                
+                void clear( void );
+                
+                bool empty( void ) const;
+                
+                bool contains( const std::string& name ) const;
+                
+                //Returns the first value for name, or nullptr; invalidated by any modification.
+                const std::string* find( const std::string& name ) const;
+                
+                static std::size_t hash( const std::string& name );
+                
+                //Getters
+                const std::vector< Entry >& get_entries( void ) const;
+                
+                std::multimap< std::string, std::string > get_values( const std::string& name = "" ) const;
+                
+                //Setters
+                void set_values( const std::multimap< std::string, std::string >& values );
+                
+                //Operators
+                
+                //Properties
+            
+            protected:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                
+                //Functionality
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+            
+            private:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                
+                //Functionality
+                static bool is_match( const Entry& entry, const std::size_t hash, const std::string& name );
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+                std::vector< Entry > m_entries;
+        };
+    }
+}
@@ -0,0 +1,588 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <ciso646>
+#include <stdexcept>
+
+//Project Includes
+#include "corvusoft/restbed/detail/hpack_impl.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::pair;
+using std::string;
+using std::size_t;
+using std::uint8_t;
+using std::uint32_t;
+using std::uint64_t;
+using std::runtime_error;
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    namespace detail
+    {
+        //RFC 7541 Appendix B; every symbol's code and its length in bits.
+        static const pair< uint32_t, uint8_t > HUFFMAN_CODES[ 256 ] =
+        {
+            { 0x1ff8, 13 }, { 0x7fffd8, 23 }, { 0xfffffe2, 28 }, { 0xfffffe3, 28 },
+            { 0xfffffe4, 28 }, { 0xfffffe5, 28 }, { 0xfffffe6, 28 }, { 0xfffffe7, 28 },
+            { 0xfffffe8, 28 }, { 0xffffea, 24 }, { 0x3ffffffc, 30 }, { 0xfffffe9, 28 },
+            { 0xfffffea, 28 }, { 0x3ffffffd, 30 }, { 0xfffffeb, 28 }, { 0xfffffec, 28 },
+            { 0xfffffed, 28 }, { 0xfffffee, 28 }, { 0xfffffef, 28 }, { 0xffffff0, 28 },
+            { 0xffffff1, 28 }, { 0xffffff2, 28 }, { 0x3ffffffe, 30 }, { 0xffffff3, 28 },
+            { 0xffffff4, 28 }, { 0xffffff5, 28 }, { 0xffffff6, 28 }, { 0xffffff7, 28 },
+            { 0xffffff8, 28 }, { 0xffffff9, 28 }, { 0xffffffa, 28 }, { 0xffffffb, 28 },
+            { 0x14, 6 }, { 0x3f8, 10 }, { 0x3f9, 10 }, { 0xffa, 12 },
+            { 0x1ff9, 13 }, { 0x15, 6 }, { 0xf8, 8 }, { 0x7fa, 11 },
+            { 0x3fa, 10 }, { 0x3fb, 10 }, { 0xf9, 8 }, { 0x7fb, 11 },
+            { 0xfa, 8 }, { 0x16, 6 }, { 0x17, 6 }, { 0x18, 6 },
+            { 0x0, 5 }, { 0x1, 5 }, { 0x2, 5 }, { 0x19, 6 },
+            { 0x1a, 6 }, { 0x1b, 6 }, { 0x1c, 6 }, { 0x1d, 6 },
+            { 0x1e, 6 }, { 0x1f, 6 }, { 0x5c, 7 }, { 0xfb, 8 },
+            { 0x7ffc, 15 }, { 0x20, 6 }, { 0xffb, 12 }, { 0x3fc, 10 },
+            { 0x1ffa, 13 }, { 0x21, 6 }, { 0x5d, 7 }, { 0x5e, 7 },
+            { 0x5f, 7 }, { 0x60, 7 }, { 0x61, 7 }, { 0x62, 7 },
+            { 0x63, 7 }, { 0x64, 7 }, { 0x65, 7 }, { 0x66, 7 },
+            { 0x67, 7 }, { 0x68, 7 }, { 0x69, 7 }, { 0x6a, 7 },
+            { 0x6b, 7 }, { 0x6c, 7 }, { 0x6d, 7 }, { 0x6e, 7 },
+            { 0x6f, 7 }, { 0x70, 7 }, { 0x71, 7 }, { 0x72, 7 },
+            { 0xfc, 8 }, { 0x73, 7 }, { 0xfd, 8 }, { 0x1ffb, 13 },
+            { 0x7fff0, 19 }, { 0x1ffc, 13 }, { 0x3ffc, 14 }, { 0x22, 6 },
+            { 0x7ffd, 15 }, { 0x3, 5 }, { 0x23, 6 }, { 0x4, 5 },
+            { 0x24, 6 }, { 0x5, 5 }, { 0x25, 6 }, { 0x26, 6 },
+            { 0x27, 6 }, { 0x6, 5 }, { 0x74, 7 }, { 0x75, 7 },
+            { 0x28, 6 }, { 0x29, 6 }, { 0x2a, 6 }, { 0x7, 5 },
+            { 0x2b, 6 }, { 0x76, 7 }, { 0x2c, 6 }, { 0x8, 5 },
+            { 0x9, 5 }, { 0x2d, 6 }, { 0x77, 7 }, { 0x78, 7 },
+            { 0x79, 7 }, { 0x7a, 7 }, { 0x7b, 7 }, { 0x7ffe, 15 },
+            { 0x7fc, 11 }, { 0x3ffd, 14 }, { 0x1ffd, 13 }, { 0xffffffc, 28 },
+            { 0xfffe6, 20 }, { 0x3fffd2, 22 }, { 0xfffe7, 20 }, { 0xfffe8, 20 },
+            { 0x3fffd3, 22 }, { 0x3fffd4, 22 }, { 0x3fffd5, 22 }, { 0x7fffd9, 23 },
+            { 0x3fffd6, 22 }, { 0x7fffda, 23 }, { 0x7fffdb, 23 }, { 0x7fffdc, 23 },
+            { 0x7fffdd, 23 }, { 0x7fffde, 23 }, { 0xffffeb, 24 }, { 0x7fffdf, 23 },
+            { 0xffffec, 24 }, { 0xffffed, 24 }, { 0x3fffd7, 22 }, { 0x7fffe0, 23 },
+            { 0xffffee, 24 }, { 0x7fffe1, 23 }, { 0x7fffe2, 23 }, { 0x7fffe3, 23 },
+            { 0x7fffe4, 23 }, { 0x1fffdc, 21 }, { 0x3fffd8, 22 }, { 0x7fffe5, 23 },
+            { 0x3fffd9, 22 }, { 0x7fffe6, 23 }, { 0x7fffe7, 23 }, { 0xffffef, 24 },
+            { 0x3fffda, 22 }, { 0x1fffdd, 21 }, { 0xfffe9, 20 }, { 0x3fffdb, 22 },
+            { 0x3fffdc, 22 }, { 0x7fffe8, 23 }, { 0x7fffe9, 23 }, { 0x1fffde, 21 },
+            { 0x7fffea, 23 }, { 0x3fffdd, 22 }, { 0x3fffde, 22 }, { 0xfffff0, 24 },
+            { 0x1fffdf, 21 }, { 0x3fffdf, 22 }, { 0x7fffeb, 23 }, { 0x7fffec, 23 },
+            { 0x1fffe0, 21 }, { 0x1fffe1, 21 }, { 0x3fffe0, 22 }, { 0x1fffe2, 21 },
+            { 0x7fffed, 23 }, { 0x3fffe1, 22 }, { 0x7fffee, 23 }, { 0x7fffef, 23 },
+            { 0xfffea, 20 }, { 0x3fffe2, 22 }, { 0x3fffe3, 22 }, { 0x3fffe4, 22 },
+            { 0x7ffff0, 23 }, { 0x3fffe5, 22 }, { 0x3fffe6, 22 }, { 0x7ffff1, 23 },
+            { 0x3ffffe0, 26 }, { 0x3ffffe1, 26 }, { 0xfffeb, 20 }, { 0x7fff1, 19 },
+            { 0x3fffe7, 22 }, { 0x7ffff2, 23 }, { 0x3fffe8, 22 }, { 0x1ffffec, 25 },
+            { 0x3ffffe2, 26 }, { 0x3ffffe3, 26 }, { 0x3ffffe4, 26 }, { 0x7ffffde, 27 },
+            { 0x7ffffdf, 27 }, { 0x3ffffe5, 26 }, { 0xfffff1, 24 }, { 0x1ffffed, 25 },
+            { 0x7fff2, 19 }, { 0x1fffe3, 21 }, { 0x3ffffe6, 26 }, { 0x7ffffe0, 27 },
+            { 0x7ffffe1, 27 }, { 0x3ffffe7, 26 }, { 0x7ffffe2, 27 }, { 0xfffff2, 24 },
+            { 0x1fffe4, 21 }, { 0x1fffe5, 21 }, { 0x3ffffe8, 26 }, { 0x3ffffe9, 26 },
+            { 0xffffffd, 28 }, { 0x7ffffe3, 27 }, { 0x7ffffe4, 27 }, { 0x7ffffe5, 27 },
+            { 0xfffec, 20 }, { 0xfffff3, 24 }, { 0xfffed, 20 }, { 0x1fffe6, 21 },
+            { 0x3fffe9, 22 }, { 0x1fffe7, 21 }, { 0x1fffe8, 21 }, { 0x7ffff3, 23 },
+            { 0x3fffea, 22 }, { 0x3fffeb, 22 }, { 0x1ffffee, 25 }, { 0x1ffffef, 25 },
+            { 0xfffff4, 24 }, { 0xfffff5, 24 }, { 0x3ffffea, 26 }, { 0x7ffff4, 23 },
+            { 0x3ffffeb, 26 }, { 0x7ffffe6, 27 }, { 0x3ffffec, 26 }, { 0x3ffffed, 26 },
+            { 0x7ffffe7, 27 }, { 0x7ffffe8, 27 }, { 0x7ffffe9, 27 }, { 0x7ffffea, 27 },
+            { 0x7ffffeb, 27 }, { 0xffffffe, 28 }, { 0x7ffffec, 27 }, { 0x7ffffed, 27 },
+            { 0x7ffffee, 27 }, { 0x7ffffef, 27 }, { 0x7fffff0, 27 }, { 0x3ffffee, 26 }
+        };
+        
+        //RFC 7541 Appendix A.
+        static const pair< string, string > STATIC_TABLE[ 61 ] =
+        {
+            { ":authority", "" },
+            { ":method", "GET" },
+            { ":method", "POST" },
+            { ":path", "/" },
+            { ":path", "/index.html" },
+            { ":scheme", "http" },
+            { ":scheme", "https" },
+            { ":status", "200" },
+            { ":status", "204" },
+            { ":status", "206" },
+            { ":status", "304" },
+            { ":status", "400" },
+            { ":status", "404" },
+            { ":status", "500" },
+            { "accept-charset", "" },
+            { "accept-encoding", "gzip, deflate" },
+            { "accept-language", "" },
+            { "accept-ranges", "" },
+            { "accept", "" },
+            { "access-control-allow-origin", "" },
+            { "age", "" },
+            { "allow", "" },
+            { "authorization", "" },
+            { "cache-control", "" },
+            { "content-disposition", "" },
+            { "content-encoding", "" },
+            { "content-language", "" },
+            { "content-length", "" },
+            { "content-location", "" },
+            { "content-range", "" },
+            { "content-type", "" },
+            { "cookie", "" },
+            { "date", "" },
+            { "etag", "" },
+            { "expect", "" },
+            { "expires", "" },
+            { "from", "" },
+            { "host", "" },
+            { "if-match", "" },
+            { "if-modified-since", "" },
+            { "if-none-match", "" },
+            { "if-range", "" },
+            { "if-unmodified-since", "" },
+            { "last-modified", "" },
+            { "link", "" },
+            { "location", "" },
+            { "max-forwards", "" },
+            { "proxy-authenticate", "" },
+            { "proxy-authorization", "" },
+            { "range", "" },
+            { "referer", "" },
+            { "refresh", "" },
+            { "retry-after", "" },
+            { "server", "" },
+            { "set-cookie", "" },
+            { "strict-transport-security", "" },
+            { "transfer-encoding", "" },
+            { "user-agent", "" },
+            { "vary", "" },
+            { "via", "" },
+            { "www-authenticate", "" }
+        };
+        
+        static const size_t STATIC_TABLE_SIZE = 61;
+        
+        static const size_t ENTRY_OVERHEAD = 32;
+        
+        //The code is canonical, so each length's codes are consecutive; decoding needs only the first code of each length and the symbols in code order.
+        struct HuffmanTable
+        {
+            uint32_t m_first[ 31 ] = { };
+            
+            uint32_t m_count[ 31 ] = { };
+            
+            uint32_t m_offset[ 31 ] = { };
+            
+            uint32_t m_symbols[ 257 ] = { };
+            
+            HuffmanTable( void )
+            {
+                for ( uint32_t symbol = 0; symbol < 256; symbol++ )
+                {
+                    m_count[ HUFFMAN_CODES[ symbol ].second ]++;
+                }
+                
+                m_count[ 30 ]++;
+                
+                uint32_t code = 0;
+                uint32_t offset = 0;
+                
+                for ( uint32_t length = 1; length <= 30; length++ )
+                {
+                    code = ( code + ( ( length > 1 ) ? m_count[ length - 1 ] : 0 ) ) << 1;
+                    m_first[ length ] = code;
+                    m_offset[ length ] = offset;
+                    offset += m_count[ length ];
+                }
+                
+                uint32_t position[ 31 ] = { };
+                
+                for ( uint32_t symbol = 0; symbol <= 256; symbol++ )
+                {
+                    const auto length = ( symbol == 256 ) ? 30 : HUFFMAN_CODES[ symbol ].second;
+                    m_symbols[ m_offset[ length ] + position[ length ]++ ] = symbol;
+                }
+            }
+        };
+        
+        HpackImpl::HpackImpl( const size_t capacity ) : m_size( 0 ),
+            m_capacity( capacity ),
+            m_limit( capacity ),
+            m_resized( false ),
+            m_entries( )
+        {
+            return;
+        }
+        
+        HpackImpl::~HpackImpl( void )
+        {
+            return;
+        }
+        
+        void HpackImpl::decode( const Byte* data, const size_t length, HeaderList& headers )
+        {
+            const Byte* end = data + length;
+            bool leading = true;
+            
+            while ( data < end )
+            {
+                const Byte octet = *data;
+                
+                if ( octet & 0x80 )
+                {
+                    const auto index = decode_integer( data, end, 7 );
+                    
+                    if ( index == 0 )
+                    {
+                        throw runtime_error( "HPACK indexed field refers to index zero." );
+                    }
+                    
+                    headers.push_back( lookup( index ) );
+                }
+                else if ( ( octet & 0xE0 ) == 0x20 )
+                {
+                    if ( not leading )
+                    {
+                        throw runtime_error( "HPACK table size update follows a header field." );
+                    }
+                    
+                    const auto capacity = decode_integer( data, end, 5 );
+                    
+                    if ( capacity > m_limit )
+                    {
+                        throw runtime_error( "HPACK table size update exceeds the advertised limit." );
+                    }
+                    
+                    m_capacity = capacity;
+                    evict( m_capacity );
+                    continue;
+                }
+                else
+                {
+                    const bool indexing = ( octet & 0xC0 ) == 0x40;
+                    const auto index = decode_integer( data, end, ( indexing ) ? 6 : 4 );
+                    
+                    string name = ( index == 0 ) ? decode_string( data, end ) : lookup( index ).first;
+                    string value = decode_string( data, end );
+                    
+                    if ( indexing )
+                    {
+                        insert( name, value );
+                    }
+                    
+                    headers.emplace_back( std::move( name ), std::move( value ) );
+                }
+                
+                leading = false;
+            }
+        }
+        
+        void HpackImpl::encode( const HeaderList& headers, Bytes& block )
+        {
+            if ( m_resized )
+            {
+                encode_integer( m_capacity, 5, 0x20, block );
+                m_resized = false;
+            }
+            
+            for ( const auto& header : headers )
+            {
+                const auto index = find( header.first, header.second );
+                
+                if ( index > 0 )
+                {
+                    encode_integer( static_cast< uint64_t >( index ), 7, 0x80, block );
+                    continue;
+                }
+                
+                //Credentials are never indexed, so an intermediary cannot probe the table for them.
+                if ( header.first == "authorization" or header.first == "proxy-authorization" )
+                {
+                    encode_integer( static_cast< uint64_t >( -index ), 4, 0x10, block );
+                }
+                else if ( header.first.length( ) + header.second.length( ) + ENTRY_OVERHEAD <= m_capacity / 2 )
+                {
+                    encode_integer( static_cast< uint64_t >( -index ), 6, 0x40, block );
+                    insert( header.first, header.second );
+                }
+                else
+                {
+                    encode_integer( static_cast< uint64_t >( -index ), 4, 0x00, block );
+                }
+                
+                if ( index == 0 )
+                {
+                    encode_string( header.first, block );
+                }
+                
+                encode_string( header.second, block );
+            }
+        }
+        
+        void HpackImpl::huffman_encode( const string& value, Bytes& data )
+        {
+            uint64_t bits = 0;
+            uint8_t count = 0;
+            
+            for ( const unsigned char symbol : value )
+            {
+                const auto& code = HUFFMAN_CODES[ symbol ];
+                bits = ( bits << code.second ) | code.first;
+                count += code.second;
+                
+                while ( count >= 8 )
+                {
+                    count -= 8;
+                    data.push_back( static_cast< Byte >( bits >> count ) );
+                }
+            }
+            
+            //The final octet is padded with the most significant bits of the end-of-string code, all ones.
+            if ( count > 0 )
+            {
+                data.push_back( static_cast< Byte >( ( bits << ( 8 - count ) ) | ( 0xFF >> count ) ) );
+            }
+        }
+        
+        string HpackImpl::huffman_decode( const Byte* data, const size_t length )
+        {
+            static const HuffmanTable table;
+            
+            string value = "";
+            value.reserve( length + length / 2 );
+            
+            uint32_t code = 0;
+            uint32_t bits = 0;
+            bool padding = true;
+            
+            for ( size_t index = 0; index < length; index++ )
+            {
+                for ( int shift = 7; shift >= 0; shift-- )
+                {
+                    const uint32_t bit = ( data[ index ] >> shift ) & 1;
+                    code = ( code << 1 ) | bit;
+                    padding = padding and bit == 1;
+                    bits++;
+                    
+                    if ( bits > 30 )
+                    {
+                        throw runtime_error( "HPACK Huffman code is too long." );
+                    }
+                    
+                    if ( table.m_count[ bits ] not_eq 0 and code >= table.m_first[ bits ] and code - table.m_first[ bits ] < table.m_count[ bits ] )
+                    {
+                        const auto symbol = table.m_symbols[ table.m_offset[ bits ] + code - table.m_first[ bits ] ];
+                        
+                        if ( symbol == 256 )
+                        {
+                            throw runtime_error( "HPACK Huffman string contains the end-of-string symbol." );
+                        }
+                        
+                        value.push_back( static_cast< char >( symbol ) );
+                        code = 0;
+                        bits = 0;
+                        padding = true;
+                    }
+                }
+            }
+            
+            if ( bits > 7 or not padding )
+            {
+                throw runtime_error( "HPACK Huffman string has invalid padding." );
+            }
+            
+            return value;
+        }
+        
+        size_t HpackImpl::get_size( void ) const
+        {
+            return m_size;
+        }
+        
+        size_t HpackImpl::get_capacity( void ) const
+        {
+            return m_capacity;
+        }
+        
+        void HpackImpl::set_capacity( const size_t value )
+        {
+            m_limit = value;
+            
+            if ( m_capacity > value )
+            {
+                m_capacity = value;
+                m_resized = true;
+                evict( m_capacity );
+            }
+        }
+        
+        void HpackImpl::insert( const string& name, const string& value )
+        {
+            const auto size = name.length( ) + value.length( ) + ENTRY_OVERHEAD;
+            
+            //An entry larger than the table empties it and is not added.
+            if ( size > m_capacity )
+            {
+                return evict( 0 );
+            }
+            
+            evict( m_capacity - size );
+            m_entries.emplace_front( name, value );
+            m_size += size;
+        }
+        
+        void HpackImpl::evict( const size_t limit )
+        {
+            while ( m_size > limit and not m_entries.empty( ) )
+            {
+                const auto& entry = m_entries.back( );
+                m_size -= entry.first.length( ) + entry.second.length( ) + ENTRY_OVERHEAD;
+                m_entries.pop_back( );
+            }
+        }
+        
+        long HpackImpl::find( const string& name, const string& value ) const
+        {
+            long match = 0;
+            
+            for ( size_t index = 0; index < STATIC_TABLE_SIZE; index++ )
+            {
+                if ( STATIC_TABLE[ index ].first not_eq name )
+                {
+                    continue;
+                }
+                
+                if ( STATIC_TABLE[ index ].second == value )
+                {
+                    return static_cast< long >( index + 1 );
+                }
+                
+                match = ( match == 0 ) ? -static_cast< long >( index + 1 ) : match;
+            }
+            
+            for ( size_t index = 0; index < m_entries.size( ); index++ )
+            {
+                if ( m_entries[ index ].first not_eq name )
+                {
+                    continue;
+                }
+                
+                if ( m_entries[ index ].second == value )
+                {
+                    return static_cast< long >( STATIC_TABLE_SIZE + index + 1 );
+                }
+                
+                match = ( match == 0 ) ? -static_cast< long >( STATIC_TABLE_SIZE + index + 1 ) : match;
+            }
+            
+            return match;
+        }
+        
+        const pair< string, string >& HpackImpl::lookup( const uint64_t index ) const
+        {
+            if ( index == 0 or index > STATIC_TABLE_SIZE + m_entries.size( ) )
+            {
+                throw runtime_error( "HPACK index is outside the header tables." );
+            }
+            
+            return ( index <= STATIC_TABLE_SIZE ) ? STATIC_TABLE[ index - 1 ] : m_entries[ index - STATIC_TABLE_SIZE - 1 ];
+        }
+        
+        uint64_t HpackImpl::decode_integer( const Byte*& data, const Byte* end, const uint8_t prefix )
+        {
+            const uint8_t mask = static_cast< uint8_t >( ( 1 << prefix ) - 1 );
+            uint64_t value = *data++ & mask;
+            
+            if ( value < mask )
+            {
+                return value;
+            }
+            
+            for ( uint8_t shift = 0; ; shift += 7 )
+            {
+                if ( data == end or shift > 28 )
+                {
+                    throw runtime_error( "HPACK integer is truncated or too large." );
+                }
+                
+                const Byte octet = *data++;
+                value += static_cast< uint64_t >( octet & 0x7F ) << shift;
+                
+                if ( not ( octet & 0x80 ) )
+                {
+                    return value;
+                }
+            }
+        }
+        
+        string HpackImpl::decode_string( const Byte*& data, const Byte* end )
+        {
+            if ( data == end )
+            {
+                throw runtime_error( "HPACK string is truncated." );
+            }
+            
+            const bool huffman = ( *data & 0x80 ) not_eq 0;
+            const auto length = decode_integer( data, end, 7 );
+            
+            if ( length > static_cast< uint64_t >( end - data ) )
+            {
+                throw runtime_error( "HPACK string is truncated." );
+            }
+            
+            const Byte* start = data;
+            data += length;
+            
+            if ( huffman )
+            {
+                return huffman_decode( start, static_cast< size_t >( length ) );
+            }
+            
+            return string( reinterpret_cast< const char* >( start ), static_cast< size_t >( length ) );
+        }
+        
+        void HpackImpl::encode_integer( const uint64_t value, const uint8_t prefix, const Byte flags, Bytes& data )
+        {
+            const uint8_t mask = static_cast< uint8_t >( ( 1 << prefix ) - 1 );
+            
+            if ( value < mask )
+            {
+                data.push_back( static_cast< Byte >( flags | value ) );
+                return;
+            }
+            
+            data.push_back( static_cast< Byte >( flags | mask ) );
+            
+            for ( uint64_t remainder = value - mask; ; remainder >>= 7 )
+            {
+                if ( remainder < 0x80 )
+                {
+                    data.push_back( static_cast< Byte >( remainder ) );
+                    return;
+                }
+                
+                data.push_back( static_cast< Byte >( ( remainder & 0x7F ) | 0x80 ) );
+            }
+        }
+        
+        void HpackImpl::encode_string( const string& value, Bytes& data )
+        {
+            Bytes compressed;
+            huffman_encode( value, compressed );
+            
+            if ( compressed.size( ) < value.length( ) )
+            {
+                encode_integer( compressed.size( ), 7, 0x80, data );
+                data.insert( data.end( ), compressed.begin( ), compressed.end( ) );
+            }
+            else
+            {
+                encode_integer( value.length( ), 7, 0x00, data );
+                data.insert( data.end( ), value.begin( ), value.end( ) );
+            }
+        }
+    }
+}
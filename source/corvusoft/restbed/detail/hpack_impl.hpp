@@ -0,0 +1,131 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <deque>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <cstddef>
+
+//Project Includes
+#include "corvusoft/restbed/byte.hpp"
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    
+    namespace detail
+    {
+        //Forward Declarations
+        
+        //One direction of an HTTP/2 header compression context (RFC 7541); a connection keeps one for decoding requests and one for encoding responses.
+        class HpackImpl
+        {
+            public:
+                //Friends
+                
+                //Definitions
+                typedef std::vector< std::pair< std::string, std::string > > HeaderList;
+                
+                //Constructors
+                explicit HpackImpl( const std::size_t capacity = 4096 );
+                
+                virtual ~HpackImpl( void );
+                
+                //Functionality
+                //Decodes a complete header block, throwing std::runtime_error on any compression error.
+                void decode( const Byte* data, const std::size_t length, HeaderList& headers );
+                
+                void encode( const HeaderList& headers, Bytes& block );
+                
+                static void huffman_encode( const std::string& value, Bytes& data );
+                
+                static std::string huffman_decode( const Byte* data, const std::size_t length );
+                
+                //Getters
+                std::size_t get_size( void ) const;
+                
+                std::size_t get_capacity( void ) const;
+                
+                //Setters
+                //For a decoder, the largest table the peer may ask for; for an encoder, the table size the peer allows, announced in the next block.
+                void set_capacity( const std::size_t value );
+                
+                //Operators
+                
+                //Properties
+            
+            protected:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                
+                //Functionality
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+            
+            private:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                
+                //Functionality
+                void insert( const std::string& name, const std::string& value );
+                
+                void evict( const std::size_t limit );
+                
+                //Returns the table index of an exact match, or of the first entry with a matching name as a negative value, or zero.
+                long find( const std::string& name, const std::string& value ) const;
+                
+                const std::pair< std::string, std::string >& lookup( const std::uint64_t index ) const;
+                
+                static std::uint64_t decode_integer( const Byte*& data, const Byte* end, const std::uint8_t prefix );
+                
+                static std::string decode_string( const Byte*& data, const Byte* end );
+                
+                static void encode_integer( const std::uint64_t value, const std::uint8_t prefix, const Byte flags, Bytes& data );
+                
+                static void encode_string( const std::string& value, Bytes& data );
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+                std::size_t m_size;
+                
+                std::size_t m_capacity;
+                
+                std::size_t m_limit;
+                
+                bool m_resized;
+                
+                std::deque< std::pair< std::string, std::string > > m_entries;
+        };
+    }
+}
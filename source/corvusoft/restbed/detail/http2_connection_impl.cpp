@@ -0,0 +1,1615 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <ciso646>
+#include <algorithm>
+#include <stdexcept>
+
+//Project Includes
+#include "corvusoft/restbed/string.hpp"
+#include "corvusoft/restbed/settings.hpp"
+#include "corvusoft/restbed/detail/socket_impl.hpp"
+#include "corvusoft/restbed/detail/http2_stream_impl.hpp"
+#include "corvusoft/restbed/detail/http2_connection_impl.hpp"
+
+//External Includes
+#include <asio/error.hpp>
+#include <asio/buffer.hpp>
+
+//System Namespaces
+using std::get;
+using std::min;
+using std::mutex;
+using std::string;
+using std::size_t;
+using std::vector;
+using std::int64_t;
+using std::uint8_t;
+using std::uint16_t;
+using std::uint32_t;
+using std::multimap;
+using std::function;
+using std::to_string;
+using std::unique_lock;
+using std::shared_ptr;
+using std::error_code;
+using std::make_shared;
+using std::runtime_error;
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    namespace detail
+    {
+        static const string PREFACE = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+        
+        static const size_t FRAME_HEADER_SIZE = 9;
+        
+        static const size_t MAX_FRAME_SIZE = 16384;
+        
+        static const size_t MAX_HEADER_BLOCK_SIZE = 256 * 1024;
+        
+        static const size_t MAX_BATCH_SIZE = 256 * 1024;
+        
+        static const int64_t DEFAULT_WINDOW = 65535;
+        
+        static const int64_t MAX_WINDOW = 0x7FFFFFFF;
+        
+        static const uint8_t DATA = 0x0;
+        static const uint8_t HEADERS = 0x1;
+        static const uint8_t PRIORITY = 0x2;
+        static const uint8_t RST_STREAM = 0x3;
+        static const uint8_t SETTINGS = 0x4;
+        static const uint8_t PUSH_PROMISE = 0x5;
+        static const uint8_t PING = 0x6;
+        static const uint8_t GOAWAY = 0x7;
+        static const uint8_t WINDOW_UPDATE = 0x8;
+        static const uint8_t CONTINUATION = 0x9;
+        
+        static const uint8_t ACK = 0x1;
+        static const uint8_t END_STREAM = 0x1;
+        static const uint8_t END_HEADERS = 0x4;
+        static const uint8_t PADDED = 0x8;
+        static const uint8_t PRIORITISED = 0x20;
+        
+        static const uint32_t NO_ERROR = 0x0;
+        static const uint32_t PROTOCOL_ERROR = 0x1;
+        static const uint32_t FLOW_CONTROL_ERROR = 0x3;
+        static const uint32_t STREAM_CLOSED = 0x5;
+        static const uint32_t FRAME_SIZE_ERROR = 0x6;
+        static const uint32_t REFUSED_STREAM = 0x7;
+        static const uint32_t CANCEL = 0x8;
+        static const uint32_t COMPRESSION_ERROR = 0x9;
+        static const uint32_t ENHANCE_YOUR_CALM = 0xB;
+        
+        static const uint16_t SETTINGS_HEADER_TABLE_SIZE = 0x1;
+        static const uint16_t SETTINGS_ENABLE_PUSH = 0x2;
+        static const uint16_t SETTINGS_MAX_CONCURRENT_STREAMS = 0x3;
+        static const uint16_t SETTINGS_INITIAL_WINDOW_SIZE = 0x4;
+        static const uint16_t SETTINGS_MAX_FRAME_SIZE = 0x5;
+        
+        static uint32_t read_uint32( const Byte* data )
+        {
+            return ( static_cast< uint32_t >( data[ 0 ] ) << 24 ) | ( static_cast< uint32_t >( data[ 1 ] ) << 16 ) | ( static_cast< uint32_t >( data[ 2 ] ) << 8 ) | data[ 3 ];
+        }
+        
+        static void write_uint32( const uint32_t value, Bytes& data )
+        {
+            data.push_back( static_cast< Byte >( value >> 24 ) );
+            data.push_back( static_cast< Byte >( value >> 16 ) );
+            data.push_back( static_cast< Byte >( value >> 8 ) );
+            data.push_back( static_cast< Byte >( value ) );
+        }
+        
+        static Bytes frame_header( const size_t length, const uint8_t type, const uint8_t flags, const uint32_t id )
+        {
+            Bytes header;
+            header.reserve( FRAME_HEADER_SIZE );
+            header.push_back( static_cast< Byte >( length >> 16 ) );
+            header.push_back( static_cast< Byte >( length >> 8 ) );
+            header.push_back( static_cast< Byte >( length ) );
+            header.push_back( type );
+            header.push_back( flags );
+            write_uint32( id & 0x7FFFFFFF, header );
+            
+            return header;
+        }
+        
+        //Hop-by-hop fields have no meaning in HTTP/2 and make a message malformed.
+        static bool is_connection_specific( const string& name )
+        {
+            return name == "connection" or name == "keep-alive" or name == "proxy-connection" or name == "transfer-encoding" or name == "upgrade";
+        }
+        
+        static bool is_valid_request( const Http2ConnectionImpl::HeaderList& headers )
+        {
+            bool regular = false;
+            bool method = false;
+            bool scheme = false;
+            bool path = false;
+            
+            for ( const auto& header : headers )
+            {
+                const auto& name = header.first;
+                
+                if ( name.empty( ) )
+                {
+                    return false;
+                }
+                
+                if ( name[ 0 ] == ':' )
+                {
+                    if ( regular )
+                    {
+                        return false;
+                    }
+                    
+                    bool* seen = ( name == ":method" ) ? &method : ( name == ":scheme" ) ? &scheme : ( name == ":path" ) ? &path : nullptr;
+                    
+                    if ( seen == nullptr and name not_eq ":authority" )
+                    {
+                        return false;
+                    }
+                    
+                    if ( seen not_eq nullptr )
+                    {
+                        if ( *seen or header.second.empty( ) )
+                        {
+                            return false;
+                        }
+                        
+                        *seen = true;
+                    }
+                    
+                    continue;
+                }
+                
+                regular = true;
+                
+                if ( String::lowercase( name ) not_eq name or is_connection_specific( name ) or ( name == "te" and header.second not_eq "trailers" ) )
+                {
+                    return false;
+                }
+            }
+            
+            return method and scheme and path;
+        }
+        
+        Http2ConnectionImpl::Http2ConnectionImpl( const shared_ptr< SocketImpl >& socket, const shared_ptr< const Settings >& settings, const bool client ) : m_mutex( ),
+            m_socket( socket ),
+            m_settings( settings ),
+            m_buffer( nullptr ),
+            m_client( client ),
+            m_preface( client ),
+            m_closing( false ),
+            m_closed( false ),
+            m_writing( false ),
+            m_last_stream_id( 0 ),
+            m_stream_limit( settings->get_http2_stream_limit( ) ),
+            m_peer_stream_limit( SIZE_MAX ),
+            m_streams( ),
+            m_decoder( ),
+            m_encoder( ),
+            m_continuation( 0 ),
+            m_continuation_flags( 0 ),
+            m_continuation_dependency( 0 ),
+            m_continuation_weight( 16 ),
+            m_header_block( ),
+            m_window( DEFAULT_WINDOW ),
+            m_initial_window( DEFAULT_WINDOW ),
+            m_receive_window( DEFAULT_WINDOW ),
+            m_unacknowledged( 0 ),
+            m_max_frame_size( MAX_FRAME_SIZE ),
+            m_control( ),
+            m_arrivals( ),
+            m_completions( ),
+            m_inflight( ),
+            m_request_handler( nullptr )
+        {
+            return;
+        }
+        
+        Http2ConnectionImpl::~Http2ConnectionImpl( void )
+        {
+            return;
+        }
+        
+        void Http2ConnectionImpl::start( const shared_ptr< asio::streambuf >& buffer )
+        {
+            {
+                unique_lock< mutex > lock( m_mutex );
+                m_buffer = buffer;
+                
+                Bytes settings;
+                settings.push_back( 0 );
+                
+                //A client opens the connection with its preface and refuses server push, as it never reads pushed streams.
+                if ( m_client )
+                {
+                    m_control.append( PREFACE );
+                    settings.push_back( SETTINGS_ENABLE_PUSH );
+                    write_uint32( 0, settings );
+                }
+                else
+                {
+                    settings.push_back( SETTINGS_MAX_CONCURRENT_STREAMS );
+                    write_uint32( static_cast< uint32_t >( min< size_t >( m_stream_limit, 0xFFFFFFFF ) ), settings );
+                }
+                
+                queue_frame( SETTINGS, 0, 0, settings.data( ), settings.size( ) );
+            }
+            
+            receive( error_code( ) );
+        }
+        
+        void Http2ConnectionImpl::upgrade( const Bytes& settings, const HeaderList& headers )
+        {
+            unique_lock< mutex > lock( m_mutex );
+            
+            if ( settings.size( ) % 6 == 0 )
+            {
+                configure( settings.data( ), settings.size( ) );
+            }
+            
+            HeaderList request( headers );
+            m_last_stream_id = 1;
+            open( 1, request, true );
+        }
+        
+        shared_ptr< Http2StreamImpl > Http2ConnectionImpl::request( const HeaderList& headers, const BufferChain& body, CallbackImpl< void ( const error_code&, size_t ) > callback )
+        {
+            auto stream = make_shared< Http2StreamImpl >( );
+            stream->m_connection = shared_from_this( );
+            stream->m_buffer = make_shared< asio::streambuf >( );
+            stream->m_local_closed = true;
+            
+            Http2OutputImpl output;
+            output.m_has_headers = true;
+            output.m_headers = headers;
+            output.m_data = body;
+            output.m_final = true;
+            
+            {
+                unique_lock< mutex > lock( m_mutex );
+                
+                if ( m_closing or m_closed )
+                {
+                    stream->m_reset = true;
+                    lock.unlock( );
+                    callback( asio::error::connection_aborted, 0 );
+                    return stream;
+                }
+                
+                stream->m_id = ( m_last_stream_id == 0 ) ? 1 : m_last_stream_id + 2;
+                stream->m_window = m_initial_window;
+                stream->m_open_callback = std::move( callback );
+                stream->m_output.push_back( std::move( output ) );
+                
+                m_last_stream_id = stream->m_id;
+                m_streams[ stream->m_id ] = stream;
+                
+                //Once stream identifiers run out the connection drains and a fresh one takes its place.
+                if ( m_last_stream_id >= 0x7FFFFFFF - 2 )
+                {
+                    m_closing = true;
+                }
+            }
+            
+            flush( );
+            
+            return stream;
+        }
+        
+        void Http2ConnectionImpl::read( const shared_ptr< Http2StreamImpl >& stream, const size_t length, CallbackImpl< void ( const error_code&, size_t ) > callback )
+        {
+            Completions completions;
+            
+            {
+                unique_lock< mutex > lock( m_mutex );
+                
+                if ( stream->m_reset or m_closed )
+                {
+                    completions.emplace_back( std::move( callback ), asio::error::connection_reset, 0 );
+                }
+                else
+                {
+                    stream->m_read_length = stream->m_buffer->size( ) + length;
+                    stream->m_read_delimiter.clear( );
+                    stream->m_read_callback = std::move( callback );
+                    deliver( stream );
+                    completions.swap( m_completions );
+                }
+            }
+            
+            flush( );
+            finish( completions );
+        }
+        
+        void Http2ConnectionImpl::read( const shared_ptr< Http2StreamImpl >& stream, const string& delimiter, CallbackImpl< void ( const error_code&, size_t ) > callback )
+        {
+            Completions completions;
+            
+            {
+                unique_lock< mutex > lock( m_mutex );
+                
+                if ( stream->m_reset or m_closed )
+                {
+                    completions.emplace_back( std::move( callback ), asio::error::connection_reset, 0 );
+                }
+                else
+                {
+                    stream->m_read_delimiter = delimiter;
+                    stream->m_read_callback = std::move( callback );
+                    deliver( stream );
+                    completions.swap( m_completions );
+                }
+            }
+            
+            flush( );
+            finish( completions );
+        }
+        
+        void Http2ConnectionImpl::write( const shared_ptr< Http2StreamImpl >& stream, const int status, const multimap< string, string >& headers, const BufferChain& body, const bool final, CallbackImpl< void ( const error_code&, size_t ) > callback )
+        {
+            Http2OutputImpl output;
+            output.m_has_headers = true;
+            output.m_headers.emplace_back( ":status", to_string( status ) );
+            
+            for ( const auto& header : headers )
+            {
+                auto name = String::lowercase( header.first );
+                
+                if ( not is_connection_specific( name ) )
+                {
+                    output.m_headers.emplace_back( std::move( name ), header.second );
+                }
+            }
+            
+            output.m_data = body;
+            output.m_final = final;
+            output.m_callback = std::move( callback );
+            
+            {
+                unique_lock< mutex > lock( m_mutex );
+                
+                if ( stream->m_reset or stream->m_local_closed or m_closed )
+                {
+                    lock.unlock( );
+                    return output.m_callback( asio::error::connection_reset, 0 );
+                }
+                
+                stream->m_local_closed = final;
+                stream->m_output.push_back( std::move( output ) );
+            }
+            
+            flush( );
+        }
+        
+        void Http2ConnectionImpl::write( const shared_ptr< Http2StreamImpl >& stream, const BufferChain& body, const bool final, CallbackImpl< void ( const error_code&, size_t ) > callback )
+        {
+            Http2OutputImpl output;
+            output.m_data = body;
+            output.m_final = final;
+            output.m_callback = std::move( callback );
+            
+            {
+                unique_lock< mutex > lock( m_mutex );
+                
+                if ( stream->m_reset or stream->m_local_closed or m_closed )
+                {
+                    lock.unlock( );
+                    return output.m_callback( asio::error::connection_reset, 0 );
+                }
+                
+                //Data written without a response head still needs one ahead of it.
+                if ( not stream->m_headers_sent and stream->m_output.empty( ) )
+                {
+                    output.m_has_headers = true;
+                    output.m_headers.emplace_back( ":status", "200" );
+                }
+                
+                stream->m_local_closed = final;
+                stream->m_output.push_back( std::move( output ) );
+            }
+            
+            flush( );
+        }
+        
+        void Http2ConnectionImpl::reset( const shared_ptr< Http2StreamImpl >& stream )
+        {
+            Completions completions;
+            
+            {
+                unique_lock< mutex > lock( m_mutex );
+                
+                //A client stream is finished once its response has been received in full.
+                const bool finished = ( m_client ) ? stream->m_remote_closed and stream->m_output.empty( ) : stream->m_local_closed;
+                
+                if ( stream->m_reset or finished or m_closed )
+                {
+                    return;
+                }
+                
+                abandon( stream, CANCEL, asio::error::operation_aborted );
+                completions.swap( m_completions );
+            }
+            
+            flush( );
+            finish( completions );
+        }
+        
+        bool Http2ConnectionImpl::is_open( void )
+        {
+            unique_lock< mutex > lock( m_mutex );
+            return not m_closing and not m_closed;
+        }
+        
+        void Http2ConnectionImpl::set_request_handler( const function< void ( const shared_ptr< Http2StreamImpl > ) >& value )
+        {
+            m_request_handler = value;
+        }
+        
+        void Http2ConnectionImpl::receive( const error_code& error )
+        {
+            if ( error )
+            {
+                return shutdown( error );
+            }
+            
+            size_t needed = 1;
+            bool reading = false;
+            vector< shared_ptr< Http2StreamImpl > > arrivals;
+            Completions completions;
+            
+            {
+                unique_lock< mutex > lock( m_mutex );
+                
+                if ( m_closed )
+                {
+                    return;
+                }
+                
+                try
+                {
+                    while ( true )
+                    {
+                        const auto size = m_buffer->size( );
+                        const auto data = asio::buffer_cast< const Byte* >( m_buffer->data( ) );
+                        
+                        if ( not m_preface )
+                        {
+                            if ( size < PREFACE.length( ) )
+                            {
+                                needed = PREFACE.length( ) - size;
+                                break;
+                            }
+                            
+                            if ( memcmp( data, PREFACE.data( ), PREFACE.length( ) ) not_eq 0 )
+                            {
+                                throw PROTOCOL_ERROR;
+                            }
+                            
+                            m_buffer->consume( PREFACE.length( ) );
+                            m_preface = true;
+                            continue;
+                        }
+                        
+                        if ( size < FRAME_HEADER_SIZE )
+                        {
+                            needed = FRAME_HEADER_SIZE - size;
+                            break;
+                        }
+                        
+                        const size_t length = ( static_cast< size_t >( data[ 0 ] ) << 16 ) | ( static_cast< size_t >( data[ 1 ] ) << 8 ) | data[ 2 ];
+                        
+                        if ( length > MAX_FRAME_SIZE )
+                        {
+                            throw FRAME_SIZE_ERROR;
+                        }
+                        
+                        if ( size < FRAME_HEADER_SIZE + length )
+                        {
+                            needed = FRAME_HEADER_SIZE + length - size;
+                            break;
+                        }
+                        
+                        process( data[ 3 ], data[ 4 ], read_uint32( data + 5 ) & 0x7FFFFFFF, data + FRAME_HEADER_SIZE, length );
+                        m_buffer->consume( FRAME_HEADER_SIZE + length );
+                    }
+                }
+                catch ( const uint32_t code )
+                {
+                    terminate( code );
+                }
+                
+                reading = not m_closed and not ( m_closing and m_streams.empty( ) );
+                arrivals.swap( m_arrivals );
+                completions.swap( m_completions );
+            }
+            
+            //The next read is issued before handlers run, so one slow stream does not hold up the others.
+            if ( reading )
+            {
+                auto connection = shared_from_this( );
+                
+                m_socket->start_read( m_buffer, needed, [ connection ]( const error_code & error, size_t )
+                {
+                    connection->receive( error );
+                } );
+            }
+            
+            flush( );
+            
+            for ( const auto& stream : arrivals )
+            {
+                m_request_handler( stream );
+            }
+            
+            finish( completions );
+        }
+        
+        void Http2ConnectionImpl::process( const uint8_t type, const uint8_t flags, const uint32_t id, const Byte* payload, const size_t length )
+        {
+            if ( m_continuation not_eq 0 and type not_eq CONTINUATION )
+            {
+                throw PROTOCOL_ERROR;
+            }
+            
+            switch ( type )
+            {
+                case DATA:
+                    return process_data( flags, id, payload, length );
+                
+                case HEADERS:
+                    return process_headers( flags, id, payload, length );
+                
+                case PRIORITY:
+                    return process_priority( id, payload, length );
+                
+                case RST_STREAM:
+                    return process_reset( id, payload, length );
+                
+                case SETTINGS:
+                    return process_settings( flags, id, payload, length );
+                
+                case PUSH_PROMISE:
+                    throw PROTOCOL_ERROR;
+                
+                case PING:
+                    if ( length not_eq 8 )
+                    {
+                        throw FRAME_SIZE_ERROR;
+                    }
+                    
+                    if ( id not_eq 0 )
+                    {
+                        throw PROTOCOL_ERROR;
+                    }
+                    
+                    if ( not ( flags & ACK ) )
+                    {
+                        queue_frame( PING, ACK, 0, payload, length );
+                    }
+                    
+                    return;
+                
+                case GOAWAY:
+                    if ( id not_eq 0 )
+                    {
+                        throw PROTOCOL_ERROR;
+                    }
+                    
+                    if ( length < 8 )
+                    {
+                        throw FRAME_SIZE_ERROR;
+                    }
+                    
+                    m_closing = true;
+                    
+                    //Streams above the last one the server processed will never be answered.
+                    while ( m_client and not m_streams.empty( ) and m_streams.rbegin( )->first > ( read_uint32( payload ) & 0x7FFFFFFF ) )
+                    {
+                        const auto stream = m_streams.rbegin( )->second;
+                        stream->m_reset = true;
+                        abandon( stream, NO_ERROR, asio::error::connection_aborted );
+                    }
+                    
+                    return;
+                
+                case WINDOW_UPDATE:
+                    return process_window_update( id, payload, length );
+                
+                case CONTINUATION:
+                    return process_continuation( flags, id, payload, length );
+                
+                default:
+                    //Frames of unknown type are ignored.
+                    return;
+            }
+        }
+        
+        void Http2ConnectionImpl::process_data( const uint8_t flags, const uint32_t id, const Byte* payload, size_t length )
+        {
+            if ( id == 0 )
+            {
+                throw PROTOCOL_ERROR;
+            }
+            
+            //Flow control counts the whole frame, padding included.
+            const auto frame_length = length;
+            size_t offset = 0;
+            
+            if ( flags & PADDED )
+            {
+                if ( length == 0 or payload[ 0 ] >= length )
+                {
+                    throw PROTOCOL_ERROR;
+                }
+                
+                length -= payload[ 0 ];
+                offset = 1;
+            }
+            
+            m_receive_window -= static_cast< int64_t >( frame_length );
+            
+            if ( m_receive_window < 0 )
+            {
+                throw FLOW_CONTROL_ERROR;
+            }
+            
+            m_unacknowledged += frame_length;
+            
+            if ( m_unacknowledged >= static_cast< size_t >( DEFAULT_WINDOW / 2 ) )
+            {
+                Bytes increment;
+                write_uint32( static_cast< uint32_t >( m_unacknowledged ), increment );
+                queue_frame( WINDOW_UPDATE, 0, 0, increment.data( ), increment.size( ) );
+                
+                m_receive_window += static_cast< int64_t >( m_unacknowledged );
+                m_unacknowledged = 0;
+            }
+            
+            const auto iterator = m_streams.find( id );
+            
+            if ( iterator == m_streams.end( ) )
+            {
+                if ( id > m_last_stream_id )
+                {
+                    throw PROTOCOL_ERROR;
+                }
+                
+                Bytes code;
+                write_uint32( STREAM_CLOSED, code );
+                return queue_frame( RST_STREAM, 0, id, code.data( ), code.size( ) );
+            }
+            
+            const auto stream = iterator->second;
+            
+            if ( stream->m_remote_closed )
+            {
+                return abandon( stream, STREAM_CLOSED, asio::error::connection_reset );
+            }
+            
+            stream->m_receive_window -= static_cast< int64_t >( frame_length );
+            
+            if ( stream->m_receive_window < 0 )
+            {
+                return abandon( stream, FLOW_CONTROL_ERROR, asio::error::connection_reset );
+            }
+            
+            const auto size = length - offset;
+            acknowledge( stream, frame_length - size );
+            
+            //Until a stream is dispatched nothing reads its buffer, so data goes straight in and the window stays open.
+            if ( not stream->m_dispatched )
+            {
+                const auto target = stream->m_buffer->prepare( size );
+                memcpy( asio::buffer_cast< Byte* >( target ), payload + offset, size );
+                stream->m_buffer->commit( size );
+                acknowledge( stream, size );
+            }
+            else
+            {
+                stream->m_input.insert( stream->m_input.end( ), payload + offset, payload + length );
+            }
+            
+            stream->m_received += size;
+            
+            if ( flags & END_STREAM )
+            {
+                return close_remote( stream );
+            }
+            
+            deliver( stream );
+        }
+        
+        void Http2ConnectionImpl::process_headers( const uint8_t flags, const uint32_t id, const Byte* payload, size_t length )
+        {
+            if ( id == 0 or id % 2 == 0 )
+            {
+                throw PROTOCOL_ERROR;
+            }
+            
+            size_t offset = 0;
+            
+            if ( flags & PADDED )
+            {
+                if ( length == 0 or payload[ 0 ] >= length )
+                {
+                    throw PROTOCOL_ERROR;
+                }
+                
+                length -= payload[ 0 ];
+                offset = 1;
+            }
+            
+            m_continuation_dependency = 0;
+            m_continuation_weight = 16;
+            
+            if ( flags & PRIORITISED )
+            {
+                if ( length - offset < 5 )
+                {
+                    throw PROTOCOL_ERROR;
+                }
+                
+                m_continuation_dependency = read_uint32( payload + offset ) & 0x7FFFFFFF;
+                m_continuation_weight = static_cast< uint16_t >( payload[ offset + 4 ] + 1 );
+                offset += 5;
+            }
+            
+            m_continuation = id;
+            m_continuation_flags = flags;
+            m_header_block.assign( payload + offset, payload + length );
+            
+            if ( flags & END_HEADERS )
+            {
+                complete_headers( );
+            }
+        }
+        
+        void Http2ConnectionImpl::process_continuation( const uint8_t flags, const uint32_t id, const Byte* payload, const size_t length )
+        {
+            if ( m_continuation == 0 or id not_eq m_continuation )
+            {
+                throw PROTOCOL_ERROR;
+            }
+            
+            if ( m_header_block.size( ) + length > MAX_HEADER_BLOCK_SIZE )
+            {
+                throw ENHANCE_YOUR_CALM;
+            }
+            
+            m_header_block.insert( m_header_block.end( ), payload, payload + length );
+            
+            if ( flags & END_HEADERS )
+            {
+                complete_headers( );
+            }
+        }
+        
+        void Http2ConnectionImpl::process_settings( const uint8_t flags, const uint32_t id, const Byte* payload, const size_t length )
+        {
+            if ( id not_eq 0 )
+            {
+                throw PROTOCOL_ERROR;
+            }
+            
+            if ( flags & ACK )
+            {
+                if ( length not_eq 0 )
+                {
+                    throw FRAME_SIZE_ERROR;
+                }
+                
+                return;
+            }
+            
+            if ( length % 6 not_eq 0 )
+            {
+                throw FRAME_SIZE_ERROR;
+            }
+            
+            configure( payload, length );
+            queue_frame( SETTINGS, ACK, 0, nullptr, 0 );
+        }
+        
+        void Http2ConnectionImpl::process_priority( const uint32_t id, const Byte* payload, const size_t length )
+        {
+            if ( id == 0 )
+            {
+                throw PROTOCOL_ERROR;
+            }
+            
+            if ( length not_eq 5 )
+            {
+                throw FRAME_SIZE_ERROR;
+            }
+            
+            const auto dependency = read_uint32( payload ) & 0x7FFFFFFF;
+            const auto iterator = m_streams.find( id );
+            
+            if ( iterator == m_streams.end( ) )
+            {
+                return;
+            }
+            
+            if ( dependency == id )
+            {
+                return abandon( iterator->second, PROTOCOL_ERROR, asio::error::connection_reset );
+            }
+            
+            iterator->second->m_dependency = dependency;
+            iterator->second->m_weight = static_cast< uint16_t >( payload[ 4 ] + 1 );
+        }
+        
+        void Http2ConnectionImpl::configure( const Byte* payload, const size_t length )
+        {
+            for ( size_t offset = 0; offset + 6 <= length; offset += 6 )
+            {
+                const auto identifier = static_cast< uint16_t >( ( payload[ offset ] << 8 ) | payload[ offset + 1 ] );
+                const auto value = read_uint32( payload + offset + 2 );
+                
+                switch ( identifier )
+                {
+                    case SETTINGS_HEADER_TABLE_SIZE:
+                        m_encoder.set_capacity( value );
+                        break;
+                    
+                    case SETTINGS_ENABLE_PUSH:
+                        if ( value > 1 )
+                        {
+                            throw PROTOCOL_ERROR;
+                        }
+                        
+                        break;
+                    
+                    case SETTINGS_MAX_CONCURRENT_STREAMS:
+                        m_peer_stream_limit = value;
+                        break;
+                    
+                    case SETTINGS_INITIAL_WINDOW_SIZE:
+                        if ( value > MAX_WINDOW )
+                        {
+                            throw FLOW_CONTROL_ERROR;
+                        }
+                        
+                        //A new initial size shifts every open stream's window by the difference.
+                        for ( auto& entry : m_streams )
+                        {
+                            entry.second->m_window += static_cast< int64_t >( value ) - m_initial_window;
+                            
+                            if ( entry.second->m_window > MAX_WINDOW )
+                            {
+                                throw FLOW_CONTROL_ERROR;
+                            }
+                        }
+                        
+                        m_initial_window = value;
+                        break;
+                    
+                    case SETTINGS_MAX_FRAME_SIZE:
+                        if ( value < MAX_FRAME_SIZE or value > 0xFFFFFF )
+                        {
+                            throw PROTOCOL_ERROR;
+                        }
+                        
+                        m_max_frame_size = value;
+                        break;
+                    
+                    default:
+                        break;
+                }
+            }
+        }
+        
+        void Http2ConnectionImpl::process_window_update( const uint32_t id, const Byte* payload, const size_t length )
+        {
+            if ( length not_eq 4 )
+            {
+                throw FRAME_SIZE_ERROR;
+            }
+            
+            const auto increment = static_cast< int64_t >( read_uint32( payload ) & 0x7FFFFFFF );
+            
+            if ( id == 0 )
+            {
+                if ( increment == 0 )
+                {
+                    throw PROTOCOL_ERROR;
+                }
+                
+                m_window += increment;
+                
+                if ( m_window > MAX_WINDOW )
+                {
+                    throw FLOW_CONTROL_ERROR;
+                }
+                
+                return;
+            }
+            
+            const auto iterator = m_streams.find( id );
+            
+            if ( iterator == m_streams.end( ) )
+            {
+                return;
+            }
+            
+            const auto stream = iterator->second;
+            
+            if ( increment == 0 )
+            {
+                return abandon( stream, PROTOCOL_ERROR, asio::error::connection_reset );
+            }
+            
+            stream->m_window += increment;
+            
+            if ( stream->m_window > MAX_WINDOW )
+            {
+                abandon( stream, FLOW_CONTROL_ERROR, asio::error::connection_reset );
+            }
+        }
+        
+        void Http2ConnectionImpl::process_reset( const uint32_t id, const Byte* payload, const size_t length )
+        {
+            if ( length not_eq 4 )
+            {
+                throw FRAME_SIZE_ERROR;
+            }
+            
+            if ( id == 0 or id > m_last_stream_id )
+            {
+                throw PROTOCOL_ERROR;
+            }
+            
+            const auto iterator = m_streams.find( id );
+            
+            if ( iterator == m_streams.end( ) )
+            {
+                return;
+            }
+            
+            //A server may stop a request body it no longer needs once the response is complete; that response is kept.
+            if ( m_client and iterator->second->m_remote_closed and read_uint32( payload ) == NO_ERROR )
+            {
+                iterator->second->m_output.clear( );
+                return release( iterator->second );
+            }
+            
+            //The peer already considers the stream closed, so no reset is sent back.
+            iterator->second->m_reset = true;
+            abandon( iterator->second, NO_ERROR, asio::error::connection_reset );
+        }
+        
+        void Http2ConnectionImpl::complete_headers( void )
+        {
+            const auto id = m_continuation;
+            const auto flags = m_continuation_flags;
+            m_continuation = 0;
+            
+            //The block is decoded even for refused or closed streams, as it still updates the shared table.
+            HeaderList headers;
+            
+            try
+            {
+                m_decoder.decode( m_header_block.data( ), m_header_block.size( ), headers );
+            }
+            catch ( const runtime_error& )
+            {
+                throw COMPRESSION_ERROR;
+            }
+            
+            m_header_block.clear( );
+            
+            if ( m_client )
+            {
+                return complete_response( id, flags, headers );
+            }
+            
+            const auto iterator = m_streams.find( id );
+            
+            if ( iterator not_eq m_streams.end( ) )
+            {
+                //Trailers; they must end the stream.
+                const auto stream = iterator->second;
+                
+                if ( stream->m_remote_closed )
+                {
+                    return abandon( stream, STREAM_CLOSED, asio::error::connection_reset );
+                }
+                
+                if ( not ( flags & END_STREAM ) )
+                {
+                    return abandon( stream, PROTOCOL_ERROR, asio::error::connection_reset );
+                }
+                
+                return close_remote( stream );
+            }
+            
+            if ( id <= m_last_stream_id )
+            {
+                throw STREAM_CLOSED;
+            }
+            
+            m_last_stream_id = id;
+            
+            if ( m_closing )
+            {
+                return;
+            }
+            
+            if ( m_streams.size( ) >= m_stream_limit or m_continuation_dependency == id )
+            {
+                Bytes code;
+                write_uint32( ( m_continuation_dependency == id ) ? PROTOCOL_ERROR : REFUSED_STREAM, code );
+                return queue_frame( RST_STREAM, 0, id, code.data( ), code.size( ) );
+            }
+            
+            open( id, headers, ( flags & END_STREAM ) not_eq 0 );
+            
+            const auto stream = m_streams.find( id );
+            
+            if ( stream not_eq m_streams.end( ) )
+            {
+                stream->second->m_dependency = m_continuation_dependency;
+                stream->second->m_weight = m_continuation_weight;
+            }
+        }
+        
+        void Http2ConnectionImpl::open( const uint32_t id, HeaderList& headers, const bool final )
+        {
+            if ( not is_valid_request( headers ) )
+            {
+                Bytes code;
+                write_uint32( PROTOCOL_ERROR, code );
+                return queue_frame( RST_STREAM, 0, id, code.data( ), code.size( ) );
+            }
+            
+            auto stream = make_shared< Http2StreamImpl >( );
+            stream->m_id = id;
+            stream->m_connection = shared_from_this( );
+            stream->m_headers.swap( headers );
+            stream->m_remote_closed = final;
+            stream->m_window = m_initial_window;
+            stream->m_buffer = make_shared< asio::streambuf >( );
+            m_streams[ id ] = stream;
+            
+            //A body of unknown length is gathered before dispatch so the request can carry its Content-Length.
+            const bool sized = std::any_of( stream->m_headers.begin( ), stream->m_headers.end( ), [ ]( const std::pair< string, string >& header )
+            {
+                return header.first == "content-length";
+            } );
+            
+            if ( final or sized )
+            {
+                dispatch( stream );
+            }
+        }
+        
+        void Http2ConnectionImpl::complete_response( const uint32_t id, const uint8_t flags, HeaderList& headers )
+        {
+            const auto iterator = m_streams.find( id );
+            
+            if ( iterator == m_streams.end( ) )
+            {
+                if ( id > m_last_stream_id )
+                {
+                    throw PROTOCOL_ERROR;
+                }
+                
+                return;
+            }
+            
+            const auto stream = iterator->second;
+            const bool final = ( flags & END_STREAM ) not_eq 0;
+            
+            if ( stream->m_remote_closed )
+            {
+                return abandon( stream, STREAM_CLOSED, asio::error::connection_reset );
+            }
+            
+            //Trailers; they must end the stream.
+            if ( not stream->m_headers.empty( ) )
+            {
+                if ( not final )
+                {
+                    return abandon( stream, PROTOCOL_ERROR, asio::error::connection_reset );
+                }
+                
+                return close_remote( stream );
+            }
+            
+            const auto status = std::find_if( headers.begin( ), headers.end( ), [ ]( const std::pair< string, string >& header )
+            {
+                return header.first == ":status";
+            } );
+            
+            if ( status == headers.end( ) or status->second.length( ) not_eq 3 or not std::all_of( status->second.begin( ), status->second.end( ), ::isdigit ) )
+            {
+                return abandon( stream, PROTOCOL_ERROR, asio::error::connection_reset );
+            }
+            
+            //Interim responses precede the final one and are of no interest to the caller.
+            if ( status->second[ 0 ] == '1' )
+            {
+                if ( final )
+                {
+                    abandon( stream, PROTOCOL_ERROR, asio::error::connection_reset );
+                }
+                
+                return;
+            }
+            
+            stream->m_headers.swap( headers );
+            
+            const bool sized = std::any_of( stream->m_headers.begin( ), stream->m_headers.end( ), [ ]( const std::pair< string, string >& header )
+            {
+                return header.first == "content-length";
+            } );
+            
+            if ( sized )
+            {
+                dispatch( stream );
+            }
+            
+            if ( final )
+            {
+                close_remote( stream );
+            }
+        }
+        
+        void Http2ConnectionImpl::dispatch( const shared_ptr< Http2StreamImpl >& stream )
+        {
+            stream->m_dispatched = true;
+            
+            if ( m_client )
+            {
+                m_completions.emplace_back( std::move( stream->m_open_callback ), error_code( ), 0 );
+            }
+            else
+            {
+                m_arrivals.push_back( stream );
+            }
+        }
+        
+        void Http2ConnectionImpl::close_remote( const shared_ptr< Http2StreamImpl >& stream )
+        {
+            stream->m_remote_closed = true;
+            
+            if ( not stream->m_dispatched )
+            {
+                stream->m_headers.emplace_back( "content-length", to_string( stream->m_received ) );
+                dispatch( stream );
+            }
+            
+            //A released client stream keeps the rest of its response, as no further window updates are due.
+            if ( m_client and not stream->m_input.empty( ) )
+            {
+                const auto size = stream->m_input.size( );
+                const auto target = stream->m_buffer->prepare( size );
+                memcpy( asio::buffer_cast< Byte* >( target ), stream->m_input.data( ), size );
+                stream->m_buffer->commit( size );
+                stream->m_input.clear( );
+            }
+            
+            deliver( stream );
+            
+            if ( m_client and stream->m_output.empty( ) )
+            {
+                release( stream );
+            }
+        }
+        
+        void Http2ConnectionImpl::deliver( const shared_ptr< Http2StreamImpl >& stream )
+        {
+            if ( stream->m_read_callback == nullptr )
+            {
+                return;
+            }
+            
+            if ( not stream->m_input.empty( ) )
+            {
+                const auto size = stream->m_input.size( );
+                const auto target = stream->m_buffer->prepare( size );
+                memcpy( asio::buffer_cast< Byte* >( target ), stream->m_input.data( ), size );
+                stream->m_buffer->commit( size );
+                stream->m_input.clear( );
+                
+                acknowledge( stream, size );
+            }
+            
+            const auto size = stream->m_buffer->size( );
+            
+            if ( not stream->m_read_delimiter.empty( ) )
+            {
+                const auto data = asio::buffer_cast< const char* >( stream->m_buffer->data( ) );
+                const auto position = std::search( data, data + size, stream->m_read_delimiter.begin( ), stream->m_read_delimiter.end( ) );
+                
+                if ( position not_eq data + size )
+                {
+                    const auto length = static_cast< size_t >( position - data ) + stream->m_read_delimiter.length( );
+                    stream->m_read_delimiter.clear( );
+                    return m_completions.emplace_back( std::move( stream->m_read_callback ), error_code( ), length );
+                }
+            }
+            else if ( size >= stream->m_read_length )
+            {
+                return m_completions.emplace_back( std::move( stream->m_read_callback ), error_code( ), size );
+            }
+            
+            if ( stream->m_remote_closed )
+            {
+                stream->m_read_delimiter.clear( );
+                m_completions.emplace_back( std::move( stream->m_read_callback ), asio::error::eof, size );
+            }
+        }
+        
+        void Http2ConnectionImpl::acknowledge( const shared_ptr< Http2StreamImpl >& stream, const size_t length )
+        {
+            if ( stream->m_remote_closed or length == 0 )
+            {
+                return;
+            }
+            
+            stream->m_unacknowledged += length;
+            
+            if ( stream->m_unacknowledged >= static_cast< size_t >( DEFAULT_WINDOW / 2 ) )
+            {
+                Bytes increment;
+                write_uint32( static_cast< uint32_t >( stream->m_unacknowledged ), increment );
+                queue_frame( WINDOW_UPDATE, 0, stream->m_id, increment.data( ), increment.size( ) );
+                
+                stream->m_receive_window += static_cast< int64_t >( stream->m_unacknowledged );
+                stream->m_unacknowledged = 0;
+            }
+        }
+        
+        void Http2ConnectionImpl::abandon( const shared_ptr< Http2StreamImpl >& stream, const uint32_t code, const error_code& error )
+        {
+            if ( not stream->m_reset )
+            {
+                Bytes payload;
+                write_uint32( code, payload );
+                queue_frame( RST_STREAM, 0, stream->m_id, payload.data( ), payload.size( ) );
+            }
+            
+            stream->m_reset = true;
+            
+            if ( stream->m_read_callback not_eq nullptr )
+            {
+                m_completions.emplace_back( std::move( stream->m_read_callback ), error, 0 );
+            }
+            
+            if ( stream->m_open_callback not_eq nullptr )
+            {
+                m_completions.emplace_back( std::move( stream->m_open_callback ), error, 0 );
+            }
+            
+            for ( auto& output : stream->m_output )
+            {
+                m_completions.emplace_back( std::move( output.m_callback ), error, 0 );
+            }
+            
+            stream->m_output.clear( );
+            release( stream );
+        }
+        
+        void Http2ConnectionImpl::release( const shared_ptr< Http2StreamImpl >& stream )
+        {
+            m_streams.erase( stream->m_id );
+            stream->m_input.clear( );
+            stream->m_read_callback = nullptr;
+        }
+        
+        void Http2ConnectionImpl::queue_frame( const uint8_t type, const uint8_t flags, const uint32_t id, const Byte* payload, const size_t length )
+        {
+            m_control.append( frame_header( length, type, flags, id ) );
+            
+            if ( length not_eq 0 )
+            {
+                m_control.append( payload, length );
+            }
+        }
+        
+        void Http2ConnectionImpl::encode_headers( const uint32_t id, const HeaderList& headers, const bool final, BufferChain& batch )
+        {
+            Bytes block;
+            m_encoder.encode( headers, block );
+            
+            size_t offset = 0;
+            
+            do
+            {
+                const auto length = min( block.size( ) - offset, m_max_frame_size );
+                const bool last = offset + length == block.size( );
+                
+                uint8_t flags = ( last ) ? END_HEADERS : 0;
+                flags |= ( offset == 0 and final ) ? END_STREAM : 0;
+                
+                batch.append( frame_header( length, ( offset == 0 ) ? HEADERS : CONTINUATION, flags, id ) );
+                batch.append( block.data( ) + offset, length );
+                offset += length;
+            }
+            while ( offset < block.size( ) );
+        }
+        
+        void Http2ConnectionImpl::schedule( BufferChain& batch )
+        {
+            batch.append( m_control );
+            m_control.clear( );
+            
+            vector< shared_ptr< Http2StreamImpl > > finished;
+            bool progress = true;
+            bool ordered = true;
+            
+            size_t active = std::count_if( m_streams.begin( ), m_streams.end( ), [ ]( const std::pair< const uint32_t, shared_ptr< Http2StreamImpl > >& entry )
+            {
+                return entry.second->m_headers_sent;
+            } );
+            
+            //Each pass gives every ready stream a share proportional to its weight; a stream waits while the stream it depends on has data queued.
+            while ( progress and batch.get_size( ) < MAX_BATCH_SIZE )
+            {
+                progress = false;
+                
+                for ( auto& entry : m_streams )
+                {
+                    const auto& stream = entry.second;
+                    
+                    if ( stream->m_output.empty( ) )
+                    {
+                        continue;
+                    }
+                    
+                    //Streams we initiate stay unopened while the peer's concurrency limit is reached.
+                    if ( m_client and not stream->m_headers_sent and active >= m_peer_stream_limit )
+                    {
+                        continue;
+                    }
+                    
+                    const auto parent = m_streams.find( stream->m_dependency );
+                    
+                    if ( ordered and parent not_eq m_streams.end( ) and not parent->second->m_output.empty( ) and ( m_window > 0 and parent->second->m_window > 0 ) )
+                    {
+                        continue;
+                    }
+                    
+                    const size_t quantum = std::max< size_t >( m_max_frame_size * stream->m_weight / 256, 1024 );
+                    size_t emitted = 0;
+                    
+                    while ( not stream->m_output.empty( ) and emitted < quantum )
+                    {
+                        auto& output = stream->m_output.front( );
+                        
+                        if ( output.m_has_headers )
+                        {
+                            const bool end = output.m_final and output.m_data.is_empty( );
+                            encode_headers( stream->m_id, output.m_headers, end, batch );
+                            
+                            output.m_has_headers = false;
+                            output.m_headers.clear( );
+                            active += ( stream->m_headers_sent ) ? 0 : 1;
+                            stream->m_headers_sent = true;
+                            progress = true;
+                            
+                            if ( not end )
+                            {
+                                continue;
+                            }
+                        }
+                        else if ( output.m_data.is_empty( ) )
+                        {
+                            if ( output.m_final )
+                            {
+                                batch.append( frame_header( 0, DATA, END_STREAM, stream->m_id ) );
+                            }
+                            
+                            progress = true;
+                        }
+                        else
+                        {
+                            const auto window = min( m_window, stream->m_window );
+                            
+                            if ( window <= 0 )
+                            {
+                                break;
+                            }
+                            
+                            const auto length = min( { output.m_data.get_size( ), m_max_frame_size, quantum - emitted, static_cast< size_t >( window ) } );
+                            const bool end = output.m_final and length == output.m_data.get_size( );
+                            
+                            batch.append( frame_header( length, DATA, ( end ) ? END_STREAM : 0, stream->m_id ) );
+                            batch.append( output.m_data.slice( 0, length ) );
+                            output.m_data.consume( length );
+                            
+                            m_window -= static_cast< int64_t >( length );
+                            stream->m_window -= static_cast< int64_t >( length );
+                            emitted += length;
+                            progress = true;
+                            
+                            if ( not output.m_data.is_empty( ) )
+                            {
+                                continue;
+                            }
+                        }
+                        
+                        const bool final = output.m_final;
+                        m_inflight.push_back( std::move( output.m_callback ) );
+                        stream->m_output.pop_front( );
+                        
+                        if ( final )
+                        {
+                            finished.push_back( stream );
+                            break;
+                        }
+                    }
+                }
+                
+                for ( const auto& stream : finished )
+                {
+                    //A client stream lives on until its response has arrived.
+                    if ( m_client )
+                    {
+                        if ( stream->m_remote_closed )
+                        {
+                            release( stream );
+                        }
+                        
+                        continue;
+                    }
+                    
+                    //A request body the handler never read is cut short once the response is complete.
+                    if ( not stream->m_remote_closed )
+                    {
+                        Bytes code;
+                        write_uint32( NO_ERROR, code );
+                        batch.append( frame_header( code.size( ), RST_STREAM, 0, stream->m_id ) );
+                        batch.append( code );
+                    }
+                    
+                    release( stream );
+                }
+                
+                finished.clear( );
+                
+                //Dependencies that form a cycle would otherwise stall every stream in it.
+                if ( not progress and ordered )
+                {
+                    ordered = false;
+                    progress = true;
+                }
+            }
+        }
+        
+        void Http2ConnectionImpl::flush( void )
+        {
+            unique_lock< mutex > lock( m_mutex );
+            
+            if ( m_writing or m_closed )
+            {
+                return;
+            }
+            
+            BufferChain batch;
+            schedule( batch );
+            
+            if ( batch.is_empty( ) )
+            {
+                if ( m_closing and m_streams.empty( ) )
+                {
+                    m_closed = true;
+                    lock.unlock( );
+                    m_socket->close( );
+                }
+                
+                return;
+            }
+            
+            m_writing = true;
+            lock.unlock( );
+            
+            auto connection = shared_from_this( );
+            
+            m_socket->start_write( batch, [ connection ]( const error_code & error, const size_t )
+            {
+                connection->complete( error );
+            } );
+        }
+        
+        void Http2ConnectionImpl::complete( const error_code& error )
+        {
+            vector< CallbackImpl< void ( const error_code&, size_t ) > > callbacks;
+            
+            {
+                unique_lock< mutex > lock( m_mutex );
+                callbacks.swap( m_inflight );
+                m_writing = false;
+            }
+            
+            for ( auto& callback : callbacks )
+            {
+                if ( callback not_eq nullptr )
+                {
+                    callback( error, 0 );
+                }
+            }
+            
+            if ( error )
+            {
+                return shutdown( error );
+            }
+            
+            flush( );
+        }
+        
+        void Http2ConnectionImpl::finish( Completions& completions )
+        {
+            for ( auto& completion : completions )
+            {
+                auto& callback = get< 0 >( completion );
+                
+                if ( callback not_eq nullptr )
+                {
+                    callback( get< 1 >( completion ), get< 2 >( completion ) );
+                }
+            }
+        }
+        
+        void Http2ConnectionImpl::terminate( const uint32_t code )
+        {
+            //The last stream identifier names streams the peer initiated, of which a client has none.
+            Bytes payload;
+            write_uint32( ( m_client ) ? 0 : m_last_stream_id, payload );
+            write_uint32( code, payload );
+            queue_frame( GOAWAY, 0, 0, payload.data( ), payload.size( ) );
+            
+            m_closing = true;
+            
+            while ( not m_streams.empty( ) )
+            {
+                const auto stream = m_streams.begin( )->second;
+                stream->m_reset = true;
+                abandon( stream, code, asio::error::connection_aborted );
+            }
+        }
+        
+        void Http2ConnectionImpl::shutdown( const error_code& error )
+        {
+            Completions completions;
+            
+            {
+                unique_lock< mutex > lock( m_mutex );
+                
+                if ( m_closed )
+                {
+                    return;
+                }
+                
+                m_closed = true;
+                
+                while ( not m_streams.empty( ) )
+                {
+                    const auto stream = m_streams.begin( )->second;
+                    stream->m_reset = true;
+                    abandon( stream, NO_ERROR, error );
+                }
+                
+                m_control.clear( );
+                completions.swap( m_completions );
+            }
+            
+            m_socket->close( );
+            finish( completions );
+        }
+    }
+}
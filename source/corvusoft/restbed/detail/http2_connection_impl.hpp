@@ -0,0 +1,248 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <map>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <functional>
+#include <system_error>
+
+//Project Includes
+#include "corvusoft/restbed/byte.hpp"
+#include "corvusoft/restbed/buffer_chain.hpp"
+#include "corvusoft/restbed/detail/hpack_impl.hpp"
+#include "corvusoft/restbed/detail/callback_impl.hpp"
+
+//External Includes
+#include <asio/streambuf.hpp>
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    class Settings;
+    
+    namespace detail
+    {
+        //Forward Declarations
+        class SocketImpl;
+        struct Http2StreamImpl;
+        
+        //One HTTP/2 connection (RFC 7540): framing, stream multiplexing, flow control and weighted scheduling of outgoing data.
+        //Servers dispatch each request stream to the request handler; clients open streams with request( ) and await each response head.
+        class Http2ConnectionImpl : public std::enable_shared_from_this< Http2ConnectionImpl >
+        {
+            public:
+                //Friends
+                
+                //Definitions
+                typedef std::vector< std::pair< std::string, std::string > > HeaderList;
+                
+                //Constructors
+                Http2ConnectionImpl( const std::shared_ptr< SocketImpl >& socket, const std::shared_ptr< const Settings >& settings, const bool client = false );
+                
+                virtual ~Http2ConnectionImpl( void );
+                
+                //Functionality
+                //Sends our preface and begins reading frames; for servers buffer holds anything already read, starting with the client preface.
+                void start( const std::shared_ptr< asio::streambuf >& buffer );
+                
+                //Applies the HTTP2-Settings of an "Upgrade: h2c" request and opens stream one, half closed, for the request itself.
+                void upgrade( const Bytes& settings, const HeaderList& headers );
+                
+                //Client only; opens a stream carrying a complete request, callback runs once the response head has arrived in the stream's headers.
+                std::shared_ptr< Http2StreamImpl > request( const HeaderList& headers, const BufferChain& body, CallbackImpl< void ( const std::error_code&, std::size_t ) > callback );
+                
+                //Completes once the stream's buffer holds length bytes, or fails if the peer ends the stream first.
+                void read( const std::shared_ptr< Http2StreamImpl >& stream, const std::size_t length, CallbackImpl< void ( const std::error_code&, std::size_t ) > callback );
+                
+                void read( const std::shared_ptr< Http2StreamImpl >& stream, const std::string& delimiter, CallbackImpl< void ( const std::error_code&, std::size_t ) > callback );
+                
+                //Queues a response head and body; callback runs once the body has been written, which flow control may defer.
+                void write( const std::shared_ptr< Http2StreamImpl >& stream, const int status, const std::multimap< std::string, std::string >& headers, const BufferChain& body, const bool final, CallbackImpl< void ( const std::error_code&, std::size_t ) > callback );
+                
+                void write( const std::shared_ptr< Http2StreamImpl >& stream, const BufferChain& body, const bool final, CallbackImpl< void ( const std::error_code&, std::size_t ) > callback );
+                
+                //Abandons a stream whose exchange was left unfinished.
+                void reset( const std::shared_ptr< Http2StreamImpl >& stream );
+                
+                //Getters
+                //False once either side has begun shutting the connection down; no further streams may be opened.
+                bool is_open( void );
+                
+                //Setters
+                void set_request_handler( const std::function< void ( const std::shared_ptr< Http2StreamImpl > ) >& value );
+                
+                //Operators
+                
+                //Properties
+            
+            protected:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                
+                //Functionality
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+            
+            private:
+                //Friends
+                
+                //Definitions
+                typedef std::vector< std::tuple< CallbackImpl< void ( const std::error_code&, std::size_t ) >, std::error_code, std::size_t > > Completions;
+                
+                //Constructors
+                Http2ConnectionImpl( const Http2ConnectionImpl& original ) = delete;
+                
+                //Functionality
+                void receive( const std::error_code& error );
+                
+                void process( const std::uint8_t type, const std::uint8_t flags, const std::uint32_t id, const Byte* payload, const std::size_t length );
+                
+                void process_data( const std::uint8_t flags, const std::uint32_t id, const Byte* payload, std::size_t length );
+                
+                void process_headers( const std::uint8_t flags, const std::uint32_t id, const Byte* payload, std::size_t length );
+                
+                void process_continuation( const std::uint8_t flags, const std::uint32_t id, const Byte* payload, const std::size_t length );
+                
+                void process_settings( const std::uint8_t flags, const std::uint32_t id, const Byte* payload, const std::size_t length );
+                
+                void process_priority( const std::uint32_t id, const Byte* payload, const std::size_t length );
+                
+                void configure( const Byte* payload, const std::size_t length );
+                
+                void process_window_update( const std::uint32_t id, const Byte* payload, const std::size_t length );
+                
+                void process_reset( const std::uint32_t id, const Byte* payload, const std::size_t length );
+                
+                void complete_headers( void );
+                
+                void open( const std::uint32_t id, HeaderList& headers, const bool final );
+                
+                void complete_response( const std::uint32_t id, const std::uint8_t flags, HeaderList& headers );
+                
+                //Hands a stream whose head is complete to the request handler, or to the waiting client.
+                void dispatch( const std::shared_ptr< Http2StreamImpl >& stream );
+                
+                void close_remote( const std::shared_ptr< Http2StreamImpl >& stream );
+                
+                //Moves received data into the stream's request buffer and completes its pending read when satisfied.
+                void deliver( const std::shared_ptr< Http2StreamImpl >& stream );
+                
+                void acknowledge( const std::shared_ptr< Http2StreamImpl >& stream, const std::size_t length );
+                
+                void abandon( const std::shared_ptr< Http2StreamImpl >& stream, const std::uint32_t code, const std::error_code& error );
+                
+                void release( const std::shared_ptr< Http2StreamImpl >& stream );
+                
+                void queue_frame( const std::uint8_t type, const std::uint8_t flags, const std::uint32_t id, const Byte* payload, const std::size_t length );
+                
+                void encode_headers( const std::uint32_t id, const HeaderList& headers, const bool final, BufferChain& batch );
+                
+                //Emits as much queued response data as the flow control windows allow, in priority order.
+                void schedule( BufferChain& batch );
+                
+                void flush( void );
+                
+                void complete( const std::error_code& error );
+                
+                void finish( Completions& completions );
+                
+                void terminate( const std::uint32_t code );
+                
+                void shutdown( const std::error_code& error );
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                Http2ConnectionImpl& operator =( const Http2ConnectionImpl& value ) = delete;
+                
+                //Properties
+                std::mutex m_mutex;
+                
+                std::shared_ptr< SocketImpl > m_socket;
+                
+                std::shared_ptr< const Settings > m_settings;
+                
+                std::shared_ptr< asio::streambuf > m_buffer;
+                
+                bool m_client;
+                
+                bool m_preface;
+                
+                bool m_closing;
+                
+                bool m_closed;
+                
+                bool m_writing;
+                
+                std::uint32_t m_last_stream_id;
+                
+                std::size_t m_stream_limit;
+                
+                std::size_t m_peer_stream_limit;
+                
+                std::map< std::uint32_t, std::shared_ptr< Http2StreamImpl > > m_streams;
+                
+                HpackImpl m_decoder;
+                
+                HpackImpl m_encoder;
+                
+                std::uint32_t m_continuation;
+                
+                std::uint8_t m_continuation_flags;
+                
+                std::uint32_t m_continuation_dependency;
+                
+                std::uint16_t m_continuation_weight;
+                
+                Bytes m_header_block;
+                
+                std::int64_t m_window;
+                
+                std::int64_t m_initial_window;
+                
+                std::int64_t m_receive_window;
+                
+                std::size_t m_unacknowledged;
+                
+                std::size_t m_max_frame_size;
+                
+                BufferChain m_control;
+                
+                std::vector< std::shared_ptr< Http2StreamImpl > > m_arrivals;
+                
+                Completions m_completions;
+                
+                std::vector< CallbackImpl< void ( const std::error_code&, std::size_t ) > > m_inflight;
+                
+                std::function< void ( const std::shared_ptr< Http2StreamImpl > ) > m_request_handler;
+        };
+    }
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <system_error>
+
+//Project Includes
+#include "corvusoft/restbed/byte.hpp"
+#include "corvusoft/restbed/buffer_chain.hpp"
+#include "corvusoft/restbed/detail/callback_impl.hpp"
+
+//External Includes
+#include <asio/streambuf.hpp>
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    
+    namespace detail
+    {
+        //Forward Declarations
+        class Http2ConnectionImpl;
+        
+        //A response part queued on a stream; headers, when present, leave as a HEADERS frame ahead of the data.
+        struct Http2OutputImpl
+        {
+            bool m_has_headers = false;
+            
+            std::vector< std::pair< std::string, std::string > > m_headers { };
+            
+            BufferChain m_data { };
+            
+            bool m_final = false;
+            
+            CallbackImpl< void ( const std::error_code&, std::size_t ) > m_callback = nullptr;
+        };
+        
+        //State of one HTTP/2 stream; everything but m_reset is guarded by the owning connection's mutex.
+        struct Http2StreamImpl
+        {
+            std::uint32_t m_id = 0;
+            
+            std::shared_ptr< Http2ConnectionImpl > m_connection = nullptr;
+            
+            std::vector< std::pair< std::string, std::string > > m_headers { };
+            
+            bool m_dispatched = false;
+            
+            bool m_remote_closed = false;
+            
+            bool m_local_closed = false;
+            
+            bool m_headers_sent = false;
+            
+            std::atomic< bool > m_reset { false };
+            
+            //Body bytes received but not yet handed to the request buffer; held back until the session reads.
+            Bytes m_input { };
+            
+            std::size_t m_received = 0;
+            
+            std::size_t m_unacknowledged = 0;
+            
+            std::int64_t m_receive_window = 65535;
+            
+            std::shared_ptr< asio::streambuf > m_buffer = nullptr;
+            
+            std::size_t m_read_length = 0;
+            
+            std::string m_read_delimiter = "";
+            
+            CallbackImpl< void ( const std::error_code&, std::size_t ) > m_read_callback = nullptr;
+            
+            //Client streams only; runs once the response head has arrived in m_headers.
+            CallbackImpl< void ( const std::error_code&, std::size_t ) > m_open_callback = nullptr;
+            
+            std::int64_t m_window = 65535;
+            
+            std::uint32_t m_dependency = 0;
+            
+            std::uint16_t m_weight = 16;
+            
+            std::deque< Http2OutputImpl > m_output { };
+        };
+    }
+}
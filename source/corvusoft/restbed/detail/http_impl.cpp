@@ -4,14 +4,18 @@
 
 //System Includes
 #include <map>
+#include <mutex>
 #include <regex>
+#include <thread>
 #include <sstream>
+#include <utility>
 #include <cstdlib>
 #include <clocale>
 #include <ciso646>
 
 //Project Includes
 #include "corvusoft/restbed/uri.hpp"
+#include "corvusoft/restbed/common.hpp"
 #include "corvusoft/restbed/string.hpp"
 #include "corvusoft/restbed/request.hpp"
 #include "corvusoft/restbed/response.hpp"
@@ -20,6 +24,8 @@
 #include "corvusoft/restbed/detail/http_impl.hpp"
 #include "corvusoft/restbed/detail/socket_impl.hpp"
 #include "corvusoft/restbed/detail/request_impl.hpp"
+#include "corvusoft/restbed/detail/http2_stream_impl.hpp"
+#include "corvusoft/restbed/detail/http2_connection_impl.hpp"
 
 //External Includes
 #include <asio/error.hpp>
@@ -32,20 +38,29 @@
 #endif
 
 //System Namespaces
+using std::map;
 using std::free;
 using std::bind;
-using std::stod;
+using std::pair;
+using std::mutex;
 using std::regex;
+using std::future;
 using std::smatch;
 using std::string;
+using std::thread;
 using std::istream;
+using std::promise;
 using std::function;
 using std::multimap;
+using std::weak_ptr;
+using std::make_pair;
 using std::setlocale;
 using std::to_string;
 using std::shared_ptr;
 using std::error_code;
+using std::unique_lock;
 using std::make_shared;
+using std::system_error;
 using std::placeholders::_1;
 using std::placeholders::_2;
 
@@ -66,21 +81,7 @@ namespace restbed
     {
         Bytes HttpImpl::to_bytes( const shared_ptr< Request >& request )
         {
-            auto path = request->get_path( );
-            
-            auto parameters = request->get_query_parameters( );
-            
-            if ( not parameters.empty( ) )
-            {
-                string query = String::empty;
-                
-                for ( const auto parameter : parameters )
-                {
-                    query += Uri::encode_parameter( parameter.first ) + "=" + Uri::encode_parameter( parameter.second ) + "&";
-                }
-                
-                path += "?" + query.substr( 0, query.length( ) - 1 );
-            }
+            auto path = create_target( request );
             
             auto uri = request->m_pimpl->m_uri;
             
@@ -124,7 +125,7 @@ namespace restbed
             data += "\r\n";
             
             auto bytes = String::to_bytes( data );
-            auto body = request->get_body( );
+            const auto& body = request->get_body( );
             
             if ( not body.empty( ) )
             {
@@ -147,7 +148,7 @@ namespace restbed
                 
                 if ( String::uppercase( request->m_pimpl->m_protocol ) == "HTTPS" )
                 {
-                    ssl_socket_setup( request, settings->get_ssl_settings( ) );
+                    ssl_socket_setup( request, settings );
                 }
                 else
                 {
@@ -164,14 +165,16 @@ namespace restbed
         }
         
 #ifdef BUILD_SSL
-        void HttpImpl::ssl_socket_setup( const shared_ptr< Request >& request, const shared_ptr< const SSLSettings >& settings )
+        void HttpImpl::ssl_socket_setup( const shared_ptr< Request >& request, const shared_ptr< const Settings >& settings )
         {
             asio::ssl::context context( asio::ssl::context::sslv23 );
             shared_ptr< asio::ssl::stream< asio::ip::tcp::socket > > socket = nullptr;
             
-            if ( settings not_eq nullptr )
+            const auto ssl_settings = settings->get_ssl_settings( );
+            
+            if ( ssl_settings not_eq nullptr )
             {
-                const auto pool = settings->get_certificate_authority_pool( );
+                const auto pool = ssl_settings->get_certificate_authority_pool( );
                 
                 if ( pool.empty( ) )
                 {
@@ -179,7 +182,7 @@ namespace restbed
                 }
                 else
                 {
-                    context.add_verify_path( settings->get_certificate_authority_pool( ) );
+                    context.add_verify_path( ssl_settings->get_certificate_authority_pool( ) );
                 }
                 
                 socket = make_shared< asio::ssl::stream< asio::ip::tcp::socket > >( *request->m_pimpl->m_io_service, context );
@@ -192,9 +195,190 @@ namespace restbed
             }
             
             socket->set_verify_callback( asio::ssl::rfc2818_verification( request->get_host( ) ) );
+            
+            //Offer HTTP/2 ahead of HTTP/1.1; the server's pick decides how the connection is used.
+            if ( settings->get_http2_enabled( ) )
+            {
+                static const unsigned char protocols[ ] = "\x02h2\x08http/1.1";
+                SSL_set_alpn_protos( socket->native_handle( ), protocols, sizeof( protocols ) - 1 );
+            }
+            
             request->m_pimpl->m_socket = make_shared< SocketImpl >( socket );
         }
 #endif
+        shared_ptr< Http2ConnectionImpl > HttpImpl::http2_connect( const shared_ptr< Request >& request, const shared_ptr< const Settings >& settings )
+        {
+            static mutex connections_lock;
+            static map< string, pair< weak_ptr< Http2ConnectionImpl >, weak_ptr< io_service > > > connections;
+            
+            auto& state = *request->m_pimpl;
+            
+            //A request already holding a connection of its own negotiated HTTP/1.1 and keeps using it.
+            if ( state.m_stream == nullptr and state.m_socket not_eq nullptr )
+            {
+                return nullptr;
+            }
+            
+            if ( state.m_stream not_eq nullptr )
+            {
+                state.m_stream->m_connection->reset( state.m_stream );
+                state.m_stream = nullptr;
+            }
+            
+            const auto origin = String::lowercase( request->get_protocol( ) ) + "://" + request->get_host( ) + ":" + ::to_string( request->get_port( ) );
+            
+            //Held while connecting, so concurrent requests to one origin wait for a single connection rather than each opening their own.
+            unique_lock< mutex > lock( connections_lock );
+            
+            auto& entry = connections[ origin ];
+            auto connection = entry.first.lock( );
+            auto pooled_io_service = entry.second.lock( );
+            
+            if ( connection not_eq nullptr and pooled_io_service not_eq nullptr and connection->is_open( ) )
+            {
+                state.m_io_service = pooled_io_service;
+                return connection;
+            }
+            
+            state.m_io_service = make_shared< io_service >( );
+            socket_setup( request, settings );
+            
+            error_code failure;
+            
+            state.m_socket->connect( request->get_host( ), request->get_port( ), [ &failure ]( const error_code & error )
+            {
+                failure = error;
+            } );
+            
+            try
+            {
+                state.m_io_service->run( );
+            }
+            catch ( const system_error& se )
+            {
+                failure = se.code( );
+            }
+            
+            state.m_io_service->reset( );
+            
+            if ( failure )
+            {
+                state.m_socket = nullptr;
+                return nullptr;
+            }
+            
+            //Cleartext connections assume the origin speaks HTTP/2 (prior knowledge); secure ones only when ALPN agreed.
+            if ( state.m_socket->is_secure( ) and state.m_socket->get_application_protocol( ) not_eq "h2" )
+            {
+                return nullptr;
+            }
+            
+            connection = make_shared< Http2ConnectionImpl >( state.m_socket, settings, true );
+            connection->start( make_shared< asio::streambuf >( ) );
+            entry = make_pair( connection, state.m_io_service );
+            state.m_socket = nullptr;
+            
+            //The connection's frames are read and written on a thread of its own until it closes, idle connections after the connection timeout.
+            const auto connection_io_service = state.m_io_service;
+            
+            thread( [ connection_io_service ]( )
+            {
+                connection_io_service->run( );
+            } ).detach( );
+            
+            return connection;
+        }
+        
+        future< shared_ptr< Response > > HttpImpl::http2_async( const shared_ptr< Http2ConnectionImpl >& connection, const shared_ptr< Request >& request, const function< void ( const shared_ptr< Request >, const shared_ptr< Response > ) >& callback, const shared_ptr< const Settings >& settings )
+        {
+            auto authority = request->get_header( "Host" );
+            
+            if ( authority.empty( ) )
+            {
+                const auto port = request->get_port( );
+                const bool secure = String::uppercase( request->get_protocol( ) ) == "HTTPS";
+                authority = request->get_host( ) + ( ( port == ( secure ? 443 : 80 ) ) ? "" : ":" + ::to_string( port ) );
+            }
+            
+            Http2ConnectionImpl::HeaderList headers;
+            headers.emplace_back( ":method", request->get_method( ) );
+            headers.emplace_back( ":scheme", String::lowercase( request->get_protocol( ) ) );
+            headers.emplace_back( ":authority", authority );
+            headers.emplace_back( ":path", create_target( request ) );
+            
+            for ( const auto& header : request->get_headers( ) )
+            {
+                auto name = String::lowercase( header.first );
+                
+                //Hop-by-hop fields are meaningless in HTTP/2 and make the request malformed.
+                if ( name == "host" or name == "connection" or name == "keep-alive" or name == "proxy-connection" or name == "transfer-encoding" or name == "upgrade" or ( name == "te" and header.second not_eq "trailers" ) )
+                {
+                    continue;
+                }
+                
+                headers.emplace_back( std::move( name ), header.second );
+            }
+            
+            BufferChain body;
+            request->get_body( body );
+            
+            auto outcome = make_shared< promise< error_code > >( );
+            
+            request->m_pimpl->m_stream = connection->request( headers, body, [ outcome ]( const error_code & error, size_t )
+            {
+                outcome->set_value( error );
+            } );
+            
+            request->m_pimpl->m_buffer = request->m_pimpl->m_stream->m_buffer;
+            
+            if ( callback not_eq nullptr )
+            {
+                return std::async( std::launch::async, [ outcome, request, callback, settings ]( ) -> shared_ptr< Response >
+                {
+                    const auto response = create_http2_response( outcome->get_future( ).get( ), request, settings );
+                    callback( request, response );
+                    
+                    return response;
+                } );
+            }
+            
+            promise< shared_ptr< Response > > result;
+            result.set_value( create_http2_response( outcome->get_future( ).get( ), request, settings ) );
+            
+            return result.get_future( );
+        }
+        
+        size_t HttpImpl::http2_read( const shared_ptr< Http2StreamImpl >& stream, const size_t length, error_code& error )
+        {
+            auto outcome = make_shared< promise< pair< error_code, size_t > > >( );
+            auto result = outcome->get_future( );
+            
+            stream->m_connection->read( stream, length, [ outcome ]( const error_code & error, size_t size )
+            {
+                outcome->set_value( make_pair( error, size ) );
+            } );
+            
+            const auto value = result.get( );
+            error = value.first;
+            
+            return value.second;
+        }
+        
+        size_t HttpImpl::http2_read( const shared_ptr< Http2StreamImpl >& stream, const string& delimiter, error_code& error )
+        {
+            auto outcome = make_shared< promise< pair< error_code, size_t > > >( );
+            auto result = outcome->get_future( );
+            
+            stream->m_connection->read( stream, delimiter, [ outcome ]( const error_code & error, size_t size )
+            {
+                outcome->set_value( make_pair( error, size ) );
+            } );
+            
+            const auto value = result.get( );
+            error = value.first;
+            
+            return value.second;
+        }
         void HttpImpl::request_handler( const error_code& error, const shared_ptr< Request >& request, const function< void ( const shared_ptr< Request >, const shared_ptr< Response > ) >& callback   )
         {
             if ( error )
@@ -218,6 +402,27 @@ namespace restbed
             request->m_pimpl->m_socket->start_read( request->m_pimpl->m_buffer, "\r\n", bind( read_status_handler, _1, _2, request, callback ) );
         }
         
+        string HttpImpl::create_target( const shared_ptr< Request >& request )
+        {
+            auto path = request->get_path( );
+            
+            auto parameters = request->get_query_parameters( );
+            
+            if ( not parameters.empty( ) )
+            {
+                string query = String::empty;
+                
+                for ( const auto parameter : parameters )
+                {
+                    query += Uri::encode_parameter( parameter.first ) + "=" + Uri::encode_parameter( parameter.second ) + "&";
+                }
+                
+                path += "?" + query.substr( 0, query.length( ) - 1 );
+            }
+            
+            return path;
+        }
+        
         const shared_ptr< Response > HttpImpl::create_error_response( const shared_ptr< Request >& request, const string& message )
         {
             auto response = request->m_pimpl->m_response;
@@ -232,6 +437,44 @@ namespace restbed
             return response;
         }
         
+        const shared_ptr< Response > HttpImpl::create_http2_response( const error_code& error, const shared_ptr< Request >& request, const shared_ptr< const Settings >& settings )
+        {
+            if ( error )
+            {
+                const auto body = String::format( "HTTP/2 stream failed: %s", error.message( ).data( ) );
+                return create_error_response( request, body );
+            }
+            
+            int status = 0;
+            multimap< string, string > headers = { };
+            
+            for ( const auto& header : request->m_pimpl->m_stream->m_headers )
+            {
+                if ( header.first == ":status" )
+                {
+                    status = stoi( header.second );
+                }
+                else if ( header.first[ 0 ] not_eq ':' )
+                {
+                    headers.insert( header );
+                }
+            }
+            
+            if ( status == 0 )
+            {
+                return create_error_response( request, "HTTP/2 response carried no status" );
+            }
+            
+            auto response = request->m_pimpl->m_response;
+            response->set_protocol( "HTTP" );
+            response->set_version( 2.0 );
+            response->set_status_code( status );
+            response->set_status_message( settings->get_status_message( status ) );
+            response->set_headers( headers );
+            
+            return response;
+        }
+        
         void HttpImpl::read_status_handler( const error_code& error, const size_t, const shared_ptr< Request >& request, const function< void ( const shared_ptr< Request >, const shared_ptr< Response > ) >& callback )
         {
             if ( error )
@@ -253,9 +496,12 @@ namespace restbed
                 return callback( request, create_error_response( request, body ) );
             }
             
+            double version = 0;
+            Common::parse( matches[ 2 ].str( ), version );
+            
             auto response = request->m_pimpl->m_response;
             response->set_protocol( matches[ 1 ].str( ) );
-            response->set_version( stod( matches[ 2 ].str( ) ) );
+            response->set_version( version );
             response->set_status_code( stoi( matches[ 3 ].str( ) ) );
             response->set_status_message( matches[ 4 ].str( ) );
             
@@ -5,6 +5,7 @@
 #pragma once
 
 //System Includes
+#include <future>
 #include <string>
 #include <memory>
 #include <functional>
@@ -27,11 +28,12 @@ namespace restbed
     class Request;
     class Response;
     class Settings;
-    class SSLSettings;
     
     namespace detail
     {
         //Forward Declarations
+        struct Http2StreamImpl;
+        class Http2ConnectionImpl;
         
         class HttpImpl
         {
@@ -47,8 +49,18 @@ namespace restbed
                 
                 static void socket_setup( const std::shared_ptr< Request >& request, const std::shared_ptr< const Settings >& settings );
 #ifdef BUILD_SSL
-                static void ssl_socket_setup( const std::shared_ptr< Request >& request, const std::shared_ptr< const SSLSettings >& settings );
+                static void ssl_socket_setup( const std::shared_ptr< Request >& request, const std::shared_ptr< const Settings >& settings );
 #endif
+                //Pooled HTTP/2 connection to the request's origin, connecting one when none is open; nullptr when the exchange stays on HTTP/1.1.
+                static std::shared_ptr< Http2ConnectionImpl > http2_connect( const std::shared_ptr< Request >& request, const std::shared_ptr< const Settings >& settings );
+                
+                static std::future< std::shared_ptr< Response > > http2_async( const std::shared_ptr< Http2ConnectionImpl >& connection, const std::shared_ptr< Request >& request, const std::function< void ( const std::shared_ptr< Request >, const std::shared_ptr< Response > ) >& callback, const std::shared_ptr< const Settings >& settings );
+                
+                //Blocks until the stream has delivered the response body asked for, with the semantics of a socket read.
+                static std::size_t http2_read( const std::shared_ptr< Http2StreamImpl >& stream, const std::size_t length, std::error_code& error );
+                
+                static std::size_t http2_read( const std::shared_ptr< Http2StreamImpl >& stream, const std::string& delimiter, std::error_code& error );
+                
                 static void request_handler( const std::error_code& error, const std::shared_ptr< Request >& request, const std::function< void ( const std::shared_ptr< Request >, const std::shared_ptr< Response > ) >& callback );
                 
                 static void write_handler( const std::error_code& error, const std::size_t length, const std::shared_ptr< Request >& request, const std::function< void ( const std::shared_ptr< Request >, const std::shared_ptr< Response > ) >& callback );
@@ -60,7 +72,7 @@ namespace restbed
                 //Operators
                 
                 //Properties
-                
+            
             protected:
                 //Friends
                 
@@ -77,7 +89,7 @@ namespace restbed
                 //Operators
                 
                 //Properties
-                
+            
             private:
                 //Friends
                 
@@ -91,8 +103,12 @@ namespace restbed
                 HttpImpl( const HttpImpl& original ) = delete;
                 
                 //Functionality
+                static std::string create_target( const std::shared_ptr< Request >& request );
+                
                 static const std::shared_ptr< Response > create_error_response( const std::shared_ptr< Request >& request, const std::string& message );
                 
+                static const std::shared_ptr< Response > create_http2_response( const std::error_code& error, const std::shared_ptr< Request >& request, const std::shared_ptr< const Settings >& settings );
+                
                 static void read_status_handler( const std::error_code& error, const std::size_t length, const std::shared_ptr< Request >& request, const std::function< void ( const std::shared_ptr< Request >, const std::shared_ptr< Response > ) >& callback );
                 
                 static void read_headers_handler( const std::error_code& error, const std::size_t length, const std::shared_ptr< Request >& request, const std::function< void ( const std::shared_ptr< Request >, const std::shared_ptr< Response > ) >& callback );
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <mutex>
+#include <array>
+#include <atomic>
+#include <ciso646>
+#include <stdexcept>
+
+//Project Includes
+#include "corvusoft/restbed/detail/method_impl.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::mutex;
+using std::array;
+using std::atomic;
+using std::size_t;
+using std::string;
+using std::lock_guard;
+using std::length_error;
+using std::memory_order_acquire;
+using std::memory_order_release;
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    namespace detail
+    {
+        //Custom verbs are append only; readers scan the published prefix without locking.
+        struct CustomMethods
+        {
+            mutex m_lock { };
+            
+            atomic< size_t > m_count { 0 };
+            
+            array< string, MethodImpl::CAPACITY - MethodImpl::CUSTOM > m_names { };
+        };
+        
+        static CustomMethods& custom_methods( void )
+        {
+            static CustomMethods methods;
+            return methods;
+        }
+        
+        static int find_custom( const CustomMethods& methods, const string& method, const size_t count )
+        {
+            for ( size_t index = 0; index < count; index++ )
+            {
+                if ( methods.m_names[ index ] == method )
+                {
+                    return static_cast< int >( MethodImpl::CUSTOM + index );
+                }
+            }
+            
+            return MethodImpl::UNKNOWN;
+        }
+        
+        int MethodImpl::intern( const string& method )
+        {
+            const auto identifier = find( method );
+            
+            if ( identifier not_eq UNKNOWN )
+            {
+                return identifier;
+            }
+            
+            auto& methods = custom_methods( );
+            lock_guard< mutex > guard( methods.m_lock );
+            
+            const auto count = methods.m_count.load( memory_order_acquire );
+            const auto existing = find_custom( methods, method, count );
+            
+            if ( existing not_eq UNKNOWN )
+            {
+                return existing;
+            }
+            
+            if ( count == methods.m_names.size( ) )
+            {
+                throw length_error( "Too many distinct HTTP methods registered: " + method );
+            }
+            
+            methods.m_names[ count ] = method;
+            methods.m_count.store( count + 1, memory_order_release );
+            
+            return static_cast< int >( CUSTOM + count );
+        }
+        
+        int MethodImpl::find( const string& method )
+        {
+            const auto identifier = find_standard( method );
+            
+            if ( identifier not_eq UNKNOWN )
+            {
+                return identifier;
+            }
+            
+            const auto& methods = custom_methods( );
+            return find_custom( methods, method, methods.m_count.load( memory_order_acquire ) );
+        }
+        
+        int MethodImpl::find_standard( const string& method )
+        {
+            static const array< const char*, CUSTOM > standard = { {
+                    "GET", "PUT", "POST", "HEAD", "PATCH", "TRACE", "DELETE", "OPTIONS", "CONNECT"
+                }
+            };
+            
+            for ( size_t index = 0; index < standard.size( ); index++ )
+            {
+                if ( method == standard[ index ] )
+                {
+                    return static_cast< int >( index );
+                }
+            }
+            
+            return UNKNOWN;
+        }
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <bitset>
+#include <string>
+#include <cstddef>
+
+//Project Includes
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    
+    namespace detail
+    {
+        //Forward Declarations
+        
+        //Process wide interning of HTTP method names into small integer identifiers.
+        class MethodImpl
+        {
+            public:
+                //Friends
+                
+                //Definitions
+                //Identifiers below CUSTOM are reserved for the RFC 7231 and RFC 5789 methods.
+                enum Identifier : int
+                {
+                    UNKNOWN = -1,
+                    CUSTOM = 9
+                };
+                
+                static const std::size_t CAPACITY = 128;
+                
+                typedef std::bitset< CAPACITY > Set;
+                
+                //Constructors
+                
+                //Functionality
+                //Returns the identifier for method, registering custom verbs; throws std::length_error when the registry is full.
+                static int intern( const std::string& method );
+                
+                //Returns the identifier for method, or UNKNOWN if it has never been interned.
+                static int find( const std::string& method );
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+            
+            protected:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                
+                //Functionality
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+            
+            private:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                MethodImpl( void ) = delete;
+                
+                MethodImpl( const MethodImpl& original ) = delete;
+                
+                virtual ~MethodImpl( void ) = delete;
+                
+                //Functionality
+                static int find_standard( const std::string& method );
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                MethodImpl& operator =( const MethodImpl& value ) = delete;
+                
+                //Properties
+        };
+    }
+}
@@ -0,0 +1,282 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <cstring>
+#include <utility>
+#include <ciso646>
+#include <stdexcept>
+
+//Project Includes
+#include "corvusoft/restbed/string.hpp"
+#include "corvusoft/restbed/body_file.hpp"
+#include "corvusoft/restbed/detail/body_file_impl.hpp"
+#include "corvusoft/restbed/detail/multipart_parser_impl.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::size_t;
+using std::string;
+using std::memchr;
+using std::memcmp;
+using std::multimap;
+using std::make_pair;
+using std::shared_ptr;
+using std::invalid_argument;
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    namespace detail
+    {
+        static const size_t HEADER_LIMIT = 16 * 1024;
+        
+        static string trim( const char* data, size_t length )
+        {
+            while ( length not_eq 0 and ( data[ 0 ] == ' ' or data[ 0 ] == '\t' ) )
+            {
+                data++;
+                length--;
+            }
+            
+            while ( length not_eq 0 and ( data[ length - 1 ] == ' ' or data[ length - 1 ] == '\t' ) )
+            {
+                length--;
+            }
+            
+            return string( data, length );
+        }
+        
+        void MultipartParserImpl::setup( const string& boundary )
+        {
+            if ( boundary.empty( ) or boundary.length( ) > 70 )
+            {
+                throw invalid_argument( "Multipart boundary must be between 1 and 70 characters." );
+            }
+            
+            m_boundary = boundary;
+            
+            const string delimiter = "\r\n--" + boundary;
+            m_delimiter.assign( delimiter.begin( ), delimiter.end( ) );
+            
+            const size_t length = m_delimiter.size( );
+            
+            for ( auto& skip : m_skip )
+            {
+                skip = length;
+            }
+            
+            for ( size_t index = 0; index < length - 1; index++ )
+            {
+                m_skip[ m_delimiter[ index ] ] = length - 1 - index;
+            }
+        }
+        
+        size_t MultipartParserImpl::search( const Byte* data, const size_t length ) const
+        {
+            const size_t size = m_delimiter.size( );
+            const Byte* delimiter = m_delimiter.data( );
+            
+            size_t position = 0;
+            
+            while ( position + size <= length )
+            {
+                const Byte last = data[ position + size - 1 ];
+                
+                if ( last == delimiter[ size - 1 ] and memcmp( data + position, delimiter, size - 1 ) == 0 )
+                {
+                    return position;
+                }
+                
+                position += m_skip[ last ];
+            }
+            
+            return length;
+        }
+        
+        size_t MultipartParserImpl::overlap( const Byte* data, const size_t length ) const
+        {
+            size_t size = ( length < m_delimiter.size( ) ) ? length : m_delimiter.size( ) - 1;
+            
+            for ( ; size not_eq 0; size-- )
+            {
+                if ( data[ length - size ] == '\r' and memcmp( data + length - size, m_delimiter.data( ), size ) == 0 )
+                {
+                    break;
+                }
+            }
+            
+            return size;
+        }
+        
+        size_t MultipartParserImpl::process( const Byte* data, const size_t length )
+        {
+            size_t position = 0;
+            
+            while ( true )
+            {
+                const Byte* start = data + position;
+                const size_t available = length - position;
+                
+                if ( m_state == PREAMBLE or m_state == BODY )
+                {
+                    const size_t offset = search( start, available );
+                    
+                    if ( offset == available )
+                    {
+                        const size_t held = overlap( start, available );
+                        
+                        if ( m_state == BODY )
+                        {
+                            write_part( start, available - held );
+                        }
+                        
+                        return length - held;
+                    }
+                    
+                    if ( m_state == BODY )
+                    {
+                        write_part( start, offset );
+                        end_part( );
+                    }
+                    
+                    position += offset + m_delimiter.size( );
+                    m_state = BOUNDARY;
+                }
+                else if ( m_state == BOUNDARY )
+                {
+                    if ( available >= 2 and start[ 0 ] == '-' and start[ 1 ] == '-' )
+                    {
+                        m_state = EPILOGUE;
+                        return length;
+                    }
+                    
+                    //Transport padding may follow the boundary before its line break.
+                    size_t index = 0;
+                    
+                    while ( index < available and ( start[ index ] == ' ' or start[ index ] == '\t' ) )
+                    {
+                        index++;
+                    }
+                    
+                    if ( index + 2 > available )
+                    {
+                        return position;
+                    }
+                    
+                    if ( start[ index ] not_eq '\r' or start[ index + 1 ] not_eq '\n' )
+                    {
+                        throw invalid_argument( "Malformed multipart boundary line." );
+                    }
+                    
+                    position += index + 2;
+                    m_state = HEADERS;
+                }
+                else if ( m_state == HEADERS )
+                {
+                    const Byte* end = static_cast< const Byte* >( memchr( start, '\n', available ) );
+                    
+                    if ( end == nullptr )
+                    {
+                        if ( m_header_length + available > HEADER_LIMIT )
+                        {
+                            throw invalid_argument( "Multipart part headers exceed the permitted length." );
+                        }
+                        
+                        return position;
+                    }
+                    
+                    const size_t line = static_cast< size_t >( end - start );
+                    m_header_length += line + 1;
+                    
+                    if ( line == 0 or start[ line - 1 ] not_eq '\r' or m_header_length > HEADER_LIMIT )
+                    {
+                        throw invalid_argument( "Malformed multipart part headers." );
+                    }
+                    
+                    position += line + 1;
+                    
+                    if ( line == 1 )
+                    {
+                        start_part( );
+                        m_state = BODY;
+                        continue;
+                    }
+                    
+                    const char* text = reinterpret_cast< const char* >( start );
+                    const char* colon = static_cast< const char* >( memchr( text, ':', line - 1 ) );
+                    
+                    if ( colon == nullptr )
+                    {
+                        throw invalid_argument( "Malformed multipart part headers." );
+                    }
+                    
+                    const size_t name = static_cast< size_t >( colon - text );
+                    m_headers.insert( make_pair( trim( text, name ), trim( colon + 1, line - name - 2 ) ) );
+                }
+                else
+                {
+                    return length;
+                }
+            }
+        }
+        
+        void MultipartParserImpl::start_part( void )
+        {
+            m_header_length = 0;
+            
+            if ( not m_spill_directory.empty( ) )
+            {
+                for ( const auto& header : m_headers )
+                {
+                    if ( String::lowercase( header.first ) == "content-disposition" and String::lowercase( header.second ).find( "filename=" ) not_eq string::npos )
+                    {
+                        m_file = shared_ptr< BodyFile >( new BodyFile );
+                        m_file->m_pimpl->open( m_spill_directory, 0 );
+                        break;
+                    }
+                }
+            }
+            
+            if ( m_part_start_handler not_eq nullptr )
+            {
+                m_part_start_handler( m_headers );
+            }
+        }
+        
+        void MultipartParserImpl::write_part( const Byte* data, const size_t length )
+        {
+            if ( length == 0 )
+            {
+                return;
+            }
+            
+            if ( m_file not_eq nullptr )
+            {
+                m_file->m_pimpl->write( data, length );
+            }
+            else if ( m_part_data_handler not_eq nullptr )
+            {
+                m_part_data_handler( Bytes( data, data + length ) );
+            }
+        }
+        
+        void MultipartParserImpl::end_part( void )
+        {
+            auto file = m_file;
+            
+            m_file = nullptr;
+            m_headers.clear( );
+            
+            if ( m_part_end_handler not_eq nullptr )
+            {
+                m_part_end_handler( file );
+            }
+        }
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <map>
+#include <string>
+#include <memory>
+#include <cstddef>
+#include <functional>
+
+//Project Includes
+#include "corvusoft/restbed/byte.hpp"
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    class BodyFile;
+    
+    namespace detail
+    {
+        //Forward Declarations
+        
+        struct MultipartParserImpl
+        {
+            enum State : int
+            {
+                PREAMBLE = 0,
+                BOUNDARY = 1,
+                HEADERS = 2,
+                BODY = 3,
+                EPILOGUE = 4
+            };
+            
+            //Builds the delimiter and its Boyer-Moore-Horspool skip table.
+            void setup( const std::string& boundary );
+            
+            //Returns the number of bytes consumed; the remainder must be presented again with the next chunk.
+            std::size_t process( const Byte* data, const std::size_t length );
+            
+            //Returns the offset of the first complete delimiter, or length when there is none.
+            std::size_t search( const Byte* data, const std::size_t length ) const;
+            
+            //Returns the length of the longest tail of data that could begin a delimiter.
+            std::size_t overlap( const Byte* data, const std::size_t length ) const;
+            
+            void start_part( void );
+            
+            void write_part( const Byte* data, const std::size_t length );
+            
+            void end_part( void );
+            
+            State m_state = PREAMBLE;
+            
+            std::string m_boundary = "";
+            
+            Bytes m_delimiter { };
+            
+            std::size_t m_skip[ 256 ];
+            
+            //Bytes held back from the previous chunk, seeded with CRLF so a leading boundary needs no special case.
+            Bytes m_pending { '\r', '\n' };
+            
+            std::size_t m_header_length = 0;
+            
+            std::multimap< std::string, std::string > m_headers { };
+            
+            std::shared_ptr< BodyFile > m_file = nullptr;
+            
+            std::string m_spill_directory = "";
+            
+            std::function< void ( const std::multimap< std::string, std::string >& ) > m_part_start_handler = nullptr;
+            
+            std::function< void ( const Bytes& ) > m_part_data_handler = nullptr;
+            
+            std::function< void ( const std::shared_ptr< const BodyFile > ) > m_part_end_handler = nullptr;
+        };
+    }
+}
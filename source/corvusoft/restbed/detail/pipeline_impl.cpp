@@ -0,0 +1,139 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <utility>
+#include <ciso646>
+
+//Project Includes
+#include "corvusoft/restbed/detail/socket_impl.hpp"
+#include "corvusoft/restbed/detail/pipeline_impl.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::mutex;
+using std::size_t;
+using std::vector;
+using std::unique_lock;
+using std::shared_ptr;
+using std::error_code;
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    namespace detail
+    {
+        PipelineImpl::PipelineImpl( const shared_ptr< SocketImpl >& socket ) : m_mutex( ),
+            m_socket( socket ),
+            m_next( 0 ),
+            m_issued( 0 ),
+            m_writing( false ),
+            m_entries( ),
+            m_inflight( )
+        {
+            return;
+        }
+        
+        PipelineImpl::~PipelineImpl( void )
+        {
+            return;
+        }
+        
+        size_t PipelineImpl::issue( void )
+        {
+            unique_lock< mutex > lock( m_mutex );
+            return m_issued++;
+        }
+        
+        void PipelineImpl::write( const size_t sequence, const BufferChain& data, const bool final, CallbackImpl< void ( const error_code&, size_t ) > callback )
+        {
+            {
+                unique_lock< mutex > lock( m_mutex );
+                
+                auto& entry = m_entries[ sequence ];
+                entry.m_data.append( data );
+                entry.m_final = final;
+                entry.m_callbacks.push_back( std::move( callback ) );
+            }
+            
+            flush( );
+        }
+        
+        size_t PipelineImpl::get_pending( void ) const
+        {
+            unique_lock< mutex > lock( m_mutex );
+            return m_issued - m_next;
+        }
+        
+        void PipelineImpl::flush( void )
+        {
+            unique_lock< mutex > lock( m_mutex );
+            
+            if ( m_writing )
+            {
+                return;
+            }
+            
+            BufferChain batch;
+            
+            //Coalesce every response that is ready, in order, into a single gathered write.
+            for ( auto entry = m_entries.find( m_next ); entry not_eq m_entries.end( ); entry = m_entries.find( m_next ) )
+            {
+                batch.append( entry->second.m_data );
+                
+                for ( auto& callback : entry->second.m_callbacks )
+                {
+                    m_inflight.push_back( std::move( callback ) );
+                }
+                
+                if ( not entry->second.m_final )
+                {
+                    entry->second.m_data.clear( );
+                    entry->second.m_callbacks.clear( );
+                    break;
+                }
+                
+                m_entries.erase( entry );
+                m_next++;
+            }
+            
+            if ( m_inflight.empty( ) )
+            {
+                return;
+            }
+            
+            m_writing = true;
+            lock.unlock( );
+            
+            auto pipeline = shared_from_this( );
+            
+            m_socket->start_write( batch, [ pipeline ]( const error_code & error, const size_t length )
+            {
+                pipeline->complete( error, length );
+            } );
+        }
+        
+        void PipelineImpl::complete( const error_code& error, const size_t length )
+        {
+            vector< CallbackImpl< void ( const error_code&, size_t ) > > callbacks;
+            
+            {
+                unique_lock< mutex > lock( m_mutex );
+                callbacks.swap( m_inflight );
+                m_writing = false;
+            }
+            
+            for ( auto& callback : callbacks )
+            {
+                callback( error, length );
+            }
+            
+            flush( );
+        }
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <map>
+#include <mutex>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <system_error>
+
+//Project Includes
+#include "corvusoft/restbed/buffer_chain.hpp"
+#include "corvusoft/restbed/detail/callback_impl.hpp"
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    
+    namespace detail
+    {
+        //Forward Declarations
+        class SocketImpl;
+        
+        //Per-connection sequencer for pipelined requests; responses are held until every earlier one is written, then flushed together.
+        class PipelineImpl : public std::enable_shared_from_this< PipelineImpl >
+        {
+            public:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                explicit PipelineImpl( const std::shared_ptr< SocketImpl >& socket );
+                
+                virtual ~PipelineImpl( void );
+                
+                //Functionality
+                std::size_t issue( void );
+                
+                //Queues data for sequence; final marks the end of that response and releases the sequences behind it.
+                void write( const std::size_t sequence, const BufferChain& data, const bool final, CallbackImpl< void ( const std::error_code&, std::size_t ) > callback );
+                
+                //Getters
+                std::size_t get_pending( void ) const;
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+            
+            protected:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                
+                //Functionality
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+            
+            private:
+                //Friends
+                
+                //Definitions
+                struct Entry
+                {
+                    BufferChain m_data { };
+                    
+                    bool m_final = false;
+                    
+                    std::vector< CallbackImpl< void ( const std::error_code&, std::size_t ) > > m_callbacks { };
+                };
+                
+                //Constructors
+                PipelineImpl( const PipelineImpl& original ) = delete;
+                
+                //Functionality
+                void flush( void );
+                
+                void complete( const std::error_code& error, const std::size_t length );
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                PipelineImpl& operator =( const PipelineImpl& value ) = delete;
+                
+                //Properties
+                mutable std::mutex m_mutex;
+                
+                std::shared_ptr< SocketImpl > m_socket;
+                
+                std::size_t m_next;
+                
+                std::size_t m_issued;
+                
+                bool m_writing;
+                
+                std::map< std::size_t, Entry > m_entries;
+                
+                std::vector< CallbackImpl< void ( const std::error_code&, std::size_t ) > > m_inflight;
+        };
+    }
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+//Project Includes
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    
+    namespace detail
+    {
+        //Forward Declarations
+        
+        //Bounded per-thread free list; objects return when their last shared_ptr is released and Recycle accepts them.
+        template< typename Type, Type* ( *Create )( void ), bool ( *Recycle )( Type& ), std::size_t Capacity = 64 >
+        class PoolImpl
+        {
+            public:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                
+                //Functionality
+                static std::shared_ptr< Type > acquire( void )
+                {
+                    Type* value = nullptr;
+                    auto& pool = get_pool( );
+                    
+                    if ( pool.m_values.empty( ) )
+                    {
+                        value = Create( );
+                    }
+                    else
+                    {
+                        value = pool.m_values.back( ).release( );
+                        pool.m_values.pop_back( );
+                    }
+                    
+                    return std::shared_ptr< Type >( value, release );
+                }
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+            
+            protected:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                
+                //Functionality
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+            
+            private:
+                //Friends
+                
+                //Definitions
+                struct Pool
+                {
+                    Pool( void ) : m_values( )
+                    {
+                        m_values.reserve( Capacity );
+                    }
+                    
+                    ~Pool( void )
+                    {
+                        is_destroyed( ) = true;
+                    }
+                    
+                    std::vector< std::unique_ptr< Type > > m_values;
+                };
+                
+                //Constructors
+                PoolImpl( void ) = delete;
+                
+                PoolImpl( const PoolImpl& original ) = delete;
+                
+                virtual ~PoolImpl( void ) = delete;
+                
+                //Functionality
+                static void release( Type* value )
+                {
+                    std::unique_ptr< Type > holder( value );
+                    
+                    if ( is_destroyed( ) )
+                    {
+                        return;
+                    }
+                    
+                    auto& pool = get_pool( );
+                    
+                    if ( pool.m_values.size( ) < Capacity and Recycle( *value ) )
+                    {
+                        pool.m_values.push_back( std::move( holder ) );
+                    }
+                }
+                
+                //Getters
+                static Pool& get_pool( void )
+                {
+                    static thread_local Pool pool;
+                    return pool;
+                }
+                
+                //Trivially destructible, so still readable while the thread's Pool is being torn down.
+                static bool& is_destroyed( void )
+                {
+                    static thread_local bool destroyed = false;
+                    return destroyed;
+                }
+                
+                //Setters
+                
+                //Operators
+                PoolImpl& operator =( const PoolImpl& value ) = delete;
+                
+                //Properties
+        };
+    }
+}
@@ -12,6 +12,8 @@
 
 //Project Includes
 #include <corvusoft/restbed/byte.hpp>
+#include <corvusoft/restbed/buffer_chain.hpp>
+#include "corvusoft/restbed/detail/header_map_impl.hpp"
 
 //External Includes
 #include <asio/streambuf.hpp>
@@ -28,15 +30,19 @@ namespace restbed
     //Forward Declarations
     class Uri;
     class Response;
+    class BodyFile;
     
     namespace detail
     {
         //Forward Declarations
         class SocketImpl;
+        struct Http2StreamImpl;
         
         struct RequestImpl
         {
-            Bytes m_body { };
+            BufferChain m_body { };
+            
+            std::shared_ptr< const BodyFile > m_body_file = nullptr;
             
             uint16_t m_port = 80;
             
@@ -54,7 +60,7 @@ namespace restbed
             
             std::shared_ptr< Response > m_response = nullptr;
             
-            std::multimap< std::string, std::string > m_headers { };
+            HeaderMapImpl m_headers { };
             
             std::map< std::string, std::string > m_path_parameters { };
             
@@ -65,6 +71,9 @@ namespace restbed
             std::shared_ptr< SocketImpl > m_socket = nullptr;
             
             std::shared_ptr< asio::streambuf > m_buffer = nullptr;
+            
+            //Set while the exchange runs over a stream of a pooled HTTP/2 connection, rather than a socket of its own.
+            std::shared_ptr< Http2StreamImpl > m_stream = nullptr;
         };
     }
 }
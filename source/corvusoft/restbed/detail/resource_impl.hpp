@@ -12,6 +12,9 @@
 #include <functional>
 
 //Project Includes
+#include "corvusoft/restbed/detail/filter_impl.hpp"
+#include "corvusoft/restbed/detail/method_impl.hpp"
+#include "corvusoft/restbed/detail/rule_engine_impl.hpp"
 
 //External Includes
 
@@ -33,11 +36,14 @@ namespace restbed
         
         struct ResourceImpl
         {
+            typedef std::pair< std::vector< FilterImpl >, std::function< void ( const std::shared_ptr< Session > ) > > MethodHandler;
+            
+            
             std::set< std::string > m_paths { };
             
-            std::set< std::string > m_methods { };
+            MethodImpl::Set m_methods { };
             
-            std::vector< std::shared_ptr< Rule > > m_rules { };
+            RuleEngineImpl m_rules { };
             
             std::multimap< std::string, std::string > m_default_headers { };
             
@@ -47,7 +53,8 @@ namespace restbed
             
             std::function< void ( const std::shared_ptr< Session >, const std::function< void ( const std::shared_ptr< Session > ) >& ) > m_authentication_handler = nullptr;
             
-            std::multimap< std::string, std::pair< std::multimap< std::string, std::string >, std::function< void ( const std::shared_ptr< Session > ) > > > m_method_handlers { };
+            //Indexed by MethodImpl identifier, handlers are tried in registration order.
+            std::vector< std::vector< MethodHandler > > m_method_handlers { };
         };
     }
 }
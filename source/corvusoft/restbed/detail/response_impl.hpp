@@ -10,7 +10,9 @@
 #include <string>
 
 //Project Includes
+#include "corvusoft/restbed/detail/header_map_impl.hpp"
 #include "corvusoft/restbed/byte.hpp"
+#include "corvusoft/restbed/buffer_chain.hpp"
 
 //External Includes
 
@@ -31,7 +33,7 @@ namespace restbed
         
         struct ResponseImpl
         {
-            Bytes m_body { };
+            BufferChain m_body { };
             
             double m_version = 1.1;
             
@@ -43,7 +45,7 @@ namespace restbed
             
             std::string m_status_message = "";
             
-            std::multimap< std::string, std::string > m_headers { };
+            HeaderMapImpl m_headers { };
         };
     }
 }
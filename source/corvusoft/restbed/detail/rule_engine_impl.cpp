@@ -0,0 +1,115 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <utility>
+#include <ciso646>
+#include <algorithm>
+
+//Project Includes
+#include "corvusoft/restbed/rule.hpp"
+#include "corvusoft/restbed/session.hpp"
+#include "corvusoft/restbed/detail/session_impl.hpp"
+#include "corvusoft/restbed/detail/rule_engine_impl.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::move;
+using std::function;
+using std::shared_ptr;
+using std::upper_bound;
+using std::stable_sort;
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    namespace detail
+    {
+        static bool has_precedence( const shared_ptr< const Rule >& lhs, const shared_ptr< const Rule >& rhs )
+        {
+            return lhs->get_priority( ) < rhs->get_priority( );
+        }
+        
+        RuleEngineImpl::RuleEngineImpl( void ) : m_rules( ),
+            m_resume( nullptr )
+        {
+            m_resume = [ this ]( const shared_ptr< Session > session )
+            {
+                resume( session );
+            };
+        }
+        
+        RuleEngineImpl::~RuleEngineImpl( void )
+        {
+            return;
+        }
+        
+        void RuleEngineImpl::add( const shared_ptr< Rule >& rule )
+        {
+            m_rules.insert( upper_bound( m_rules.begin( ), m_rules.end( ), rule, has_precedence ), rule );
+        }
+        
+        void RuleEngineImpl::sort( void )
+        {
+            stable_sort( m_rules.begin( ), m_rules.end( ), has_precedence );
+        }
+        
+        void RuleEngineImpl::execute( const shared_ptr< Session > session, CallbackImpl< void ( const shared_ptr< Session > ) > callback ) const
+        {
+            auto& state = *session->m_pimpl;
+            state.m_rule_cursor = 0;
+            state.m_rule_state = IDLE;
+            state.m_rule_callback = move( callback );
+            
+            resume( session );
+        }
+        
+        void RuleEngineImpl::resume( const shared_ptr< Session > session ) const
+        {
+            auto& state = *session->m_pimpl;
+            int expected = RUNNING;
+            
+            if ( state.m_rule_state.compare_exchange_strong( expected, RESUMED ) )
+            {
+                return; //Action completed inline, the running loop below continues from the cursor.
+            }
+            
+            state.m_rule_state = RUNNING;
+            
+            while ( true )
+            {
+                while ( state.m_rule_cursor < m_rules.size( ) and not m_rules[ state.m_rule_cursor ]->condition( session ) )
+                {
+                    state.m_rule_cursor++;
+                }
+                
+                if ( state.m_rule_cursor == m_rules.size( ) )
+                {
+                    state.m_rule_state = IDLE;
+                    
+                    const auto callback = move( state.m_rule_callback );
+                    state.m_rule_callback = nullptr;
+                    
+                    return callback( session );
+                }
+                
+                const auto& rule = m_rules[ state.m_rule_cursor++ ];
+                rule->action( session, m_resume );
+                
+                expected = RUNNING;
+                
+                if ( state.m_rule_state.compare_exchange_strong( expected, IDLE ) )
+                {
+                    return; //Action is asynchronous, its callback will re-enter resume.
+                }
+                
+                state.m_rule_state = RUNNING;
+            }
+        }
+    }
+}
@@ -7,9 +7,10 @@
 //System Includes
 #include <vector>
 #include <memory>
-#include <cstddef>
+#include <functional>
 
 //Project Includes
+#include "corvusoft/restbed/detail/callback_impl.hpp"
 
 //External Includes
 
@@ -29,27 +30,79 @@ namespace restbed
     {
         //Forward Declarations
         
-        static void rule_engine( const std::shared_ptr< Session > session,
-                                 const std::vector< std::shared_ptr< Rule > >& rules,
-                                 const std::function< void ( const std::shared_ptr< Session > ) >& callback,
-                                 std::size_t index = 0 )
+        //Rules held in priority order; a session's progress lives in SessionImpl so no per-step state is captured or copied.
+        class RuleEngineImpl
         {
-            while ( index not_eq rules.size( ) )
-            {
-                auto rule = rules.at( index );
-                index++;
+            public:
+                //Friends
                 
-                if ( rule->condition( session ) )
-                {
-                    rule->action( session, bind( rule_engine, session, rules, callback, index ) );
-                    return;
-                }
-            }
+                //Definitions
+                
+                //Constructors
+                RuleEngineImpl( void );
+                
+                virtual ~RuleEngineImpl( void );
+                
+                //Functionality
+                void add( const std::shared_ptr< Rule >& rule );
+                
+                void sort( void );
+                
+                void execute( const std::shared_ptr< Session > session, CallbackImpl< void ( const std::shared_ptr< Session > ) > callback ) const;
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
             
-            if ( index == rules.size( ) )
-            {
-                callback( session );
-            }
-        }
+            protected:
+                //Friends
+                
+                //Definitions
+                
+                //Constructors
+                
+                //Functionality
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                
+                //Properties
+            
+            private:
+                //Friends
+                
+                //Definitions
+                enum State : int
+                {
+                    IDLE = 0,
+                    RUNNING = 1,
+                    RESUMED = 2
+                };
+                
+                //Constructors
+                RuleEngineImpl( const RuleEngineImpl& original ) = delete;
+                
+                //Functionality
+                void resume( const std::shared_ptr< Session > session ) const;
+                
+                //Getters
+                
+                //Setters
+                
+                //Operators
+                RuleEngineImpl& operator =( const RuleEngineImpl& value ) = delete;
+                
+                //Properties
+                std::vector< std::shared_ptr< Rule > > m_rules;
+                
+                std::function< void ( const std::shared_ptr< Session > ) > m_resume;
+        };
     }
 }
@@ -5,11 +5,11 @@
 //System Includes
 #include <regex>
 #include <cstdio>
+#include <cstring>
 #include <sstream>
 #include <utility>
 #include <ciso646>
 #include <cstdlib>
-#include <clocale>
 #include <stdexcept>
 #include <algorithm>
 #include <functional>
@@ -17,6 +17,7 @@
 //Project Includes
 #include "corvusoft/restbed/uri.hpp"
 #include "corvusoft/restbed/rule.hpp"
+#include "corvusoft/restbed/common.hpp"
 #include "corvusoft/restbed/logger.hpp"
 #include "corvusoft/restbed/string.hpp"
 #include "corvusoft/restbed/request.hpp"
@@ -30,6 +31,9 @@
 #include "corvusoft/restbed/detail/request_impl.hpp"
 #include "corvusoft/restbed/detail/service_impl.hpp"
 #include "corvusoft/restbed/detail/session_impl.hpp"
+#include "corvusoft/restbed/detail/pipeline_impl.hpp"
+#include "corvusoft/restbed/detail/http2_stream_impl.hpp"
+#include "corvusoft/restbed/detail/http2_connection_impl.hpp"
 #include "corvusoft/restbed/detail/resource_impl.hpp"
 #include "corvusoft/restbed/detail/rule_engine_impl.hpp"
 #include "corvusoft/restbed/detail/web_socket_manager_impl.hpp"
@@ -39,16 +43,17 @@
 //System Namespaces
 using std::set;
 using std::map;
-using std::free;
 using std::pair;
+using std::vector;
 using std::bind;
 using std::regex;
 using std::string;
 using std::smatch;
 using std::istream;
+using std::search;
+using std::find;
 using std::find_if;
 using std::function;
-using std::setlocale;
 using std::multimap;
 using std::to_string;
 using std::exception;
@@ -62,6 +67,7 @@ using std::placeholders::_2;
 using std::placeholders::_3;
 using std::current_exception;
 using std::rethrow_exception;
+using std::chrono::milliseconds;
 using std::chrono::steady_clock;
 using std::regex_constants::icase;
 
@@ -79,8 +85,47 @@ namespace restbed
 {
     namespace detail
     {
+        static const string HTTP2_PREFACE = "PRI * HTTP/2.0\r\n\r\n";
+        
+        //Decodes the unpadded base64url payload of an HTTP2-Settings header.
+        static Bytes decode_settings( const string& value )
+        {
+            static const string alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+            
+            Bytes settings;
+            uint32_t accumulator = 0;
+            int bits = 0;
+            
+            for ( const auto character : value )
+            {
+                const auto position = alphabet.find( character );
+                
+                if ( position == string::npos )
+                {
+                    if ( character == '=' )
+                    {
+                        break;
+                    }
+                    
+                    throw runtime_error( "Invalid HTTP2-Settings header." );
+                }
+                
+                accumulator = ( accumulator << 6 ) | static_cast< uint32_t >( position );
+                bits += 6;
+                
+                if ( bits >= 8 )
+                {
+                    bits -= 8;
+                    settings.push_back( static_cast< Byte >( accumulator >> bits ) );
+                }
+            }
+            
+            return settings;
+        }
+        
         ServiceImpl::ServiceImpl( void ) : m_uptime( steady_clock::time_point::min( ) ),
             m_logger( nullptr ),
+            m_connection_count( 0 ),
             m_supported_methods( ),
             m_settings( nullptr ),
             m_io_service( make_shared< ::io_service >( ) ),
@@ -104,7 +149,8 @@ namespace restbed
             m_method_not_implemented_handler( nullptr ),
             m_failed_filter_validation_handler( nullptr ),
             m_error_handler( ServiceImpl::default_error_handler ),
-            m_authentication_handler( nullptr )
+            m_authentication_handler( nullptr ),
+            m_trace_handler( nullptr )
         {
             return;
         }
@@ -138,7 +184,7 @@ namespace restbed
                 http_listen( );
                 
                 const auto location = get_http_uri( )->to_string( );
-                log( Logger::INFO, String::format( "Service accepting HTTP connections at '%s'.",  location.data( ) ) );
+                log( Logger::INFO, "Service accepting HTTP connections at '%s'.",  location.data( ) );
 #ifdef BUILD_SSL
             }
             
@@ -172,7 +218,7 @@ namespace restbed
         {
             if ( error )
             {
-                log( Logger::WARNING, String::format( "Failed to process signal '%i', '%s'.", signal_number, error.message( ).data( ) ) );
+                log( Logger::WARNING, "Failed to process signal '%i', '%s'.", signal_number, error.message( ).data( ) );
                 return;
             }
             
@@ -251,6 +297,11 @@ namespace restbed
                 options = ( m_ssl_settings->has_enabled_single_diffie_hellman_use( ) ) ? options | asio::ssl::context::single_dh_use : options;
                 m_ssl_context->set_options( options );
                 
+                if ( m_settings->get_http2_enabled( ) )
+                {
+                    SSL_CTX_set_alpn_select_cb( m_ssl_context->native_handle( ), &ServiceImpl::select_protocol, nullptr );
+                }
+                
                 if ( not m_ssl_settings->get_bind_address( ).empty( ) )
                 {
                     const auto address = address::from_string( m_ssl_settings->get_bind_address( ) );
@@ -267,7 +318,7 @@ namespace restbed
                 https_listen( );
                 
                 const auto location = get_https_uri( )->to_string( );
-                log( Logger::INFO, String::format( "Service accepting HTTPS connections at '%s'.",  location.data( ) ) );
+                log( Logger::INFO, "Service accepting HTTPS connections at '%s'.",  location.data( ) );
             }
         }
         
@@ -285,12 +336,27 @@ namespace restbed
                 {
                     if ( error )
                     {
-                        log( Logger::SECURITY, String::format( "Failed SSL handshake, '%s'.", error.message( ).data( ) ) );
+                        log( Logger::SECURITY, "Failed SSL handshake, '%s'.", error.message( ).data( ) );
                         return;
                     }
                     
+                    if ( m_settings->get_pipeline_limit( ) not_eq 0 )
+                    {
+                        error_code ignored;
+                        socket->lowest_layer( ).set_option( tcp::no_delay( true ), ignored );
+                    }
+                    
                     auto connection = make_shared< SocketImpl >( socket, m_logger );
                     connection->set_timeout( m_settings->get_connection_timeout( ) );
+                    connection->m_connection_id = ++m_connection_count;
+                    connection->m_trace_handler = m_trace_handler;
+                    connection->trace( CONNECTION_ACCEPTED );
+                    
+                    if ( connection->get_application_protocol( ) == "h2" )
+                    {
+                        connection->m_error_handler = m_error_handler;
+                        return create_http2_connection( connection )->start( make_shared< asio::streambuf >( ) );
+                    }
                     
                     m_session_manager->create( [ this, connection ]( const shared_ptr< Session > session )
                     {
@@ -298,10 +364,20 @@ namespace restbed
                         session->m_pimpl->m_manager = m_session_manager;
                         session->m_pimpl->m_web_socket_manager = m_web_socket_manager;
                         session->m_pimpl->m_error_handler = m_error_handler;
-                        session->m_pimpl->m_request = make_shared< Request >( );
+                        session->m_pimpl->m_request = SessionImpl::acquire_request( );
                         session->m_pimpl->m_request->m_pimpl->m_socket = connection;
                         session->m_pimpl->m_request->m_pimpl->m_socket->m_error_handler = m_error_handler;
-                        session->m_pimpl->m_request->m_pimpl->m_buffer = make_shared< asio::streambuf >( );
+                        
+                        if ( session->m_pimpl->m_request->m_pimpl->m_buffer == nullptr )
+                        {
+                            session->m_pimpl->m_request->m_pimpl->m_buffer = make_shared< asio::streambuf >( );
+                        }
+                        
+                        if ( m_settings->get_pipeline_limit( ) not_eq 0 )
+                        {
+                            session->m_pimpl->m_pipeline = make_shared< PipelineImpl >( connection );
+                        }
+                        
                         session->m_pimpl->m_keep_alive_callback = bind( &ServiceImpl::parse_request, this, _1, _2, _3 );
                         session->m_pimpl->m_request->m_pimpl->m_socket->start_read( session->m_pimpl->m_request->m_pimpl->m_buffer, "\r\n\r\n", bind( &ServiceImpl::parse_request, this, _1, _2, session ) );
                     } );
@@ -314,11 +390,23 @@ namespace restbed
                     socket->lowest_layer( ).close( );
                 }
                 
-                log( Logger::WARNING, String::format( "Failed to create session, '%s'.", error.message( ).data( ) ) );
+                log( Logger::WARNING, "Failed to create session, '%s'.", error.message( ).data( ) );
             }
             
             https_listen( );
         }
+        
+        int ServiceImpl::select_protocol( SSL*, const unsigned char** out, unsigned char* out_length, const unsigned char* in, unsigned int in_length, void* )
+        {
+            static const unsigned char protocols[ ] = "\x02h2\x08http/1.1";
+            
+            if ( SSL_select_next_proto( const_cast< unsigned char** >( out ), out_length, protocols, sizeof( protocols ) - 1, in, in_length ) == OPENSSL_NPN_NEGOTIATED )
+            {
+                return SSL_TLSEXT_ERR_OK;
+            }
+            
+            return SSL_TLSEXT_ERR_NOACK;
+        }
 #endif
         
         string ServiceImpl::sanitise_path( const string& path ) const
@@ -359,10 +447,10 @@ namespace restbed
         
         void ServiceImpl::not_found( const shared_ptr< Session > session ) const
         {
-            log( Logger::INFO, String::format( "'%s' resource route not found '%s'.",
-                                               session->get_origin( ).data( ),
-                                               session->get_request( )->get_path( ).data( ) ) );
-                                               
+            log( Logger::INFO, "'%s' resource route not found '%s'.",
+                 session->get_origin( ).data( ),
+                 session->get_request( )->get_path( ).data( ) );
+            
             if ( m_not_found_handler not_eq nullptr )
             {
                 m_not_found_handler( session );
@@ -391,28 +479,21 @@ namespace restbed
             return true;
         }
         
-        void ServiceImpl::log( const Logger::Level level, const string& message ) const
+        void ServiceImpl::trace( const TraceEvent event, const shared_ptr< Session >& session ) const
         {
-            if ( m_logger not_eq nullptr )
+            if ( m_trace_handler not_eq nullptr )
             {
-                try
-                {
-                    m_logger->log( level, "%s", message.data( ) );
-                }
-                catch ( ... )
-                {
-                    fprintf( stderr, "Failed to create log entry: %s", message.data( ) );
-                }
+                session->m_pimpl->m_request->m_pimpl->m_socket->trace( event );
             }
         }
         
         void ServiceImpl::method_not_allowed( const shared_ptr< Session > session ) const
         {
-            log( Logger::INFO, String::format( "'%s' '%s' method not allowed '%s'.",
-                                               session->get_origin( ).data( ),
-                                               session->get_request( )->get_method( ).data( ),
-                                               session->get_request( )->get_path( ).data( ) ) );
-                                               
+            log( Logger::INFO, "'%s' '%s' method not allowed '%s'.",
+                 session->get_origin( ).data( ),
+                 session->get_request( )->get_method( ).data( ),
+                 session->get_request( )->get_path( ).data( ) );
+            
             if ( m_method_not_allowed_handler not_eq nullptr )
             {
                 m_method_not_allowed_handler( session );
@@ -425,11 +506,11 @@ namespace restbed
         
         void ServiceImpl::method_not_implemented( const shared_ptr< Session > session ) const
         {
-            log( Logger::INFO, String::format( "'%s' '%s' method not implemented '%s'.",
-                                               session->get_origin( ).data( ),
-                                               session->get_request( )->get_method( ).data( ),
-                                               session->get_request( )->get_path( ).data( ) ) );
-                                               
+            log( Logger::INFO, "'%s' '%s' method not implemented '%s'.",
+                 session->get_origin( ).data( ),
+                 session->get_request( )->get_method( ).data( ),
+                 session->get_request( )->get_path( ).data( ) );
+            
             if ( m_method_not_implemented_handler not_eq nullptr )
             {
                 m_method_not_implemented_handler( session );
@@ -442,10 +523,10 @@ namespace restbed
         
         void ServiceImpl::failed_filter_validation( const shared_ptr< Session > session ) const
         {
-            log( Logger::INFO, String::format( "'%s' failed filter validation '%s'.",
-                                               session->get_origin( ).data( ),
-                                               session->get_request( )->get_path( ).data( ) ) );
-                                               
+            log( Logger::INFO, "'%s' failed filter validation '%s'.",
+                 session->get_origin( ).data( ),
+                 session->get_request( )->get_path( ).data( ) );
+            
             if ( m_failed_filter_validation_handler not_eq nullptr )
             {
                 m_failed_filter_validation_handler( session );
@@ -458,17 +539,20 @@ namespace restbed
         
         void ServiceImpl::router( const shared_ptr< Session > session ) const
         {
-            log( Logger::INFO, String::format( "Incoming '%s' request from '%s' for route '%s'.",
-                                               session->get_request( )->get_method( ).data( ),
-                                               session->get_origin( ).data( ),
-                                               session->get_request( )->get_path( ).data( ) ) );
-                                               
+            if ( m_logger not_eq nullptr and m_logger->is_enabled( Logger::INFO ) )
+            {
+                log( Logger::INFO, "Incoming '%s' request from '%s' for route '%s'.",
+                     session->get_request( )->get_method( ).data( ),
+                     session->get_origin( ).data( ),
+                     session->get_request( )->get_path( ).data( ) );
+            }
+            
             if ( session->is_closed( ) )
             {
                 return;
             }
             
-            rule_engine( session, m_rules, [ this ]( const shared_ptr< Session > session )
+            m_rules.execute( session, [ this ]( const shared_ptr< Session > session )
             {
                 const auto resource_route = find_if( m_resource_routes.begin( ), m_resource_routes.end( ), bind( &ServiceImpl::resource_router, this, session, _1 ) );
                 
@@ -479,24 +563,28 @@ namespace restbed
                 
                 const auto path = resource_route->first;
                 session->m_pimpl->m_resource = resource_route->second;
+                trace( ROUTE_RESOLVED, session );
                 const auto request = session->get_request( );
                 extract_path_parameters( path, request );
                 
                 const auto callback = [ this ]( const shared_ptr< Session > session )
                 {
-                    rule_engine( session, session->m_pimpl->m_resource->m_pimpl->m_rules, [ this ]( const shared_ptr< Session > session )
+                    session->m_pimpl->m_resource->m_pimpl->m_rules.execute( session, [ this ]( const shared_ptr< Session > session )
                     {
                         if ( session->is_closed( ) )
                         {
                             return;
                         }
                         
+                        trace( RULES_COMPLETED, session );
+                        
                         const auto request = session->get_request( );
-                        auto method_handler = find_method_handler( session );
+                        const auto method = MethodImpl::find( request->get_method( ) );
+                        auto method_handler = find_method_handler( method, session );
                         
                         if ( method_handler == nullptr )
                         {
-                            if ( m_supported_methods.count( request->get_method( ) ) == 0 )
+                            if ( method == MethodImpl::UNKNOWN or not m_supported_methods.test( static_cast< size_t >( method ) ) )
                             {
                                 method_handler = bind( &ServiceImpl::method_not_implemented, this, _1 );
                             }
@@ -506,7 +594,9 @@ namespace restbed
                             }
                         }
                         
+                        trace( HANDLER_STARTED, session );
                         method_handler( session );
+                        trace( HANDLER_FINISHED, session );
                     } );
                 };
                 
@@ -525,8 +615,18 @@ namespace restbed
         {
             if ( not error )
             {
+                //Responses already leave as single gathered writes, so Nagle only delays them behind the client's delayed acknowledgement.
+                if ( m_settings->get_pipeline_limit( ) not_eq 0 )
+                {
+                    error_code ignored;
+                    socket->set_option( tcp::no_delay( true ), ignored );
+                }
+                
                 auto connection = make_shared< SocketImpl >( socket, m_logger );
                 connection->set_timeout( m_settings->get_connection_timeout( ) );
+                connection->m_connection_id = ++m_connection_count;
+                connection->m_trace_handler = m_trace_handler;
+                connection->trace( CONNECTION_ACCEPTED );
                 
                 m_session_manager->create( [ this, connection ]( const shared_ptr< Session > session )
                 {
@@ -534,10 +634,20 @@ namespace restbed
                     session->m_pimpl->m_manager = m_session_manager;
                     session->m_pimpl->m_web_socket_manager = m_web_socket_manager;
                     session->m_pimpl->m_error_handler = m_error_handler;
-                    session->m_pimpl->m_request = make_shared< Request >( );
+                    session->m_pimpl->m_request = SessionImpl::acquire_request( );
                     session->m_pimpl->m_request->m_pimpl->m_socket = connection;
                     session->m_pimpl->m_request->m_pimpl->m_socket->m_error_handler = m_error_handler;
-                    session->m_pimpl->m_request->m_pimpl->m_buffer = make_shared< asio::streambuf >( );
+                    
+                    if ( session->m_pimpl->m_request->m_pimpl->m_buffer == nullptr )
+                    {
+                        session->m_pimpl->m_request->m_pimpl->m_buffer = make_shared< asio::streambuf >( );
+                    }
+                    
+                    if ( m_settings->get_pipeline_limit( ) not_eq 0 )
+                    {
+                        session->m_pimpl->m_pipeline = make_shared< PipelineImpl >( connection );
+                    }
+                    
                     session->m_pimpl->m_keep_alive_callback = bind( &ServiceImpl::parse_request, this, _1, _2, _3 );
                     session->m_pimpl->m_request->m_pimpl->m_socket->start_read( session->m_pimpl->m_request->m_pimpl->m_buffer, "\r\n\r\n", bind( &ServiceImpl::parse_request, this, _1, _2, session ) );
                 } );
@@ -549,7 +659,7 @@ namespace restbed
                     socket->close( );
                 }
                 
-                log( Logger::WARNING, String::format( "Failed to create session, '%s'.", error.message( ).data( ) ) );
+                log( Logger::WARNING, "Failed to create session, '%s'.", error.message( ).data( ) );
             }
             
             http_listen( );
@@ -575,28 +685,31 @@ namespace restbed
             }
         }
         
-        function< void ( const shared_ptr< Session > ) > ServiceImpl::find_method_handler( const shared_ptr< Session > session ) const
+        function< void ( const shared_ptr< Session > ) > ServiceImpl::find_method_handler( const int method, const shared_ptr< Session > session ) const
         {
             const auto request = session->get_request( );
             const auto resource = session->get_resource( );
-            const auto method_handlers = resource->m_pimpl->m_method_handlers.equal_range( request->get_method( ) );
+            const auto& method_handlers = resource->m_pimpl->m_method_handlers;
+            
+            if ( method == MethodImpl::UNKNOWN or static_cast< size_t >( method ) >= method_handlers.size( ) )
+            {
+                return nullptr;
+            }
             
             bool failed_filter_validation = false;
             function< void ( const shared_ptr< Session > ) > method_handler = nullptr;
             
-            for ( auto handler = method_handlers.first; handler not_eq method_handlers.second and method_handler == nullptr; handler++ )
+            for ( auto handler = method_handlers[ method ].begin( ); handler not_eq method_handlers[ method ].end( ) and method_handler == nullptr; handler++ )
             {
-                method_handler = handler->second.second;
+                method_handler = handler->second;
                 
-                for ( const auto& filter : handler->second.first )
+                for ( const auto& filter : handler->first )
                 {
-                    for ( const auto& header : request->get_headers( filter.first ) )
+                    if ( not filter.is_satisfied( request->m_pimpl->m_headers ) )
                     {
-                        if ( not regex_match( header.second, regex( filter.second ) ) )
-                        {
-                            method_handler = nullptr;
-                            failed_filter_validation = true;
-                        }
+                        method_handler = nullptr;
+                        failed_filter_validation = true;
+                        break;
                     }
                 }
             }
@@ -707,11 +820,11 @@ namespace restbed
             };
         }
         
-        const multimap< string, string > ServiceImpl::parse_request_headers( istream& stream )
+        void ServiceImpl::parse_request_headers( istream& stream, HeaderMapImpl& headers )
         {
             smatch matches;
             string data = "";
-            multimap< string, string > headers;
+            headers.clear( );
             static const regex pattern( "^([^:.]*): *(.*)\\s*$" );
             
             while ( getline( stream, data ) and data not_eq "\r" )
@@ -721,16 +834,221 @@ namespace restbed
                     throw runtime_error( "Your client has issued a malformed or illegal request header. That’s all we know." );
                 }
                 
-                headers.insert( make_pair( matches[ 1 ].str( ), matches[ 2 ].str( ) ) );
+                headers.add( matches[ 1 ].str( ), matches[ 2 ].str( ) );
+            }
+        }
+        
+        void ServiceImpl::pipeline_request( const shared_ptr< Session >& session ) const
+        {
+            const auto pipeline = session->m_pimpl->m_pipeline;
+            
+            if ( pipeline == nullptr or pipeline->get_pending( ) >= m_settings->get_pipeline_limit( ) or session->m_pimpl->is_final_request( ) )
+            {
+                return;
+            }
+            
+            //Only requests without a body can be stepped over; anything else leaves the connection to its own session.
+            const auto request = session->m_pimpl->m_request;
+            
+            if ( request->get_header( "Content-Length", 0 ) not_eq 0 or request->has_header( "Transfer-Encoding" ) or request->has_header( "Upgrade" ) or String::lowercase( request->get_header( "Connection" ) ) == "close" )
+            {
+                return;
+            }
+            
+            static const string terminator = "\r\n\r\n";
+            
+            const auto buffer = request->m_pimpl->m_buffer;
+            const char* data = asio::buffer_cast< const char* >( buffer->data( ) );
+            const char* end = data + buffer->size( );
+            
+            if ( search( data, end, terminator.begin( ), terminator.end( ) ) == end )
+            {
+                return;
+            }
+            
+            const auto connection = request->m_pimpl->m_socket;
+            
+            request->m_pimpl->m_buffer = make_shared< asio::streambuf >( );
+            session->m_pimpl->m_keep_alive_callback = nullptr;
+            
+            m_session_manager->create( [ this, connection, buffer, pipeline ]( const shared_ptr< Session > next )
+            {
+                next->m_pimpl->m_settings = m_settings;
+                next->m_pimpl->m_manager = m_session_manager;
+                next->m_pimpl->m_web_socket_manager = m_web_socket_manager;
+                next->m_pimpl->m_error_handler = m_error_handler;
+                next->m_pimpl->m_request = SessionImpl::acquire_request( );
+                next->m_pimpl->m_request->m_pimpl->m_socket = connection;
+                next->m_pimpl->m_request->m_pimpl->m_buffer = buffer;
+                next->m_pimpl->m_pipeline = pipeline;
+                next->m_pimpl->m_keep_alive_callback = bind( &ServiceImpl::parse_request, this, _1, _2, _3 );
+                
+                m_io_service->post( bind( &ServiceImpl::parse_request, this, error_code( ), 0, next ) );
+            } );
+        }
+        
+        bool ServiceImpl::upgrade_request( const shared_ptr< Session >& session, const string& path ) const
+        {
+            const auto request = session->m_pimpl->m_request;
+            const auto socket = request->m_pimpl->m_socket;
+            const auto& headers = request->m_pimpl->m_headers;
+            
+            if ( not m_settings->get_http2_enabled( ) or socket->is_secure( ) or socket->m_request_id not_eq 1 )
+            {
+                return false;
+            }
+            
+            const auto upgrade = headers.find( "Upgrade" );
+            const auto settings = headers.find( "HTTP2-Settings" );
+            
+            if ( upgrade == nullptr or settings == nullptr or headers.contains( "Transfer-Encoding" ) or request->get_header( "Content-Length", 0 ) not_eq 0 )
+            {
+                return false;
+            }
+            
+            const auto protocols = String::split( String::lowercase( String::remove( " ", *upgrade ) ), ',' );
+            
+            if ( find( protocols.begin( ), protocols.end( ), "h2c" ) == protocols.end( ) )
+            {
+                return false;
+            }
+            
+            Http2ConnectionImpl::HeaderList fields;
+            fields.emplace_back( ":method", request->m_pimpl->m_method );
+            fields.emplace_back( ":scheme", "http" );
+            fields.emplace_back( ":path", path );
+            
+            const auto host = headers.find( "Host" );
+            
+            if ( host not_eq nullptr )
+            {
+                fields.emplace_back( ":authority", *host );
+            }
+            
+            for ( const auto& entry : headers.get_entries( ) )
+            {
+                const auto name = String::lowercase( entry.name );
+                
+                if ( name == "host" or name == "http2-settings" or name == "te" or name == "connection" or name == "keep-alive" or name == "proxy-connection" or name == "transfer-encoding" or name == "upgrade" )
+                {
+                    continue;
+                }
+                
+                fields.emplace_back( name, entry.value );
             }
             
-            return headers;
+            const auto parameters = decode_settings( *settings );
+            const auto buffer = request->m_pimpl->m_buffer;
+            request->m_pimpl->m_buffer = nullptr;
+            session->m_pimpl->m_keep_alive_callback = nullptr;
+            
+            socket->start_write( String::to_bytes( "HTTP/1.1 101 Switching Protocols\r\nConnection: Upgrade\r\nUpgrade: h2c\r\n\r\n" ), [ this, socket, buffer, parameters, fields ]( const error_code & error, size_t )
+            {
+                if ( error )
+                {
+                    return socket->close( );
+                }
+                
+                auto connection = create_http2_connection( socket );
+                connection->upgrade( parameters, fields );
+                connection->start( buffer );
+            } );
+            
+            return true;
+        }
+        
+        shared_ptr< Http2ConnectionImpl > ServiceImpl::create_http2_connection( const shared_ptr< SocketImpl >& socket ) const
+        {
+            auto connection = make_shared< Http2ConnectionImpl >( socket, m_settings );
+            connection->set_request_handler( bind( &ServiceImpl::create_stream_session, this, socket, _1 ) );
+            
+            return connection;
+        }
+        
+        void ServiceImpl::create_stream_session( const shared_ptr< SocketImpl >& socket, const shared_ptr< Http2StreamImpl > stream ) const
+        {
+            m_session_manager->create( [ this, socket, stream ]( const shared_ptr< Session > session )
+            {
+                session->m_pimpl->m_settings = m_settings;
+                session->m_pimpl->m_manager = m_session_manager;
+                session->m_pimpl->m_web_socket_manager = m_web_socket_manager;
+                session->m_pimpl->m_error_handler = m_error_handler;
+                session->m_pimpl->m_request = SessionImpl::acquire_request( );
+                session->m_pimpl->m_stream = stream;
+                
+                auto& request = *session->m_pimpl->m_request->m_pimpl;
+                request.m_socket = socket;
+                request.m_buffer = stream->m_buffer;
+                request.m_version = 2.0;
+                
+                socket->m_request_id++;
+                trace( HEADERS_RECEIVED, session );
+                
+                try
+                {
+                    string path = "/";
+                    string authority = "";
+                    
+                    for ( const auto& header : stream->m_headers )
+                    {
+                        if ( header.first == ":method" )
+                        {
+                            request.m_method = header.second;
+                        }
+                        else if ( header.first == ":path" )
+                        {
+                            path = header.second;
+                        }
+                        else if ( header.first == ":authority" )
+                        {
+                            authority = header.second;
+                        }
+                        else if ( header.first[ 0 ] not_eq ':' )
+                        {
+                            request.m_headers.add( header.first, header.second );
+                        }
+                    }
+                    
+                    if ( not authority.empty( ) and not request.m_headers.contains( "Host" ) )
+                    {
+                        request.m_headers.add( "Host", authority );
+                    }
+                    
+                    const auto uri = Uri::parse( "http://localhost" + path );
+                    request.m_path = Uri::decode( uri.get_path( ) );
+                    request.m_query_parameters = uri.get_query_parameters( );
+                    
+                    trace( REQUEST_PARSED, session );
+                    authenticate( session );
+                }
+                catch ( const exception& ex )
+                {
+                    const auto error_handler = get_error_handler( session );
+                    error_handler( 400, ex, session );
+                }
+            } );
         }
         
         void ServiceImpl::parse_request( const error_code& error, size_t, const shared_ptr< Session > session ) const
         {
             istream stream( session->m_pimpl->m_request->m_pimpl->m_buffer.get( ) );
             
+            const auto buffer = session->m_pimpl->m_request->m_pimpl->m_buffer;
+            
+            //A client with prior knowledge opens with the HTTP/2 preface, whose first line reads like a request.
+            if ( not error and m_settings->get_http2_enabled( ) and buffer->size( ) >= HTTP2_PREFACE.length( ) and memcmp( asio::buffer_cast< const char* >( buffer->data( ) ), HTTP2_PREFACE.data( ), HTTP2_PREFACE.length( ) ) == 0 )
+            {
+                session->m_pimpl->m_request->m_pimpl->m_buffer = nullptr;
+                session->m_pimpl->m_keep_alive_callback = nullptr;
+                
+                return create_http2_connection( session->m_pimpl->m_request->m_pimpl->m_socket )->start( buffer );
+            }
+            
+            if ( session->m_pimpl->m_pipeline not_eq nullptr )
+            {
+                session->m_pimpl->m_sequence = session->m_pimpl->m_pipeline->issue( );
+            }
+            
             if ( error )
             {
                 discard_request( stream );
@@ -738,6 +1056,15 @@ namespace restbed
                 return error_handler( 400, runtime_error( error.message( ) ), session );
             }
             
+            session->m_pimpl->m_request->m_pimpl->m_socket->m_request_id++;
+            trace( HEADERS_RECEIVED, session );
+            
+            //The idle allowance between keep-alive requests gives way to the usual timeout once a request has begun.
+            if ( m_settings->get_keep_alive_timeout( ) not_eq milliseconds::zero( ) )
+            {
+                session->m_pimpl->m_request->m_pimpl->m_socket->set_timeout( m_settings->get_connection_timeout( ) );
+            }
+            
             try
             {
                 const auto items = parse_request_line( stream );
@@ -745,15 +1072,19 @@ namespace restbed
                 
                 session->m_pimpl->m_request->m_pimpl->m_path = Uri::decode( uri.get_path( ) );
                 session->m_pimpl->m_request->m_pimpl->m_method = items.at( "method" );
-                session->m_pimpl->m_request->m_pimpl->m_headers = parse_request_headers( stream );
+                parse_request_headers( stream, session->m_pimpl->m_request->m_pimpl->m_headers );
                 session->m_pimpl->m_request->m_pimpl->m_query_parameters = uri.get_query_parameters( );
                 
-                char* locale = strdup( setlocale( LC_NUMERIC, nullptr ) );
-                setlocale( LC_NUMERIC, "C" );
-                session->m_pimpl->m_request->m_pimpl->m_version = stod( items.at( "version" ) );
-                setlocale( LC_NUMERIC, locale );
-                free( locale );
+                Common::parse( items.at( "version" ), session->m_pimpl->m_request->m_pimpl->m_version );
+                
+                trace( REQUEST_PARSED, session );
+                
+                if ( upgrade_request( session, items.at( "path" ) ) )
+                {
+                    return;
+                }
                 
+                pipeline_request( session );
                 authenticate( session );
             }
             catch ( const int status_code )
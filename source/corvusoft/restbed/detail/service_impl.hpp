@@ -7,16 +7,23 @@
 //System Includes
 #include <set>
 #include <map>
+#include <cstdio>
+#include <atomic>
 #include <chrono>
 #include <thread>
 #include <memory>
 #include <string>
 #include <vector>
+#include <cstdint>
 #include <stdexcept>
 #include <functional>
 #include <system_error>
 
 //Project Includes
+#include "corvusoft/restbed/logger.hpp"
+#include "corvusoft/restbed/trace_event.hpp"
+#include "corvusoft/restbed/detail/method_impl.hpp"
+#include "corvusoft/restbed/detail/rule_engine_impl.hpp"
 
 //External Includes
 #include <asio/ip/tcp.hpp>
@@ -38,7 +45,6 @@ namespace restbed
     //Forward Declarations
     class Uri;
     class Rule;
-    class Logger;
     class Session;
     class Resource;
     class Settings;
@@ -48,6 +54,10 @@ namespace restbed
     namespace detail
     {
         //Forward Declarations
+        class SocketImpl;
+        class HeaderMapImpl;
+        struct Http2StreamImpl;
+        class Http2ConnectionImpl;
         class WebSocketManagerImpl;
         
         class ServiceImpl
@@ -72,6 +82,9 @@ namespace restbed
                 void https_listen( void ) const;
                 
                 void create_ssl_session( const std::shared_ptr< asio::ssl::stream< asio::ip::tcp::socket > >& socket, const std::error_code& error ) const;
+                
+                //ALPN selection callback; prefers "h2" over "http/1.1" when the client offers both.
+                static int select_protocol( SSL* ssl, const unsigned char** out, unsigned char* out_length, const unsigned char* in, unsigned int in_length, void* argument );
 #endif
                 void setup_signal_handler( );
                 
@@ -83,7 +96,25 @@ namespace restbed
                 
                 bool has_unique_paths( const std::set< std::string >& paths ) const;
                 
-                void log( const Logger::Level level, const std::string& message ) const;
+                template< typename... Arguments >
+                void log( const Logger::Level level, const char* format, const Arguments... arguments ) const
+                {
+                    if ( m_logger == nullptr or not m_logger->is_enabled( level ) )
+                    {
+                        return;
+                    }
+                    
+                    try
+                    {
+                        m_logger->log( level, format, arguments... );
+                    }
+                    catch ( ... )
+                    {
+                        fprintf( stderr, "Failed to create log entry: %s", format );
+                    }
+                }
+                
+                void trace( const TraceEvent event, const std::shared_ptr< Session >& session ) const;
                 
                 void method_not_allowed( const std::shared_ptr< Session > session ) const;
                 
@@ -97,7 +128,7 @@ namespace restbed
                 
                 void extract_path_parameters( const std::string& sanitised_path, const std::shared_ptr< const Request >& request ) const;
                 
-                std::function< void ( const std::shared_ptr< Session > ) > find_method_handler( const std::shared_ptr< Session > session ) const;
+                std::function< void ( const std::shared_ptr< Session > ) > find_method_handler( const int method, const std::shared_ptr< Session > session ) const;
                 
                 void authenticate( const std::shared_ptr< Session > session ) const;
                 
@@ -109,10 +140,21 @@ namespace restbed
                 
                 static const std::map< std::string, std::string > parse_request_line( std::istream& stream );
                 
-                static const std::multimap< std::string, std::string > parse_request_headers( std::istream& stream );
+                static void parse_request_headers( std::istream& stream, HeaderMapImpl& headers );
                 
                 void parse_request( const std::error_code& error, std::size_t length, const std::shared_ptr< Session > session ) const;
                 
+                //Switches a cleartext connection to HTTP/2 when the request carries "Upgrade: h2c"; the request is then answered on stream one.
+                bool upgrade_request( const std::shared_ptr< Session >& session, const std::string& path ) const;
+                
+                std::shared_ptr< Http2ConnectionImpl > create_http2_connection( const std::shared_ptr< SocketImpl >& socket ) const;
+                
+                //Creates a session for a request received on an HTTP/2 stream and routes it like any other.
+                void create_stream_session( const std::shared_ptr< SocketImpl >& socket, const std::shared_ptr< Http2StreamImpl > stream ) const;
+                
+                //Hands the connection buffer to a new session when it already holds the next request, so both are dispatched concurrently.
+                void pipeline_request( const std::shared_ptr< Session >& session ) const;
+                
                 //Getters
                 const std::shared_ptr< const Uri > get_http_uri( void ) const;
                 
@@ -129,7 +171,9 @@ namespace restbed
                 
                 std::shared_ptr< Logger > m_logger;
                 
-                std::set< std::string > m_supported_methods;
+                mutable std::atomic< std::uint64_t > m_connection_count;
+                
+                MethodImpl::Set m_supported_methods;
                 
                 std::shared_ptr< const Settings > m_settings;
                 
@@ -141,7 +185,7 @@ namespace restbed
                 
                 std::shared_ptr< WebSocketManagerImpl > m_web_socket_manager;
                 
-                std::vector< std::shared_ptr< Rule > > m_rules;
+                RuleEngineImpl m_rules;
                 
                 std::vector< std::shared_ptr< std::thread > > m_workers;
 #ifdef BUILD_SSL
@@ -173,6 +217,8 @@ namespace restbed
                 
                 std::function< void ( const std::shared_ptr< Session >, const std::function< void ( const std::shared_ptr< Session > ) >& ) > m_authentication_handler;
                 
+                std::function< void ( const TraceEvent, const std::uint64_t, const std::uint64_t, const std::chrono::steady_clock::time_point& ) > m_trace_handler;
+            
             protected:
                 //Friends
                 
@@ -5,6 +5,7 @@
 //System Includes
 #include <regex>
 #include <utility>
+#include <algorithm>
 #include <ciso646>
 #include <stdexcept>
 #include <system_error>
@@ -18,16 +19,25 @@
 #include "corvusoft/restbed/response.hpp"
 #include "corvusoft/restbed/resource.hpp"
 #include "corvusoft/restbed/settings.hpp"
+#include "corvusoft/restbed/body_file.hpp"
+#include "corvusoft/restbed/buffer_chain.hpp"
 #include "corvusoft/restbed/context_value.hpp"
 #include "corvusoft/restbed/session_manager.hpp"
 #include "corvusoft/restbed/detail/socket_impl.hpp"
+#include "corvusoft/restbed/detail/body_file_impl.hpp"
+#include "corvusoft/restbed/detail/pipeline_impl.hpp"
 #include "corvusoft/restbed/detail/request_impl.hpp"
+#include "corvusoft/restbed/detail/http2_stream_impl.hpp"
+#include "corvusoft/restbed/detail/http2_connection_impl.hpp"
+#include "corvusoft/restbed/detail/pool_impl.hpp"
 #include "corvusoft/restbed/detail/session_impl.hpp"
 #include "corvusoft/restbed/detail/resource_impl.hpp"
+#include "corvusoft/restbed/detail/response_impl.hpp"
 
 //External Includes
 
 //System Namespaces
+using std::min;
 using std::map;
 using std::set;
 using std::regex;
@@ -47,6 +57,8 @@ using std::make_shared;
 using std::regex_match;
 using std::regex_error;
 using std::runtime_error;
+using std::invalid_argument;
+using std::size_t;
 using std::placeholders::_1;
 using std::rethrow_exception;
 using std::current_exception;
@@ -73,6 +85,12 @@ namespace restbed
             m_context( ),
             m_error_handler( nullptr ),
             m_keep_alive_callback( nullptr ),
+            m_rule_cursor( 0 ),
+            m_rule_state( 0 ),
+            m_rule_callback( nullptr ),
+            m_pipeline( nullptr ),
+            m_sequence( 0 ),
+            m_stream( nullptr ),
             m_error_handler_invoked( false )
         {
             return;
@@ -89,16 +107,7 @@ namespace restbed
             const auto data = Bytes( data_ptr, data_ptr + length );
             session->m_pimpl->m_request->m_pimpl->m_buffer->consume( length );
             
-            auto& body = m_request->m_pimpl->m_body;
-            
-            if ( body.empty( ) )
-            {
-                body = data;
-            }
-            else
-            {
-                body.insert( body.end( ), data.begin( ), data.end( ) );
-            }
+            m_request->m_pimpl->m_body.append( data );
 
             try
             {
@@ -153,7 +162,31 @@ namespace restbed
             }
         }
         
-        void SessionImpl::transmit( const Response& response, const function< void ( const error_code&, size_t ) >& callback ) const
+        void SessionImpl::spill_body( const size_t length, const shared_ptr< Session > session, const function< void ( const shared_ptr< Session >, const Bytes& ) >& callback )
+        {
+            auto file = shared_ptr< BodyFile >( new BodyFile );
+            
+            try
+            {
+                file->m_pimpl->open( m_settings->get_body_spill_directory( ), length );
+            }
+            catch ( const exception& ex )
+            {
+                return get_error_handler( )( 500, ex, session );
+            }
+            
+            stream_body( length, session, [ file ]( const Byte * data, const size_t size )
+            {
+                file->m_pimpl->write( data, size );
+            },
+            [ this, file, callback ]( const shared_ptr< Session > session )
+            {
+                m_request->m_pimpl->m_body_file = file;
+                fetch_body( 0, session, callback );
+            } );
+        }
+        
+        void SessionImpl::transmit( const Response& response, const bool final, CallbackImpl< void ( const error_code&, size_t ) > callback ) const
         {
             auto hdrs = m_settings->get_default_headers( );
             
@@ -168,9 +201,14 @@ namespace restbed
             auto response_headers = response.get_headers( );
             hdrs.insert( response_headers.begin( ), response_headers.end( ) );
             
+            if ( final and is_final_request( ) )
+            {
+                hdrs.erase( "Connection" );
+                hdrs.insert( make_pair( "Connection", "close" ) );
+            }
+            
             auto payload = make_shared< Response >( );
             payload->set_headers( hdrs );
-            payload->set_body( response.get_body( ) );
             payload->set_version( response.get_version( ) );
             payload->set_protocol( response.get_protocol( ) );
             payload->set_status_code( response.get_status_code( ) );
@@ -181,7 +219,113 @@ namespace restbed
                 payload->set_status_message( m_settings->get_status_message( payload->get_status_code( ) ) );
             }
             
-            m_request->m_pimpl->m_socket->start_write( Http::to_bytes( payload ), callback );
+            if ( m_stream not_eq nullptr )
+            {
+                return m_stream->m_connection->write( m_stream, payload->get_status_code( ), hdrs, response.m_pimpl->m_body, final, std::move( callback ) );
+            }
+            
+            BufferChain buffers( Http::to_bytes( payload ) );
+            buffers.append( response.m_pimpl->m_body );
+            
+            if ( m_pipeline not_eq nullptr )
+            {
+                return m_pipeline->write( m_sequence, buffers, final, std::move( callback ) );
+            }
+            
+            m_request->m_pimpl->m_socket->start_write( buffers, std::move( callback ) );
+        }
+        
+        void SessionImpl::read( const size_t length, CallbackImpl< void ( const error_code&, size_t ) > callback ) const
+        {
+            if ( m_stream not_eq nullptr )
+            {
+                return m_stream->m_connection->read( m_stream, length, std::move( callback ) );
+            }
+            
+            m_request->m_pimpl->m_socket->start_read( m_request->m_pimpl->m_buffer, length, std::move( callback ) );
+        }
+        
+        void SessionImpl::read( const string& delimiter, CallbackImpl< void ( const error_code&, size_t ) > callback ) const
+        {
+            if ( m_stream not_eq nullptr )
+            {
+                return m_stream->m_connection->read( m_stream, delimiter, std::move( callback ) );
+            }
+            
+            m_request->m_pimpl->m_socket->start_read( m_request->m_pimpl->m_buffer, delimiter, std::move( callback ) );
+        }
+        
+        void SessionImpl::write( const BufferChain& data, const bool final, CallbackImpl< void ( const error_code&, size_t ) > callback ) const
+        {
+            if ( m_stream not_eq nullptr )
+            {
+                return m_stream->m_connection->write( m_stream, data, final, std::move( callback ) );
+            }
+            
+            m_request->m_pimpl->m_socket->start_write( data, std::move( callback ) );
+        }
+        
+        void SessionImpl::disconnect( void ) const
+        {
+            if ( m_stream not_eq nullptr )
+            {
+                return m_stream->m_connection->reset( m_stream );
+            }
+            
+            m_request->m_pimpl->m_socket->close( );
+        }
+        
+        void SessionImpl::keep_alive( const shared_ptr< Session > session )
+        {
+            const auto socket = m_request->m_pimpl->m_socket;
+            
+            //An HTTP/2 stream carries a single exchange; the connection reads further requests itself.
+            if ( m_stream not_eq nullptr )
+            {
+                return m_manager->save( session, [ ]( const shared_ptr< Session > )
+                {
+                    return;
+                } );
+            }
+            
+            if ( is_final_request( ) )
+            {
+                return m_manager->save( session, [ socket ]( const shared_ptr< Session > )
+                {
+                    socket->close( );
+                } );
+            }
+            
+            reset_request( *m_request );
+            m_resource = nullptr;
+            m_error_handler_invoked = false;
+            
+            const auto timeout = m_settings->get_keep_alive_timeout( );
+            
+            if ( timeout not_eq milliseconds::zero( ) )
+            {
+                socket->set_timeout( timeout );
+            }
+            
+            socket->start_read( m_request->m_pimpl->m_buffer, "\r\n\r\n", [ this, session ]( const error_code & error, const size_t length )
+            {
+                m_keep_alive_callback( error, length, session );
+            } );
+        }
+        
+        bool SessionImpl::is_final_request( void ) const
+        {
+            const auto limit = m_settings->get_keep_alive_limit( );
+            
+            if ( limit == 0 or m_stream not_eq nullptr )
+            {
+                return false;
+            }
+            
+            //Pipelined requests are numbered by the connection's sequencer, as later requests may already have been parsed.
+            const auto count = ( m_pipeline not_eq nullptr ) ? m_sequence + 1 : m_request->m_pimpl->m_socket->m_request_id;
+            
+            return count >= limit;
         }
         
         const function< void ( const int, const exception&, const shared_ptr< Session > ) > SessionImpl::get_error_handler( void )
@@ -208,5 +352,128 @@ namespace restbed
             
             return error_handler;
         }
+        
+        shared_ptr< Session > SessionImpl::acquire_session( void )
+        {
+            return PoolImpl< Session, &SessionImpl::create_session, &SessionImpl::recycle_session >::acquire( );
+        }
+        
+        shared_ptr< Request > SessionImpl::acquire_request( void )
+        {
+            return PoolImpl< Request, &SessionImpl::create_request, &SessionImpl::recycle_request >::acquire( );
+        }
+        
+        void SessionImpl::stream_body( const size_t remaining, const shared_ptr< Session > session, const function< void ( const Byte*, const size_t ) >& sink, const function< void ( const shared_ptr< Session > ) >& callback )
+        {
+            static const size_t CHUNK_SIZE = 64 * 1024;
+            
+            auto buffer = m_request->m_pimpl->m_buffer;
+            const auto length = min( buffer->size( ), remaining );
+            
+            try
+            {
+                sink( asio::buffer_cast< const Byte* >( buffer->data( ) ), length );
+                buffer->consume( length );
+            }
+            catch ( const invalid_argument& ia )
+            {
+                return get_error_handler( )( 400, ia, session );
+            }
+            catch ( const exception& ex )
+            {
+                return get_error_handler( )( 500, ex, session );
+            }
+            
+            if ( remaining == length )
+            {
+                return callback( session );
+            }
+            
+            read( min( remaining - length, CHUNK_SIZE ), [ this, remaining, length, session, sink, callback ]( const error_code & error, size_t )
+            {
+                if ( error )
+                {
+                    const auto message = String::format( "Fetch failed: %s", error.message( ).data( ) );
+                    return get_error_handler( )( 500, runtime_error( message ), session );
+                }
+                
+                stream_body( remaining - length, session, sink, callback );
+            } );
+        }
+        
+        Session* SessionImpl::create_session( void )
+        {
+            return new Session( String::empty );
+        }
+        
+        bool SessionImpl::recycle_session( Session& session )
+        {
+            auto& state = *session.m_pimpl;
+            state.m_id.clear( );
+            state.m_request = nullptr;
+            state.m_resource = nullptr;
+            state.m_settings = nullptr;
+            state.m_manager = nullptr;
+            state.m_web_socket_manager = nullptr;
+            state.m_headers.clear( );
+            state.m_context.clear( );
+            state.m_error_handler = nullptr;
+            state.m_keep_alive_callback = nullptr;
+            state.m_rule_cursor = 0;
+            state.m_rule_state = 0;
+            state.m_rule_callback = nullptr;
+            state.m_pipeline = nullptr;
+            state.m_sequence = 0;
+            state.m_stream = nullptr;
+            state.m_error_handler_invoked = false;
+            
+            return true;
+        }
+        
+        void SessionImpl::reset_request( const Request& request )
+        {
+            auto& state = *request.m_pimpl;
+            state.m_body.clear( );
+            state.m_body_file = nullptr;
+            state.m_version = 1.1;
+            state.m_path = "/";
+            state.m_method = "GET";
+            state.m_protocol = "HTTP";
+            state.m_response = nullptr;
+            state.m_headers.clear( );
+            state.m_path_parameters.clear( );
+            state.m_query_parameters.clear( );
+        }
+        
+        Request* SessionImpl::create_request( void )
+        {
+            return new Request;
+        }
+        
+        bool SessionImpl::recycle_request( Request& request )
+        {
+            static const size_t retained_capacity = 64 * 1024;
+            
+            reset_request( request );
+            
+            auto& state = *request.m_pimpl;
+            state.m_port = 80;
+            state.m_host.clear( );
+            state.m_uri = nullptr;
+            state.m_io_service = nullptr;
+            state.m_socket = nullptr;
+            state.m_stream = nullptr;
+            
+            if ( state.m_buffer not_eq nullptr and ( not state.m_buffer.unique( ) or state.m_buffer->capacity( ) > retained_capacity ) )
+            {
+                state.m_buffer = nullptr;
+            }
+            else if ( state.m_buffer not_eq nullptr )
+            {
+                state.m_buffer->consume( state.m_buffer->size( ) );
+            }
+            
+            return true;
+        }
     }
 }
@@ -7,6 +7,7 @@
 //System Includes
 #include <map>
 #include <string>
+#include <atomic>
 #include <memory>
 #include <istream>
 #include <functional>
@@ -14,6 +15,8 @@
 
 //Project Includes
 #include "corvusoft/restbed/byte.hpp"
+#include "corvusoft/restbed/buffer_chain.hpp"
+#include "corvusoft/restbed/detail/callback_impl.hpp"
 
 //External Includes
 
@@ -31,11 +34,14 @@ namespace restbed
     class Response;
     class Resource;
     class Settings;
+    class BodyFile;
     class SessionManager;
     
     namespace detail
     {
         //Forward Declarations
+        class PipelineImpl;
+        struct Http2StreamImpl;
         class WebSocketManagerImpl;
         
         class SessionImpl
@@ -55,7 +61,40 @@ namespace restbed
                 //Functionality
                 void fetch_body( const std::size_t length, const std::shared_ptr< Session > session, const std::function< void ( const std::shared_ptr< Session >, const Bytes& ) >& callback ) const;
                 
-                void transmit( const Response& response, const std::function< void ( const std::error_code&, std::size_t ) >& callback ) const;
+                //Streams a body larger than the configured spill threshold into a temporary file rather than memory.
+                void spill_body( const std::size_t length, const std::shared_ptr< Session > session, const std::function< void ( const std::shared_ptr< Session >, const Bytes& ) >& callback );
+                
+                //Hands length bytes to sink in bounded chunks as they arrive; sink throwing std::invalid_argument is reported as a 400, anything else as a 500.
+                void stream_body( const std::size_t length, const std::shared_ptr< Session > session, const std::function< void ( const Byte*, const std::size_t ) >& sink, const std::function< void ( const std::shared_ptr< Session > ) >& callback );
+                
+                //Writes the response head and body as one gathered write; the body's segments are shared rather than copied.
+                //Pipelined sessions hand the write to the connection's sequencer instead, final marking the end of the response.
+                void transmit( const Response& response, const bool final, CallbackImpl< void ( const std::error_code&, std::size_t ) > callback ) const;
+                
+                //Reads request data into the request buffer from the socket, or from the HTTP/2 stream the session belongs to.
+                void read( const std::size_t length, CallbackImpl< void ( const std::error_code&, std::size_t ) > callback ) const;
+                
+                void read( const std::string& delimiter, CallbackImpl< void ( const std::error_code&, std::size_t ) > callback ) const;
+                
+                //Writes raw response data; on an HTTP/2 stream it is sent as DATA frames and final ends the stream.
+                void write( const BufferChain& data, const bool final, CallbackImpl< void ( const std::error_code&, std::size_t ) > callback ) const;
+                
+                //Closes the connection, or on HTTP/2 cancels only this session's stream.
+                void disconnect( void ) const;
+                
+                //Waits for the next request on a keep-alive connection, or closes it once the configured request limit has been served.
+                void keep_alive( const std::shared_ptr< Session > session );
+                
+                //True when the current request is the last the connection may serve under the keep-alive request limit.
+                bool is_final_request( void ) const;
+                
+                //Clears the previous request's message state; the socket, any bytes already buffered and container capacity are kept.
+                static void reset_request( const Request& request );
+                
+                //Sessions and requests handed out by these are reset and reused once every reference to them is released.
+                static std::shared_ptr< Session > acquire_session( void );
+                
+                static std::shared_ptr< Request > acquire_request( void );
                 
                 //Getters
                 const std::function< void ( const int, const std::exception&, const std::shared_ptr< Session > ) > get_error_handler( void );
@@ -84,8 +123,20 @@ namespace restbed
                 
                 std::function< void ( const int, const std::exception&, const std::shared_ptr< Session > ) > m_error_handler;
                 
-                std::function< void (  const std::error_code& error, std::size_t length, const std::shared_ptr< Session > ) > m_keep_alive_callback;
+                CallbackImpl< void ( const std::error_code& error, std::size_t length, const std::shared_ptr< Session > ) > m_keep_alive_callback;
+                
+                std::size_t m_rule_cursor;
+                
+                std::atomic< int > m_rule_state;
+                
+                CallbackImpl< void ( const std::shared_ptr< Session > ) > m_rule_callback;
+                
+                std::shared_ptr< PipelineImpl > m_pipeline;
                 
+                std::size_t m_sequence;
+                
+                std::shared_ptr< Http2StreamImpl > m_stream;
+            
             protected:
                 //Friends
                 
@@ -111,6 +162,13 @@ namespace restbed
                 //Constructors
                 
                 //Functionality
+                static Session* create_session( void );
+                
+                static bool recycle_session( Session& session );
+                
+                static Request* create_request( void );
+                
+                static bool recycle_request( Request& request );
                 
                 //Getters
                 
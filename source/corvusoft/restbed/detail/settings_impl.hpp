@@ -9,6 +9,7 @@
 #include <string>
 #include <memory>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 
 //Project Includes
@@ -44,6 +45,18 @@ namespace restbed
             
             bool m_case_insensitive_uris = true;
             
+            std::size_t m_body_spill_threshold = 0;
+            
+            std::string m_body_spill_directory = "/tmp";
+            
+            std::size_t m_pipeline_limit = 0;
+            
+            std::size_t m_keep_alive_limit = 0;
+            
+            bool m_http2_enabled = false;
+            
+            std::size_t m_http2_stream_limit = 100;
+            
             std::map< std::string, std::string > m_properties { };
             
             std::shared_ptr< const SSLSettings > m_ssl_settings = nullptr;
@@ -52,6 +65,8 @@ namespace restbed
             
             std::chrono::milliseconds m_connection_timeout = std::chrono::milliseconds( 5000 );
             
+            std::chrono::milliseconds m_keep_alive_timeout = std::chrono::milliseconds( 0 );
+            
             std::map< int, std::string > m_status_messages
             {
                 { 100, "Continue" },
@@ -9,6 +9,7 @@
 //Project Includes
 #include "corvusoft/restbed/logger.hpp"
 #include "corvusoft/restbed/detail/socket_impl.hpp"
+#include "corvusoft/restbed/detail/handler_allocator_impl.hpp"
 
 //External Includes
 #include <asio/read.hpp>
@@ -21,15 +22,19 @@
 using std::get;
 using std::bind;
 using std::size_t;
+using std::mutex;
 using std::string;
+using std::vector;
 using std::promise;
 using std::function;
+using std::lock_guard;
 using std::to_string;
 using std::error_code;
 using std::shared_ptr;
 using std::make_shared;
 using std::runtime_error;
 using std::placeholders::_1;
+using std::placeholders::_2;
 using std::chrono::milliseconds;
 using std::chrono::steady_clock;
 
@@ -49,12 +54,31 @@ namespace restbed
 {
     namespace detail
     {
-        SocketImpl::SocketImpl( const shared_ptr< tcp::socket >& socket, const shared_ptr< Logger >& logger ) : m_error_handler( nullptr ),
+        static vector< asio::const_buffer > make_buffers( const BufferChain& chain )
+        {
+            vector< asio::const_buffer > sequence;
+            
+            for ( const auto& segment : chain.get_segments( ) )
+            {
+                sequence.push_back( asio::buffer( segment.first, segment.second ) );
+            }
+            
+            return sequence;
+        }
+        
+        SocketImpl::SocketImpl( const shared_ptr< tcp::socket >& socket, const shared_ptr< Logger >& logger ) : m_connection_id( 0 ),
+            m_request_id( 0 ),
+            m_error_handler( nullptr ),
+            m_trace_handler( nullptr ),
             m_is_open( socket->is_open( ) ),
+            m_pending_writes( ),
+            m_pending_writes_lock( ),
+            m_read_callback( nullptr ),
             m_logger( logger ),
             m_timeout( 0 ),
             m_timer( make_shared< asio::steady_timer >( socket->get_io_service( ) ) ),
             m_strand( make_shared< io_service::strand > ( socket->get_io_service( ) ) ),
+            m_handler_allocator( make_shared< HandlerAllocatorImpl >( ) ),
             m_resolver( nullptr ),
             m_socket( socket )
 #ifdef BUILD_SSL
@@ -64,12 +88,19 @@ namespace restbed
             return;
         }
 #ifdef BUILD_SSL
-        SocketImpl::SocketImpl( const shared_ptr< asio::ssl::stream< tcp::socket > >& socket, const shared_ptr< Logger >& logger ) : m_error_handler( nullptr ),
+        SocketImpl::SocketImpl( const shared_ptr< asio::ssl::stream< tcp::socket > >& socket, const shared_ptr< Logger >& logger ) : m_connection_id( 0 ),
+            m_request_id( 0 ),
+            m_error_handler( nullptr ),
+            m_trace_handler( nullptr ),
             m_is_open( socket->lowest_layer( ).is_open( ) ),
+            m_pending_writes( ),
+            m_pending_writes_lock( ),
+            m_read_callback( nullptr ),
             m_logger( logger ),
             m_timeout( 0 ),
             m_timer( make_shared< asio::steady_timer >( socket->lowest_layer( ).get_io_service( ) ) ),
             m_strand( make_shared< io_service::strand > ( socket->get_io_service( ) ) ),
+            m_handler_allocator( make_shared< HandlerAllocatorImpl >( ) ),
             m_resolver( nullptr ),
             m_socket( nullptr ),
             m_ssl_socket( socket )
@@ -117,6 +148,15 @@ namespace restbed
             return not m_is_open;
         }
         
+        bool SocketImpl::is_secure( void ) const
+        {
+#ifdef BUILD_SSL
+            return m_ssl_socket not_eq nullptr;
+#else
+            return false;
+#endif
+        }
+        
         void SocketImpl::connect( const string& hostname, const uint16_t port, const function< void ( const error_code& ) >& callback )
         {
 #ifdef BUILD_SSL
@@ -161,12 +201,48 @@ namespace restbed
         {
             m_timer->cancel( );
             m_timer->expires_from_now( delay );
-            m_timer->async_wait( callback );
+            m_timer->async_wait( make_allocated_handler( m_handler_allocator, callback ) );
+        }
+        
+        void SocketImpl::trace( const TraceEvent event ) const
+        {
+            if ( m_trace_handler not_eq nullptr )
+            {
+                m_trace_handler( event, m_connection_id, m_request_id, steady_clock::now( ) );
+            }
         }
 
-		void SocketImpl::start_write(const Bytes& data, const std::function< void ( const std::error_code&, std::size_t ) >& callback)
+		void SocketImpl::start_write(const Bytes& data, CallbackImpl< void ( const error_code&, size_t ) > callback)
 		{
-			m_strand->post([this, data, callback] { write_helper(data, callback); });
+			start_write( BufferChain( data ), std::move( callback ) );
+        }
+        
+        void SocketImpl::start_write( Bytes&& data, CallbackImpl< void ( const error_code&, size_t ) > callback )
+        {
+            start_write( BufferChain( std::move( data ) ), std::move( callback ) );
+        }
+        
+        void SocketImpl::start_write( const shared_ptr< const Bytes >& data, CallbackImpl< void ( const error_code&, size_t ) > callback )
+        {
+            start_write( BufferChain( data ), std::move( callback ) );
+        }
+        
+        void SocketImpl::start_write( const BufferChain& data, CallbackImpl< void ( const error_code&, size_t ) > callback )
+        {
+            bool idle = false;
+            
+            {
+                lock_guard< mutex > guard( m_pending_writes_lock );
+                m_pending_writes.emplace( data, 0, std::move( callback ) );
+                idle = ( m_pending_writes.size( ) == 1 );
+            }
+            
+            trace( WRITE_QUEUED );
+            
+            if ( idle )
+            {
+                m_strand->post( [ this ] { write( ); } );
+            }
         }
 
 		size_t SocketImpl::start_read(const shared_ptr< asio::streambuf >& data, const string& delimiter, error_code& error)
@@ -186,22 +262,41 @@ namespace restbed
 			});
         }
         
-		void SocketImpl::start_read(const shared_ptr< asio::streambuf >& data, const size_t length, const function< void ( const error_code&, size_t ) >& callback)
+		void SocketImpl::start_read(const shared_ptr< asio::streambuf >& data, const size_t length, CallbackImpl< void ( const error_code&, size_t ) > callback)
 		{
-			m_strand->post([this, data, length, callback] 
+			m_read_callback = std::move( callback );
+			m_strand->post([this, data, length] 
 			{
-				read(data, length, callback);
+				read(data, length);
 			});
 		}
 
-		void SocketImpl::start_read(const shared_ptr< asio::streambuf >& data, const string& delimiter, const function< void ( const error_code&, size_t ) >& callback)
+		void SocketImpl::start_read(const shared_ptr< asio::streambuf >& data, const string& delimiter, CallbackImpl< void ( const error_code&, size_t ) > callback)
 		{
-			m_strand->post([this, data, delimiter, callback] 
+			m_read_callback = std::move( callback );
+			m_strand->post([this, data, delimiter] 
 			{
-				read(data, delimiter, callback);
+				read(data, delimiter);
 			});
         }
 
+        string SocketImpl::get_application_protocol( void ) const
+        {
+#ifdef BUILD_SSL
+            
+            if ( m_ssl_socket not_eq nullptr )
+            {
+                unsigned int length = 0;
+                const unsigned char* protocol = nullptr;
+                SSL_get0_alpn_selected( m_ssl_socket->native_handle( ), &protocol, &length );
+                
+                return ( protocol == nullptr ) ? "" : string( reinterpret_cast< const char* >( protocol ), length );
+            }
+            
+#endif
+            return "";
+        }
+        
         string SocketImpl::get_local_endpoint( void )
         {
             error_code error;
@@ -288,85 +383,95 @@ namespace restbed
         {
 			if(m_is_open)
 			{
+                vector< asio::const_buffer > buffers;
+                
+                {
+                    lock_guard< mutex > guard( m_pending_writes_lock );
+                    buffers = make_buffers( get< 0 >( m_pending_writes.front( ) ) );
+                }
+
 				m_timer->cancel( );
 				m_timer->expires_from_now( m_timeout );
-				m_timer->async_wait( m_strand->wrap( bind( &SocketImpl::connection_timeout_handler, this, shared_from_this( ), _1 ) ) );
+				m_timer->async_wait( m_strand->wrap( make_allocated_handler( m_handler_allocator, bind( &SocketImpl::connection_timeout_handler, this, shared_from_this( ), _1 ) ) ) );
 #ifdef BUILD_SSL
 				if ( m_socket not_eq nullptr )
 				{
 #endif
-					asio::async_write( *m_socket, asio::buffer( get<0>(m_pending_writes.front()).data( ), get<0>(m_pending_writes.front()).size( ) ), m_strand->wrap( [ this ]( const error_code & error, size_t length )
-					{
-						m_timer->cancel( );
-						auto callback = get<2>(m_pending_writes.front());
-						auto & retries = get<1>(m_pending_writes.front());
-						auto & buffer = get<0>(m_pending_writes.front());
-						if(length < buffer.size() &&  retries < MAX_WRITE_RETRIES &&  error not_eq asio::error::operation_aborted)
-						{
-							++retries;
-							buffer.erase(buffer.begin(),buffer.begin() + length);
-						}
-						else
-						{
-							m_pending_writes.pop();
-						}
-						if ( error not_eq asio::error::operation_aborted )
-						{
-							callback( error, length );
-						}
-						if(!m_pending_writes.empty())
-						{
-							write();
-						}
-					} ) );
+					asio::async_write( *m_socket, buffers, m_strand->wrap( make_allocated_handler( m_handler_allocator, bind( &SocketImpl::write_handler, this, _1, _2 ) ) ) );
 					
 #ifdef BUILD_SSL
 				}
 				else
 				{
-					asio::async_write(*m_ssl_socket, asio::buffer( get<0>(m_pending_writes.front()).data( ), get<0>(m_pending_writes.front()).size( ) ), m_strand->wrap( [ this ]( const error_code & error, size_t length )
-					{
-						m_timer->cancel( );
-						auto callback = get<2>(m_pending_writes.front());
-						auto & retries = get<1>(m_pending_writes.front());
-						auto & buffer = get<0>(m_pending_writes.front());
-						if(length < buffer.size() &&  retries < MAX_WRITE_RETRIES &&  error not_eq asio::error::operation_aborted)
-						{
-							++retries;
-							buffer.erase(buffer.begin(),buffer.begin() + length);
-						}
-						else
-						{
-							m_pending_writes.pop();
-						}
-						if ( error not_eq asio::error::operation_aborted )
-						{
-							callback( error, length );
-						}
-						if(!m_pending_writes.empty())
-						{
-							write();
-						}
-					} ) );
+					asio::async_write(*m_ssl_socket, buffers, m_strand->wrap( make_allocated_handler( m_handler_allocator, bind( &SocketImpl::write_handler, this, _1, _2 ) ) ) );
 				}
             
 #endif
 			}
         }
 
+        void SocketImpl::write_handler( const error_code& error, const size_t length )
+        {
+            m_timer->cancel( );
+            
+            bool pending = false;
+            CallbackImpl< void ( const error_code&, size_t ) >* retry = nullptr;
+            CallbackImpl< void ( const error_code&, size_t ) > callback = nullptr;
+            
+            {
+                lock_guard< mutex > guard( m_pending_writes_lock );
+                auto& operation = m_pending_writes.front( );
+                auto& retries = get< 1 >( operation );
+                auto& remainder = get< 0 >( operation );
+                
+                if ( length < remainder.get_size( ) and retries < MAX_WRITE_RETRIES and error not_eq asio::error::operation_aborted )
+                {
+                    ++retries;
+                    remainder.consume( length );
+                    retry = &get< 2 >( operation );
+                }
+                else
+                {
+                    callback = std::move( get< 2 >( operation ) );
+                    m_pending_writes.pop( );
+                }
+                
+                pending = not m_pending_writes.empty( );
+            }
+            
+            if ( retry not_eq nullptr )
+            {
+                ( *retry )( error, length );
+            }
+            else
+            {
+                trace( WRITE_COMPLETED );
+                
+                if ( error not_eq asio::error::operation_aborted )
+                {
+                    callback( error, length );
+                }
+            }
+            
+            if ( pending )
+            {
+                write( );
+            }
+        }
+        
         void SocketImpl::write( const Bytes& data, const function< void ( const error_code&, size_t ) >& callback )
         {
             const auto buffer = make_shared< Bytes >( data );
             
             m_timer->cancel( );
             m_timer->expires_from_now( m_timeout );
-            m_timer->async_wait( m_strand->wrap( bind( &SocketImpl::connection_timeout_handler, this, shared_from_this( ), _1 ) ) );
+            m_timer->async_wait( m_strand->wrap( make_allocated_handler( m_handler_allocator, bind( &SocketImpl::connection_timeout_handler, this, shared_from_this( ), _1 ) ) ) );
 #ifdef BUILD_SSL
             
             if ( m_socket not_eq nullptr )
             {
 #endif
-                asio::async_write( *m_socket, asio::buffer( buffer->data( ), buffer->size( ) ), m_strand->wrap( [ this, callback, buffer ]( const error_code & error, size_t length )
+                asio::async_write( *m_socket, asio::buffer( buffer->data( ), buffer->size( ) ), m_strand->wrap( make_allocated_handler( m_handler_allocator, [ this, callback, buffer ]( const error_code & error, size_t length )
                 {
                     m_timer->cancel( );
                     
@@ -379,12 +484,12 @@ namespace restbed
                     {
                         callback( error, length );
                     }
-                } ) );
+                } ) ) );
 #ifdef BUILD_SSL
             }
             else
             {
-                asio::async_write( *m_ssl_socket, asio::buffer( buffer->data( ), buffer->size( ) ), m_strand->wrap( [ this, callback, buffer ]( const error_code & error, size_t length )
+                asio::async_write( *m_ssl_socket, asio::buffer( buffer->data( ), buffer->size( ) ), m_strand->wrap( make_allocated_handler( m_handler_allocator, [ this, callback, buffer ]( const error_code & error, size_t length )
                 {
                     m_timer->cancel( );
                     
@@ -397,25 +502,17 @@ namespace restbed
                     {
                         callback( error, length );
                     }
-                } ) );
+                } ) ) );
             }  
 #endif
         }
 
-		void SocketImpl::write_helper(const Bytes& data, const function< void ( const error_code&, size_t ) >& callback)
-		{
-			m_pending_writes.push(make_tuple(data, 0, callback));
-			if(m_pending_writes.size() == 1)
-			{
-				write();
-			}
-		}
         
         size_t SocketImpl::read( const shared_ptr< asio::streambuf >& data, const size_t length, error_code& error )
         {
             m_timer->cancel( );
             m_timer->expires_from_now( m_timeout );
-            m_timer->async_wait( bind( &SocketImpl::connection_timeout_handler, this, shared_from_this( ), _1 ) );
+            m_timer->async_wait( make_allocated_handler( m_handler_allocator, bind( &SocketImpl::connection_timeout_handler, this, shared_from_this( ), _1 ) ) );
 
             size_t size = 0;
             auto finished = std::make_shared<bool>(false);
@@ -428,21 +525,21 @@ namespace restbed
             {
 #endif
                 asio::async_read( *m_socket, *data, asio::transfer_at_least( length ),
-                    [ this, finished, sharedSize, sharedError ]( const error_code & error, size_t size ) {
+                    make_allocated_handler( m_handler_allocator, [ this, finished, sharedSize, sharedError ]( const error_code & error, size_t size ) {
                         *sharedError = error;
                         *sharedSize = size;
                         *finished = true;
-                });
+                } ));
 #ifdef BUILD_SSL
             }
             else
             {
                 asio::async_read( *m_ssl_socket, *data, asio::transfer_at_least( length ),
-                    [ this, finished, sharedSize, sharedError ]( const error_code & error, size_t size ) {
+                    make_allocated_handler( m_handler_allocator, [ this, finished, sharedSize, sharedError ]( const error_code & error, size_t size ) {
                         *sharedError = error;
                         *sharedSize = size;
                         *finished = true;
-                });
+                } ));
             }
 #endif
             auto& io_service = m_socket->get_io_service( );
@@ -464,7 +561,7 @@ namespace restbed
         {
             m_timer->cancel( );
             m_timer->expires_from_now( m_timeout );
-            m_timer->async_wait( bind( &SocketImpl::connection_timeout_handler, this, shared_from_this( ), _1 ) );
+            m_timer->async_wait( make_allocated_handler( m_handler_allocator, bind( &SocketImpl::connection_timeout_handler, this, shared_from_this( ), _1 ) ) );
             
 #ifdef BUILD_SSL
             
@@ -472,7 +569,7 @@ namespace restbed
             {
 #endif
                 auto data = make_shared< asio::streambuf >( );
-                asio::async_read( *m_socket, *data, asio::transfer_exactly( length ), [ this, data, success, failure ]( const error_code code, const size_t length )
+                asio::async_read( *m_socket, *data, asio::transfer_exactly( length ), make_allocated_handler( m_handler_allocator, [ this, data, success, failure ]( const error_code code, const size_t length )
                 {
                     m_timer->cancel( );
                     
@@ -486,13 +583,13 @@ namespace restbed
                         const auto data_ptr = asio::buffer_cast< const Byte* >( data->data( ) );
                         success( Bytes( data_ptr, data_ptr + length ) );
                     }
-                } );
+                } ) );
 #ifdef BUILD_SSL
             }
             else
             {
                 auto data = make_shared< asio::streambuf >( );
-                asio::async_read( *m_ssl_socket, *data, asio::transfer_exactly( length ), [ this, data, success, failure ]( const error_code code, const size_t length )
+                asio::async_read( *m_ssl_socket, *data, asio::transfer_exactly( length ), make_allocated_handler( m_handler_allocator, [ this, data, success, failure ]( const error_code code, const size_t length )
                 {
                     m_timer->cancel( );
                     
@@ -506,55 +603,29 @@ namespace restbed
                         const auto data_ptr = asio::buffer_cast< const Byte* >( data->data( ) );
                         success( Bytes( data_ptr, data_ptr + length ) );
                     }
-                } );
+                } ) );
             }
             
 #endif
         }
         
-        void SocketImpl::read( const shared_ptr< asio::streambuf >& data, const size_t length, const function< void ( const error_code&, size_t ) >& callback )
+        void SocketImpl::read( const shared_ptr< asio::streambuf >& data, const size_t length )
         {
             m_timer->cancel( );
             m_timer->expires_from_now( m_timeout );
-            m_timer->async_wait( m_strand->wrap( bind( &SocketImpl::connection_timeout_handler, this, shared_from_this( ), _1 ) ) );
+            m_timer->async_wait( m_strand->wrap( make_allocated_handler( m_handler_allocator, bind( &SocketImpl::connection_timeout_handler, this, shared_from_this( ), _1 ) ) ) );
             
 #ifdef BUILD_SSL
             
             if ( m_socket not_eq nullptr )
             {
 #endif
-                asio::async_read( *m_socket, *data, asio::transfer_at_least( length ), m_strand->wrap( [ this, callback ]( const error_code & error, size_t length )
-                {
-                    m_timer->cancel( );
-                    
-                    if ( error )
-                    {
-                        m_is_open = false;
-                    }
-                    
-                    if ( error not_eq asio::error::operation_aborted )
-                    {
-                        callback( error, length );
-                    }
-                } ) );
+                asio::async_read( *m_socket, *data, asio::transfer_at_least( length ), m_strand->wrap( make_allocated_handler( m_handler_allocator, bind( &SocketImpl::read_handler, this, _1, _2 ) ) ) );
 #ifdef BUILD_SSL
             }
             else
             {
-                asio::async_read( *m_ssl_socket, *data, asio::transfer_at_least( length ), m_strand->wrap( [ this, callback ]( const error_code & error, size_t length )
-                {
-                    m_timer->cancel( );
-                    
-                    if ( error )
-                    {
-                        m_is_open = false;
-                    }
-                    
-                    if ( error not_eq asio::error::operation_aborted )
-                    {
-                        callback( error, length );
-                    }
-                } ) );
+                asio::async_read( *m_ssl_socket, *data, asio::transfer_at_least( length ), m_strand->wrap( make_allocated_handler( m_handler_allocator, bind( &SocketImpl::read_handler, this, _1, _2 ) ) ) );
             }
             
 #endif
@@ -564,7 +635,7 @@ namespace restbed
         {
             m_timer->cancel( );
             m_timer->expires_from_now( m_timeout );
-            m_timer->async_wait( bind( &SocketImpl::connection_timeout_handler, this, shared_from_this( ), _1 ) );
+            m_timer->async_wait( make_allocated_handler( m_handler_allocator, bind( &SocketImpl::connection_timeout_handler, this, shared_from_this( ), _1 ) ) );
 
             size_t length = 0;
             auto finished = std::make_shared<bool>(false);
@@ -577,21 +648,21 @@ namespace restbed
             {
 #endif
                 asio::async_read_until( *m_socket, *data, delimiter,
-                    [ this, finished, sharedLength, sharedError ]( const error_code & error, size_t length ) {
+                    make_allocated_handler( m_handler_allocator, [ this, finished, sharedLength, sharedError ]( const error_code & error, size_t length ) {
                         *sharedError = error;
                         *sharedLength = length;
                         *finished = true;
-                });
+                } ));
 #ifdef BUILD_SSL
             }
             else
             {
                 asio::async_read_until( *m_ssl_socket, *data, delimiter,
-                    [ this, finished, sharedLength, sharedError ]( const error_code & error, size_t length ) {
+                    make_allocated_handler( m_handler_allocator, [ this, finished, sharedLength, sharedError ]( const error_code & error, size_t length ) {
                         *sharedError = error;
                         *sharedLength = length;
                         *finished = true;
-                });
+                } ));
             }
 #endif
             auto& io_service = m_socket->get_io_service( );
@@ -609,52 +680,43 @@ namespace restbed
             return length;
         }
         
-        void SocketImpl::read( const shared_ptr< asio::streambuf >& data, const string& delimiter, const function< void ( const error_code&, size_t ) >& callback )
+        void SocketImpl::read( const shared_ptr< asio::streambuf >& data, const string& delimiter )
         {
             m_timer->cancel( );
             m_timer->expires_from_now( m_timeout );
-            m_timer->async_wait( m_strand->wrap( bind( &SocketImpl::connection_timeout_handler, this, shared_from_this( ), _1 ) ) );
+            m_timer->async_wait( m_strand->wrap( make_allocated_handler( m_handler_allocator, bind( &SocketImpl::connection_timeout_handler, this, shared_from_this( ), _1 ) ) ) );
             
 #ifdef BUILD_SSL
             
             if ( m_socket not_eq nullptr )
             {
 #endif
-                asio::async_read_until( *m_socket, *data, delimiter, m_strand->wrap( [ this, callback ]( const error_code & error, size_t length )
-                {
-                    m_timer->cancel( );
-                    
-                    if ( error )
-                    {
-                        m_is_open = false;
-                    }
-                    
-                    if ( error not_eq asio::error::operation_aborted )
-                    {
-                        callback( error, length );
-                    }
-                } ) );
+                asio::async_read_until( *m_socket, *data, delimiter, m_strand->wrap( make_allocated_handler( m_handler_allocator, bind( &SocketImpl::read_handler, this, _1, _2 ) ) ) );
 #ifdef BUILD_SSL
             }
             else
             {
-                asio::async_read_until( *m_ssl_socket, *data, delimiter, m_strand->wrap( [ this, callback ]( const error_code & error, size_t length )
-                {
-                    m_timer->cancel( );
-                    
-                    if ( error )
-                    {
-                        m_is_open = false;
-                    }
-                    
-                    if ( error not_eq asio::error::operation_aborted )
-                    {
-                        callback( error, length );
-                    }
-                } ) );
+                asio::async_read_until( *m_ssl_socket, *data, delimiter, m_strand->wrap( make_allocated_handler( m_handler_allocator, bind( &SocketImpl::read_handler, this, _1, _2 ) ) ) );
             }
             
 #endif
         }
+        
+        void SocketImpl::read_handler( const error_code& error, const size_t length )
+        {
+            m_timer->cancel( );
+            
+            if ( error )
+            {
+                m_is_open = false;
+            }
+            
+            const auto callback = std::move( m_read_callback );
+            
+            if ( error not_eq asio::error::operation_aborted )
+            {
+                callback( error, length );
+            }
+        }
     }
 }
@@ -7,7 +7,9 @@
 //System Includes
 #include <queue>
 #include <tuple>
+#include <vector>
 #include <chrono>
+#include <mutex>
 #include <string>
 #include <memory>
 #include <cstdint>
@@ -17,6 +19,9 @@
 
 //Project Includes
 #include "corvusoft/restbed/byte.hpp"
+#include "corvusoft/restbed/trace_event.hpp"
+#include "corvusoft/restbed/buffer_chain.hpp"
+#include "corvusoft/restbed/detail/callback_impl.hpp"
 
 //External Includes
 #include <asio/ip/tcp.hpp>
@@ -44,6 +49,7 @@ namespace restbed
     namespace detail
     {
         //Forward Declarations
+        class HandlerAllocatorImpl;
         
         class SocketImpl : public std::enable_shared_from_this<SocketImpl>
         {
@@ -66,23 +72,36 @@ namespace restbed
                 
                 bool is_closed( void ) const;
                 
+                bool is_secure( void ) const;
+                
                 void connect(  const std::string& hostname, const uint16_t port, const std::function< void ( const std::error_code& ) >& callback );
                 
                 void sleep_for( const std::chrono::milliseconds& delay, const std::function< void ( const std::error_code& ) >& callback );
                 
-				void start_write(const Bytes& data, const std::function< void ( const std::error_code&, std::size_t ) >& callback);
+                void trace( const TraceEvent event ) const;
+
+				void start_write(const Bytes& data, CallbackImpl< void ( const std::error_code&, std::size_t ) > callback);
 				
+                void start_write( Bytes&& data, CallbackImpl< void ( const std::error_code&, std::size_t ) > callback );
+                
+                void start_write( const std::shared_ptr< const Bytes >& data, CallbackImpl< void ( const std::error_code&, std::size_t ) > callback );
+                
+                void start_write( const BufferChain& data, CallbackImpl< void ( const std::error_code&, std::size_t ) > callback );
+
 				size_t start_read( const std::shared_ptr< asio::streambuf >& data, const std::string& delimiter, std::error_code& error );
 				
 				size_t start_read( const std::shared_ptr< asio::streambuf >& data, const std::size_t length, std::error_code& error );
                 
 				void start_read(const std::size_t length, const std::function< void ( const Bytes ) > success, const std::function< void ( const std::error_code ) > failure );
                 
-				void start_read( const std::shared_ptr< asio::streambuf >& data, const std::size_t length, const std::function< void ( const std::error_code&, std::size_t ) >& callback );
+				void start_read( const std::shared_ptr< asio::streambuf >& data, const std::size_t length, CallbackImpl< void ( const std::error_code&, std::size_t ) > callback );
                 
-				void start_read(const std::shared_ptr< asio::streambuf >& data, const std::string& delimiter, const std::function< void ( const std::error_code&, std::size_t ) >& callback );
+				void start_read(const std::shared_ptr< asio::streambuf >& data, const std::string& delimiter, CallbackImpl< void ( const std::error_code&, std::size_t ) > callback );
 
                 //Getters
+                //Protocol agreed through ALPN during the handshake, empty when none was.
+                std::string get_application_protocol( void ) const;
+                
                 std::string get_local_endpoint( void );
                 
                 std::string get_remote_endpoint( void );
@@ -93,8 +112,14 @@ namespace restbed
                 //Operators
                 
                 //Properties
+                std::uint64_t m_connection_id;
+                
+                std::uint64_t m_request_id;
+                
                 std::function< void ( const int, const std::exception&, const std::shared_ptr< Session > ) > m_error_handler;
                 
+                std::function< void ( const TraceEvent, const std::uint64_t, const std::uint64_t, const std::chrono::steady_clock::time_point& ) > m_trace_handler;
+                
             protected:
                 //Friends
                 
@@ -125,19 +150,21 @@ namespace restbed
 
                 void write( void );
                 
+                void write_handler( const std::error_code& error, const std::size_t length );
+                
                 void write( const Bytes& data, const std::function< void ( const std::error_code&, std::size_t ) >& callback );
                 
-				void write_helper( const Bytes& data, const std::function< void ( const std::error_code&, std::size_t ) >& callback );
-
                 size_t read( const std::shared_ptr< asio::streambuf >& data, const std::size_t length, std::error_code& error );
                 
                 void read( const std::size_t length, const std::function< void ( const Bytes ) > success, const std::function< void ( const std::error_code ) > failure );
                 
-                void read( const std::shared_ptr< asio::streambuf >& data, const std::size_t length, const std::function< void ( const std::error_code&, std::size_t ) >& callback );
+                void read( const std::shared_ptr< asio::streambuf >& data, const std::size_t length );
                 
                 size_t read( const std::shared_ptr< asio::streambuf >& data, const std::string& delimiter, std::error_code& error );
                 
-                void read( const std::shared_ptr< asio::streambuf >& data, const std::string& delimiter, const std::function< void ( const std::error_code&, std::size_t ) >& callback );
+                void read( const std::shared_ptr< asio::streambuf >& data, const std::string& delimiter );
+                
+                void read_handler( const std::error_code& error, const std::size_t length );
  
                 //Getters
                 
@@ -151,7 +178,13 @@ namespace restbed
 
 				const uint8_t MAX_WRITE_RETRIES = 5;
                 
-				std::queue< std::tuple< Bytes, uint8_t, std::function< void ( const std::error_code&, std::size_t ) > > > m_pending_writes;
+				//Unwritten remainder of each gather operation, retry count and completion callback.
+				std::queue< std::tuple< BufferChain, uint8_t, CallbackImpl< void ( const std::error_code&, std::size_t ) > > > m_pending_writes;
+                
+                std::mutex m_pending_writes_lock;
+                
+                //Completion for the single outstanding asynchronous read.
+                CallbackImpl< void ( const std::error_code&, std::size_t ) > m_read_callback;
 
                 std::shared_ptr< Logger > m_logger;
                 
@@ -161,6 +194,8 @@ namespace restbed
                 
                 std::shared_ptr< asio::io_service::strand > m_strand;
                 
+                std::shared_ptr< HandlerAllocatorImpl > m_handler_allocator;
+                
                 std::shared_ptr< asio::ip::tcp::resolver > m_resolver;
                 
                 std::shared_ptr< asio::ip::tcp::socket > m_socket;
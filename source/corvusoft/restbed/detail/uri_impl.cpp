@@ -0,0 +1,297 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <array>
+#include <cstdint>
+#include <ciso646>
+
+//Project Includes
+#include "corvusoft/restbed/detail/uri_impl.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::array;
+using std::string;
+using std::uint8_t;
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    namespace detail
+    {
+        enum CharacterClass : uint8_t
+        {
+            SCHEME = 0x01,      //ALPHA / DIGIT / "+" / "-" / "."
+            HOST = 0x02,        //ALPHA / DIGIT / "-" / "." / "_" / "~" / "%"
+            USERINFO = 0x04,    //HOST / sub-delims
+            AUTHORITY = 0x08,   //USERINFO / ":" / "[" / "]"
+            PATH = 0x10,        //USERINFO / ":" / "@" / "/"
+            FRAGMENT = 0x20     //PATH / "?"
+        };
+        
+        static const array< uint8_t, 256 >& character_classes( void )
+        {
+            static const array< uint8_t, 256 > classes = [ ]( )
+            {
+                array< uint8_t, 256 > table { };
+                
+                auto assign = [ &table ]( const string & characters, const uint8_t flags )
+                {
+                    for ( const unsigned char character : characters )
+                    {
+                        table[ character ] |= flags;
+                    }
+                };
+                
+                string alphanumeric = "";
+                
+                for ( char character = 'a'; character <= 'z'; character++ )
+                {
+                    alphanumeric.push_back( character );
+                    alphanumeric.push_back( static_cast< char >( character - 'a' + 'A' ) );
+                }
+                
+                for ( char character = '0'; character <= '9'; character++ )
+                {
+                    alphanumeric.push_back( character );
+                }
+                
+                const uint8_t common = HOST | USERINFO | AUTHORITY | PATH | FRAGMENT;
+                
+                assign( alphanumeric, SCHEME | common );
+                assign( "+", SCHEME | USERINFO | AUTHORITY | PATH | FRAGMENT );
+                assign( "-.", SCHEME | common );
+                assign( "_~%", common );
+                assign( "!$&'()*,;=", USERINFO | AUTHORITY | PATH | FRAGMENT );
+                assign( ":", AUTHORITY | PATH | FRAGMENT );
+                assign( "[]", AUTHORITY );
+                assign( "@/", PATH | FRAGMENT );
+                assign( "?", FRAGMENT );
+                
+                return table;
+            }( );
+            
+            return classes;
+        }
+        
+        static bool is( const char character, const uint8_t flags )
+        {
+            return ( character_classes( )[ static_cast< unsigned char >( character ) ] & flags ) not_eq 0;
+        }
+        
+        static string::size_type scan( const string& value, string::size_type position, const string::size_type end, const uint8_t flags )
+        {
+            while ( position < end and is( value[ position ], flags ) )
+            {
+                position++;
+            }
+            
+            return position;
+        }
+        
+        //Matches '*( AUTHORITY ) 1*( PATH )', the host and path portion accepted by Uri::is_valid.
+        static bool is_valid_location( const string& value, const string::size_type start, const string::size_type end )
+        {
+            if ( start >= end )
+            {
+                return false;
+            }
+            
+            auto last_bracket = string::npos;
+            auto first_separator = end;
+            
+            for ( auto position = start; position < end; position++ )
+            {
+                const auto character = value[ position ];
+                
+                if ( not is( character, AUTHORITY | PATH ) )
+                {
+                    return false;
+                }
+                
+                if ( character == '[' or character == ']' )
+                {
+                    last_bracket = position;
+                }
+                else if ( first_separator == end and ( character == '@' or character == '/' ) )
+                {
+                    first_separator = position;
+                }
+            }
+            
+            return last_bracket == string::npos or ( last_bracket < first_separator and last_bracket + 1 < end );
+        }
+        
+        static UriImpl::Component scan_host( const string& value, const string::size_type start, const string::size_type end )
+        {
+            if ( start < end and value[ start ] == '[' )
+            {
+                auto position = start + 1;
+                
+                while ( position < end and ( is( value[ position ], USERINFO ) or value[ position ] == ':' ) )
+                {
+                    position++;
+                }
+                
+                if ( position == start + 1 or position == end or value[ position ] not_eq ']' )
+                {
+                    return UriImpl::Component( start, start );
+                }
+                
+                return UriImpl::Component( start, position + 1 );
+            }
+            
+            return UriImpl::Component( start, scan( value, start, end, HOST ) );
+        }
+        
+        static UriImpl::Component scan_port( const string& value, const UriImpl::Component& host, const string::size_type end )
+        {
+            if ( host.first == host.second or host.second >= end or value[ host.second ] not_eq ':' )
+            {
+                return UriImpl::Component( 0, 0 );
+            }
+            
+            const auto start = host.second + 1;
+            auto position = start;
+            
+            while ( position < end and value[ position ] >= '0' and value[ position ] <= '9' )
+            {
+                position++;
+            }
+            
+            return ( position > start ) ? UriImpl::Component( start, position ) : UriImpl::Component( 0, 0 );
+        }
+        
+        bool UriImpl::parse( const string& value )
+        {
+            const auto length = value.length( );
+            
+            if ( length == 0 or not is( value[ 0 ], SCHEME ) or ( value[ 0 ] >= '0' and value[ 0 ] <= '9' ) or value[ 0 ] == '+' or value[ 0 ] == '-' or value[ 0 ] == '.' )
+            {
+                return false;
+            }
+            
+            const auto scheme_end = scan( value, 1, length, SCHEME );
+            
+            if ( value.compare( scheme_end, 3, "://" ) not_eq 0 )
+            {
+                return false;
+            }
+            
+            const auto start = scheme_end + 3;
+            auto end = start;
+            
+            while ( end < length and value[ end ] not_eq '?' and value[ end ] not_eq '#' )
+            {
+                end++;
+            }
+            
+            Component query( 0, 0 );
+            Component fragment( 0, 0 );
+            
+            if ( end < length and value[ end ] == '?' )
+            {
+                query.first = end + 1;
+                query.second = scan( value, query.first, length, PATH );
+                
+                if ( query.second < length and value[ query.second ] not_eq '#' )
+                {
+                    return false;
+                }
+            }
+            
+            const auto hash = ( query.first == 0 ) ? end : query.second;
+            
+            if ( hash < length )
+            {
+                fragment.first = hash + 1;
+                fragment.second = scan( value, fragment.first, length, FRAGMENT );
+                
+                if ( fragment.second not_eq length )
+                {
+                    return false;
+                }
+            }
+            
+            Component username( 0, 0 );
+            Component password( 0, 0 );
+            auto host_start = start;
+            
+            const auto user_end = scan( value, start, end, USERINFO );
+            
+            if ( user_end > start and user_end < end )
+            {
+                if ( value[ user_end ] == '@' )
+                {
+                    username = Component( start, user_end );
+                    host_start = user_end + 1;
+                }
+                else if ( value[ user_end ] == ':' )
+                {
+                    const auto password_end = scan( value, user_end + 1, end, USERINFO );
+                    
+                    if ( password_end > user_end + 1 and password_end < end and value[ password_end ] == '@' )
+                    {
+                        username = Component( start, user_end );
+                        password = Component( user_end + 1, password_end );
+                        host_start = password_end + 1;
+                    }
+                }
+            }
+            
+            if ( not is_valid_location( value, start, end ) and ( host_start == start or not is_valid_location( value, host_start, end ) ) )
+            {
+                return false;
+            }
+            
+            auto path_start = start;
+            
+            while ( path_start < end and value[ path_start ] not_eq '/' )
+            {
+                path_start++;
+            }
+            
+            auto host = scan_host( value, host_start, end );
+            auto port = scan_port( value, host, end );
+            
+            if ( host_start not_eq start )
+            {
+                const auto fallback = scan_host( value, start, end );
+                
+                if ( host.first == host.second )
+                {
+                    host = fallback;
+                }
+                
+                if ( port.first == port.second )
+                {
+                    port = scan_port( value, fallback, end );
+                }
+            }
+            
+            m_uri = value;
+            m_scheme = Component( 0, scheme_end );
+            m_username = username;
+            m_password = password;
+            m_authority = host;
+            m_port = port;
+            m_relative_path = Component( start, end );
+            m_path = Component( path_start, end );
+            m_query = query;
+            m_fragment = fragment;
+            
+            return true;
+        }
+        
+        string UriImpl::get_component( const Component& component ) const
+        {
+            return m_uri.substr( component.first, component.second - component.first );
+        }
+    }
+}
@@ -6,6 +6,7 @@
 
 //System Includes
 #include <string>
+#include <utility>
 
 //Project Includes
 
@@ -27,9 +28,34 @@ namespace restbed
         
         struct UriImpl
         {
+            //Offsets [first, second) of a component within m_uri.
+            typedef std::pair< std::string::size_type, std::string::size_type > Component;
+            
+            bool parse( const std::string& value );
+            
+            std::string get_component( const Component& component ) const;
+            
             std::string m_uri = "";
             
             bool m_relative = false;
+            
+            Component m_scheme { 0, 0 };
+            
+            Component m_username { 0, 0 };
+            
+            Component m_password { 0, 0 };
+            
+            Component m_authority { 0, 0 };
+            
+            Component m_port { 0, 0 };
+            
+            Component m_relative_path { 0, 0 };
+            
+            Component m_path { 0, 0 };
+            
+            Component m_query { 0, 0 };
+            
+            Component m_fragment { 0, 0 };
         };
     }
 }
@@ -44,7 +44,7 @@ namespace restbed
         
         void WebSocketImpl::log( const Logger::Level level, const string& message ) const
         {
-            if ( m_logger not_eq nullptr )
+            if ( m_logger not_eq nullptr and m_logger->is_enabled( level ) )
             {
                 try
                 {
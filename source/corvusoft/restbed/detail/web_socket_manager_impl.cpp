@@ -158,6 +158,36 @@ namespace restbed
         }
         
         Bytes WebSocketManagerImpl::compose( const shared_ptr< WebSocketMessage >& message )
+        {
+            auto frame = compose_header( message );
+            const auto& data = message->get_data( );
+            
+            if ( message->get_mask_flag( ) )
+            {
+                const auto masking_key = message->get_mask( );
+                
+                uint8_t mask[ 4 ] = { };
+                mask[ 0 ] =   masking_key         & 0xFF;
+                mask[ 1 ] = ( masking_key >>  8 ) & 0xFF;
+                mask[ 2 ] = ( masking_key >> 16 ) & 0xFF;
+                mask[ 3 ] = ( masking_key >> 24 ) & 0xFF;
+                
+                frame.reserve( frame.size( ) + data.size( ) );
+                
+                for ( size_t index = 0; index < data.size( ); index++ )
+                {
+                    frame.push_back( data[ index ] ^ mask[ index % 4 ] );
+                }
+            }
+            else
+            {
+                frame.insert( frame.end( ), data.begin( ), data.end( ) );
+            }
+            
+            return frame;
+        }
+        
+        Bytes WebSocketManagerImpl::compose_header( const shared_ptr< WebSocketMessage >& message )
         {
             Byte byte = 0x80;
             
@@ -238,20 +268,6 @@ namespace restbed
                 frame.push_back( mask[ 2 ] );
                 frame.push_back( mask[ 1 ] );
                 frame.push_back( mask[ 0 ] );
-                
-                auto data = message->get_data( );
-                
-                for ( size_t index = 0; index < data.size( ); index++ )
-                {
-                    auto datum = data.at( index );
-                    datum ^= mask[ index % 4 ];
-                    frame.push_back( datum );
-                }
-            }
-            else
-            {
-                auto data = message->get_data( );
-                frame.insert( frame.end( ), data.begin( ), data.end( ) );
             }
             
             return frame;
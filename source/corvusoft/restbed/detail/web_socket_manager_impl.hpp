@@ -50,6 +50,9 @@ namespace restbed
 
                 Bytes compose( const std::shared_ptr< WebSocketMessage >& message );
 
+                //Frame header only, including any masking key; an unmasked payload may then be written straight from the message.
+                Bytes compose_header( const std::shared_ptr< WebSocketMessage >& message );
+
                 std::shared_ptr< WebSocket > create( const std::shared_ptr< Session >& session );
 
                 std::shared_ptr< WebSocket > read( const std::string& key );
@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 #include <ciso646>
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
 #include <clocale>
@@ -24,12 +25,15 @@
 #include "corvusoft/restbed/detail/socket_impl.hpp"
 #include "corvusoft/restbed/detail/request_impl.hpp"
 #include "corvusoft/restbed/detail/response_impl.hpp"
+#include "corvusoft/restbed/detail/http2_stream_impl.hpp"
+#include "corvusoft/restbed/detail/http2_connection_impl.hpp"
 
 //External Includes
 #include <asio/error.hpp>
 #include <asio/buffer.hpp>
 
 //System Namespaces
+using std::min;
 using std::free;
 using std::bind;
 using std::string;
@@ -90,7 +94,7 @@ namespace restbed
         data += "\r\n";
         
         auto bytes = String::to_bytes( data );
-        auto body = value->get_body( );
+        const auto& body = value->get_body( );
         
         if ( not body.empty( ) )
         {
@@ -102,7 +106,14 @@ namespace restbed
     
     void Http::close( const shared_ptr< Request >& value )
     {
-        if ( value not_eq nullptr and value->m_pimpl->m_socket not_eq nullptr )
+        //A stream is cancelled on its own; the connection it shares stays up for other requests.
+        if ( value not_eq nullptr and value->m_pimpl->m_stream not_eq nullptr )
+        {
+            const auto stream = value->m_pimpl->m_stream;
+            stream->m_connection->reset( stream );
+            stream->m_reset = true;
+        }
+        else if ( value not_eq nullptr and value->m_pimpl->m_socket not_eq nullptr )
         {
             value->m_pimpl->m_socket->close( );
         }
@@ -110,6 +121,11 @@ namespace restbed
     
     bool Http::is_open( const shared_ptr< Request >& value )
     {
+        if ( value not_eq nullptr and value->m_pimpl->m_stream not_eq nullptr )
+        {
+            return not value->m_pimpl->m_stream->m_reset;
+        }
+        
         if ( value not_eq nullptr and value->m_pimpl->m_socket not_eq nullptr )
         {
             return value->m_pimpl->m_socket->is_open( );
@@ -141,6 +157,20 @@ namespace restbed
         }
         
 #endif
+        
+        if ( settings->get_http2_enabled( ) )
+        {
+            const auto connection = HttpImpl::http2_connect( request, settings );
+            
+            if ( connection not_eq nullptr )
+            {
+                request->m_pimpl->m_response = make_shared< Response >( );
+                request->m_pimpl->m_response->m_pimpl->m_request = request.get( );
+                
+                return HttpImpl::http2_async( connection, request, callback, settings );
+            }
+        }
+        
         bool finished = true;
         auto completion_handler = callback;
         
@@ -199,7 +229,7 @@ namespace restbed
         
         auto request = response->m_pimpl->m_request;
         
-        if ( request == nullptr or request->m_pimpl->m_buffer == nullptr or request->m_pimpl->m_socket == nullptr )
+        if ( request == nullptr or request->m_pimpl->m_buffer == nullptr or ( request->m_pimpl->m_socket == nullptr and request->m_pimpl->m_stream == nullptr ) )
         {
             throw invalid_argument( String::empty );
         }
@@ -211,16 +241,25 @@ namespace restbed
             error_code error;
             const size_t size = length - request->m_pimpl->m_buffer->size( );
 
-            request->m_pimpl->m_socket->start_read( request->m_pimpl->m_buffer, size, error );
+            if ( request->m_pimpl->m_stream not_eq nullptr )
+            {
+                HttpImpl::http2_read( request->m_pimpl->m_stream, size, error );
+            }
+            else
+            {
+                request->m_pimpl->m_socket->start_read( request->m_pimpl->m_buffer, size, error );
+            }
             
             if ( error and error not_eq asio::error::eof )
             {
                 throw runtime_error( String::format( "Socket receive failed: '%s'", error.message( ).data( ) ) );
             }
             
+            //A body that ends early yields what arrived.
+            const auto available = min( length, request->m_pimpl->m_buffer->size( ) );
             const auto data_ptr = asio::buffer_cast< const Byte* >( request->m_pimpl->m_buffer->data( ) );
-            data = Bytes( data_ptr, data_ptr + length );
-            request->m_pimpl->m_buffer->consume( length );
+            data = Bytes( data_ptr, data_ptr + available );
+            request->m_pimpl->m_buffer->consume( available );
         }
         else
         {
@@ -229,16 +268,7 @@ namespace restbed
             request->m_pimpl->m_buffer->consume( length );
         }
         
-        auto& body = response->m_pimpl->m_body;
-        
-        if ( body.empty( ) )
-        {
-            body = data;
-        }
-        else
-        {
-            body.insert( body.end( ), data.begin( ), data.end( ) );
-        }
+        response->m_pimpl->m_body.append( data );
         
         return data;
     }
@@ -252,13 +282,13 @@ namespace restbed
         
         auto request = response->m_pimpl->m_request;
         
-        if ( request == nullptr or request->m_pimpl->m_buffer == nullptr or request->m_pimpl->m_socket == nullptr )
+        if ( request == nullptr or request->m_pimpl->m_buffer == nullptr or ( request->m_pimpl->m_socket == nullptr and request->m_pimpl->m_stream == nullptr ) )
         {
             throw invalid_argument( String::empty );
         }
         
         error_code error;
-        const size_t size = request->m_pimpl->m_socket->start_read( request->m_pimpl->m_buffer, delimiter, error );
+        const size_t size = ( request->m_pimpl->m_stream not_eq nullptr ) ? HttpImpl::http2_read( request->m_pimpl->m_stream, delimiter, error ) : request->m_pimpl->m_socket->start_read( request->m_pimpl->m_buffer, delimiter, error );
         
         if ( error )
         {
@@ -269,16 +299,7 @@ namespace restbed
         const Bytes data( data_ptr, data_ptr + size );
         request->m_pimpl->m_buffer->consume( size );
         
-        auto& body = response->m_pimpl->m_body;
-        
-        if ( body.empty( ) )
-        {
-            body = data;
-        }
-        else
-        {
-            body.insert( body.end( ), data.begin( ), data.end( ) );
-        }
+        response->m_pimpl->m_body.append( data );
         
         return data;
     }
@@ -54,6 +54,11 @@ namespace restbed
             
             virtual void log_if( bool expression, const Level level, const char* format, ... ) = 0;
             
+            virtual bool is_enabled( const Level ) const
+            {
+                return true;
+            }
+            
             //Getters
             
             //Setters
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <ciso646>
+#include <stdexcept>
+
+//Project Includes
+#include "corvusoft/restbed/body_file.hpp"
+#include "corvusoft/restbed/multipart_parser.hpp"
+#include "corvusoft/restbed/detail/multipart_parser_impl.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::size_t;
+using std::string;
+using std::function;
+using std::multimap;
+using std::shared_ptr;
+using std::invalid_argument;
+
+//Project Namespaces
+using restbed::detail::MultipartParserImpl;
+
+//External Namespaces
+
+namespace restbed
+{
+    MultipartParser::MultipartParser( const string& boundary ) : m_pimpl( new MultipartParserImpl )
+    {
+        m_pimpl->setup( boundary );
+    }
+    
+    MultipartParser::~MultipartParser( void )
+    {
+        return;
+    }
+    
+    void MultipartParser::parse( const Bytes& data )
+    {
+        parse( data.data( ), data.size( ) );
+    }
+    
+    void MultipartParser::parse( const Byte* data, const size_t length )
+    {
+        auto& pending = m_pimpl->m_pending;
+        
+        if ( pending.empty( ) )
+        {
+            const auto consumed = m_pimpl->process( data, length );
+            pending.assign( data + consumed, data + length );
+            return;
+        }
+        
+        pending.insert( pending.end( ), data, data + length );
+        
+        const auto consumed = m_pimpl->process( pending.data( ), pending.size( ) );
+        pending.erase( pending.begin( ), pending.begin( ) + consumed );
+    }
+    
+    void MultipartParser::finish( void )
+    {
+        if ( not is_complete( ) )
+        {
+            throw invalid_argument( "Multipart body ended before its closing boundary." );
+        }
+    }
+    
+    bool MultipartParser::is_complete( void ) const
+    {
+        return m_pimpl->m_state == MultipartParserImpl::EPILOGUE;
+    }
+    
+    string MultipartParser::get_boundary( void ) const
+    {
+        return m_pimpl->m_boundary;
+    }
+    
+    string MultipartParser::get_spill_directory( void ) const
+    {
+        return m_pimpl->m_spill_directory;
+    }
+    
+    void MultipartParser::set_spill_directory( const string& value )
+    {
+        m_pimpl->m_spill_directory = value;
+    }
+    
+    void MultipartParser::set_part_start_handler( const function< void ( const multimap< string, string >& ) >& value )
+    {
+        m_pimpl->m_part_start_handler = value;
+    }
+    
+    void MultipartParser::set_part_data_handler( const function< void ( const Bytes& ) >& value )
+    {
+        m_pimpl->m_part_data_handler = value;
+    }
+    
+    void MultipartParser::set_part_end_handler( const function< void ( const shared_ptr< const BodyFile > ) >& value )
+    {
+        m_pimpl->m_part_end_handler = value;
+    }
+}
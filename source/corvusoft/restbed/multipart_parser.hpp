@@ -0,0 +1,111 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <map>
+#include <string>
+#include <memory>
+#include <cstddef>
+#include <functional>
+
+//Project Includes
+#include <corvusoft/restbed/byte.hpp>
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    class BodyFile;
+    
+    namespace detail
+    {
+        struct MultipartParserImpl;
+    }
+    
+    class MultipartParser
+    {
+        public:
+            //Friends
+            
+            //Definitions
+            
+            //Constructors
+            explicit MultipartParser( const std::string& boundary );
+            
+            virtual ~MultipartParser( void );
+            
+            //Functionality
+            void parse( const Bytes& data );
+            
+            void parse( const Byte* data, const std::size_t length );
+            
+            void finish( void );
+            
+            bool is_complete( void ) const;
+            
+            //Getters
+            std::string get_boundary( void ) const;
+            
+            std::string get_spill_directory( void ) const;
+            
+            //Setters
+            void set_spill_directory( const std::string& value );
+            
+            void set_part_start_handler( const std::function< void ( const std::multimap< std::string, std::string >& ) >& value );
+            
+            void set_part_data_handler( const std::function< void ( const Bytes& ) >& value );
+            
+            void set_part_end_handler( const std::function< void ( const std::shared_ptr< const BodyFile > ) >& value );
+            
+            //Operators
+            
+            //Properties
+        
+        protected:
+            //Friends
+            
+            //Definitions
+            
+            //Constructors
+            
+            //Functionality
+            
+            //Getters
+            
+            //Setters
+            
+            //Operators
+            
+            //Properties
+        
+        private:
+            //Friends
+            
+            //Definitions
+            
+            //Constructors
+            MultipartParser( const MultipartParser& original ) = delete;
+            
+            //Functionality
+            
+            //Getters
+            
+            //Setters
+            
+            //Operators
+            MultipartParser& operator =( const MultipartParser& value ) = delete;
+            
+            //Properties
+            std::unique_ptr< detail::MultipartParserImpl > m_pimpl;
+    };
+}
@@ -21,8 +21,6 @@
 //System Namespaces
 using std::map;
 using std::pair;
-using std::stof;
-using std::stod;
 using std::string;
 using std::function;
 using std::multimap;
@@ -30,8 +28,6 @@ using std::make_pair;
 using std::unique_ptr;
 using std::shared_ptr;
 using std::make_shared;
-using std::out_of_range;
-using std::invalid_argument;
 
 //Project Namespaces
 using restbed::Common;
@@ -73,7 +69,7 @@ namespace restbed
     
     bool Request::has_header( const string& name ) const
     {
-        return Common::has_parameter( name, m_pimpl->m_headers );
+        return m_pimpl->m_headers.contains( name );
     }
     
     bool Request::has_path_parameter( const string& name ) const
@@ -98,7 +94,12 @@ namespace restbed
     
     const Bytes& Request::get_body( void ) const
     {
-        return m_pimpl->m_body;
+        return m_pimpl->m_body.flatten( );
+    }
+    
+    shared_ptr< const BodyFile > Request::get_body_file( void ) const
+    {
+        return m_pimpl->m_body_file;
     }
     
     const shared_ptr< const Response > Request::get_response( void ) const
@@ -128,47 +129,22 @@ namespace restbed
     
     void Request::get_body( string& body, const function< string ( const Bytes& ) >& transform ) const
     {
-        body = ( transform == nullptr ) ? String::to_string( m_pimpl->m_body ) : transform( m_pimpl->m_body );
+        body = ( transform == nullptr ) ? m_pimpl->m_body.to_string( ) : transform( m_pimpl->m_body.flatten( ) );
+    }
+    
+    void Request::get_body( BufferChain& body ) const
+    {
+        body = m_pimpl->m_body;
     }
     
     float Request::get_header( const string& name, const float default_value ) const
     {
-        float header = 0;
-        
-        try
-        {
-            header = stof( get_header( name ) );
-        }
-        catch ( const out_of_range )
-        {
-            header = default_value;
-        }
-        catch ( const invalid_argument )
-        {
-            header = default_value;
-        }
-        
-        return header;
+        return Common::parse_parameter( get_header_view( name ), default_value );
     }
     
     double Request::get_header( const string& name, const double default_value ) const
     {
-        double header = 0;
-        
-        try
-        {
-            header = stod( get_header( name ) );
-        }
-        catch ( const out_of_range )
-        {
-            header = default_value;
-        }
-        catch ( const invalid_argument )
-        {
-            header = default_value;
-        }
-        
-        return header;
+        return Common::parse_parameter( get_header_view( name ), default_value );
     }
     
     string Request::get_header( const string& name, const string& default_value ) const
@@ -178,8 +154,8 @@ namespace restbed
             return default_value;
         }
         
-        const auto headers = Common::get_parameters( name, m_pimpl->m_headers );
-        return ( headers.empty( ) ) ? default_value : headers.begin( )->second;
+        const auto header = m_pimpl->m_headers.find( name );
+        return ( header == nullptr ) ? default_value : *header;
     }
     
     string Request::get_header( const string& name, const function< string ( const string& ) >& transform ) const
@@ -189,55 +165,28 @@ namespace restbed
             return String::empty;
         }
         
-        const auto headers = Common::get_parameters( name, m_pimpl->m_headers );
-        const auto value = ( headers.empty( ) ) ? String::empty : headers.begin( )->second;
-        
-        return Common::transform( value, transform );
+        return Common::transform( get_header_view( name ), transform );
+    }
+    
+    const string& Request::get_header_view( const string& name ) const
+    {
+        const auto header = m_pimpl->m_headers.find( name );
+        return ( header == nullptr ) ? String::empty : *header;
     }
     
     multimap< string, string > Request::get_headers( const string& name ) const
     {
-        return Common::get_parameters( name, m_pimpl->m_headers );
+        return m_pimpl->m_headers.get_values( name );
     }
     
     float Request::get_query_parameter( const string& name, const float default_value ) const
     {
-        float parameter = 0;
-        
-        try
-        {
-            parameter = stof( get_query_parameter( name ) );
-        }
-        catch ( const out_of_range )
-        {
-            parameter = default_value;
-        }
-        catch ( const invalid_argument )
-        {
-            parameter = default_value;
-        }
-        
-        return parameter;
+        return Common::parse_parameter( get_query_parameter( name ), default_value );
     }
     
     double Request::get_query_parameter( const string& name, const double default_value ) const
     {
-        double parameter = 0;
-        
-        try
-        {
-            parameter = stod( get_query_parameter( name ) );
-        }
-        catch ( const out_of_range )
-        {
-            parameter = default_value;
-        }
-        catch ( const invalid_argument )
-        {
-            parameter = default_value;
-        }
-        
-        return parameter;
+        return Common::parse_parameter( get_query_parameter( name ), default_value );
     }
     
     string Request::get_query_parameter( const string& name, const string& default_value ) const
@@ -247,8 +196,8 @@ namespace restbed
             return default_value;
         }
         
-        const auto parameters = Common::get_parameters( name, m_pimpl->m_query_parameters );
-        return ( parameters.empty( ) ) ? default_value : parameters.begin( )->second;
+        const auto parameter = Common::find_parameter( name, m_pimpl->m_query_parameters );
+        return ( parameter == nullptr ) ? default_value : *parameter;
     }
     
     string Request::get_query_parameter( const string& name, const function< string ( const string& ) >& transform ) const
@@ -258,8 +207,8 @@ namespace restbed
             return String::empty;
         }
         
-        const auto parameters = Common::get_parameters( name, m_pimpl->m_query_parameters );
-        const auto value = ( parameters.empty( ) ) ? String::empty : parameters.begin( )->second;
+        const auto parameter = Common::find_parameter( name, m_pimpl->m_query_parameters );
+        const auto& value = ( parameter == nullptr ) ? String::empty : *parameter;
         
         return Common::transform( value, transform );
     }
@@ -271,42 +220,12 @@ namespace restbed
     
     float Request::get_path_parameter( const string& name, const float default_value ) const
     {
-        float parameter = 0;
-        
-        try
-        {
-            parameter = stof( get_path_parameter( name ) );
-        }
-        catch ( const out_of_range )
-        {
-            parameter = default_value;
-        }
-        catch ( const invalid_argument )
-        {
-            parameter = default_value;
-        }
-        
-        return parameter;
+        return Common::parse_parameter( get_path_parameter( name ), default_value );
     }
     
     double Request::get_path_parameter( const string& name, const double default_value ) const
     {
-        double parameter = 0;
-        
-        try
-        {
-            parameter = stod( get_path_parameter( name ) );
-        }
-        catch ( const out_of_range )
-        {
-            parameter = default_value;
-        }
-        catch ( const invalid_argument )
-        {
-            parameter = default_value;
-        }
-        
-        return parameter;
+        return Common::parse_parameter( get_path_parameter( name ), default_value );
     }
     
     string Request::get_path_parameter( const string& name, const string& default_value ) const
@@ -316,8 +235,8 @@ namespace restbed
             return default_value;
         }
         
-        const auto parameters = Common::get_parameters( name, m_pimpl->m_path_parameters );
-        return ( parameters.empty( ) ) ? default_value : parameters.begin( )->second;
+        const auto parameter = Common::find_parameter( name, m_pimpl->m_path_parameters );
+        return ( parameter == nullptr ) ? default_value : *parameter;
     }
     
     string Request::get_path_parameter( const string& name, const function< string ( const string& ) >& transform ) const
@@ -327,8 +246,8 @@ namespace restbed
             return String::empty;
         }
         
-        const auto parameters = Common::get_parameters( name, m_pimpl->m_path_parameters );
-        const auto value = ( parameters.empty( ) ) ? String::empty : parameters.begin( )->second;
+        const auto parameter = Common::find_parameter( name, m_pimpl->m_path_parameters );
+        const auto& value = ( parameter == nullptr ) ? String::empty : *parameter;
         
         return Common::transform( value, transform );
     }
@@ -340,12 +259,17 @@ namespace restbed
     
     void Request::set_body( const Bytes& value )
     {
-        m_pimpl->m_body = value;
+        m_pimpl->m_body = BufferChain( value );
     }
     
     void Request::set_body( const string& value )
     {
-        m_pimpl->m_body = String::to_bytes( value );
+        m_pimpl->m_body = BufferChain( value );
+    }
+    
+    void Request::set_body( const BufferChain& value )
+    {
+        m_pimpl->m_body = value;
     }
     
     void Request::set_port( const uint16_t value )
@@ -390,18 +314,17 @@ namespace restbed
     
     void Request::add_header( const string& name, const string& value )
     {
-        m_pimpl->m_headers.insert( make_pair( name, value ) );
+        m_pimpl->m_headers.add( name, value );
     }
     
     void Request::set_header( const string& name, const string& value )
     {
-        m_pimpl->m_headers.erase( name );
-        m_pimpl->m_headers.insert( make_pair( name, value ) );
+        m_pimpl->m_headers.set( name, value );
     }
     
     void Request::set_headers( const multimap< string, string >& values )
     {
-        m_pimpl->m_headers = values;
+        m_pimpl->m_headers.set_values( values );
     }
     
     void Request::set_query_parameter( const string& name, const string& value )
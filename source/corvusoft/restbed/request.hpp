@@ -15,6 +15,7 @@
 
 //Project Includes
 #include <corvusoft/restbed/byte.hpp>
+#include <corvusoft/restbed/buffer_chain.hpp>
 #include <corvusoft/restbed/common.hpp>
 
 //External Includes
@@ -30,6 +31,7 @@ namespace restbed
     //Forward Declarations
     class Uri;
     class Http;
+    class BodyFile;
     class Session;
     class Response;
     
@@ -70,6 +72,8 @@ namespace restbed
             
             const Bytes& get_body( void ) const;
             
+            std::shared_ptr< const BodyFile > get_body_file( void ) const;
+            
             const std::shared_ptr< const Response > get_response( void ) const;
             
             std::string get_host( const std::function< std::string ( const std::string& ) >& transform = nullptr ) const;
@@ -82,6 +86,8 @@ namespace restbed
             
             void get_body( std::string& body, const std::function< std::string ( const Bytes& ) >& transform = nullptr ) const;
             
+            void get_body( BufferChain& body ) const;
+            
             float get_header( const std::string& name, const float default_value ) const;
             
             double get_header( const std::string& name, const double default_value ) const;
@@ -93,9 +99,11 @@ namespace restbed
             template< typename Type, typename std::enable_if< std::is_arithmetic< Type >::value, Type >::type = 0 >
             Type get_header( const std::string& name, const Type default_value ) const
             {
-                return Common::parse_parameter( get_header( name ), default_value );
+                return Common::parse_parameter( get_header_view( name ), default_value );
             }
             
+            const std::string& get_header_view( const std::string& name ) const;
+            
             std::multimap< std::string, std::string > get_headers( const std::string& name = "" ) const;
             
             float get_query_parameter( const std::string& name, const float default_value ) const;
@@ -135,6 +143,8 @@ namespace restbed
             
             void set_body( const std::string& value );
             
+            void set_body( const BufferChain& value );
+            
             void set_port( const uint16_t value );
             
             void set_version( const double value );
@@ -23,14 +23,18 @@
 //System Namespaces
 using std::set;
 using std::string;
+using std::vector;
 using std::multimap;
 using std::function;
 using std::exception;
 using std::unique_ptr;
 using std::shared_ptr;
+using std::size_t;
 using std::invalid_argument;
 
 //Project Namespaces
+using restbed::detail::FilterImpl;
+using restbed::detail::MethodImpl;
 using restbed::detail::ResourceImpl;
 
 //External Namespaces
@@ -51,12 +55,7 @@ namespace restbed
     {
         if ( rule not_eq nullptr )
         {
-            m_pimpl->m_rules.push_back( rule );
-            
-            stable_sort( m_pimpl->m_rules.begin( ), m_pimpl->m_rules.end( ), [ ]( const shared_ptr< const Rule >& lhs, const shared_ptr< const Rule >& rhs )
-            {
-                return lhs->get_priority( ) < rhs->get_priority( );
-            } );
+            m_pimpl->m_rules.add( rule );
         }
     }
     
@@ -119,8 +118,23 @@ namespace restbed
         
         if ( callback not_eq nullptr )
         {
-            m_pimpl->m_methods.insert( method );
-            m_pimpl->m_method_handlers.insert( make_pair( method, make_pair( filters, callback ) ) );
+            vector< FilterImpl > compiled_filters;
+            compiled_filters.reserve( filters.size( ) );
+            
+            for ( const auto& filter : filters )
+            {
+                compiled_filters.push_back( FilterImpl( filter.first, filter.second ) );
+            }
+            
+            const auto identifier = static_cast< size_t >( MethodImpl::intern( method ) );
+            
+            if ( identifier >= m_pimpl->m_method_handlers.size( ) )
+            {
+                m_pimpl->m_method_handlers.resize( identifier + 1 );
+            }
+            
+            m_pimpl->m_methods.set( identifier );
+            m_pimpl->m_method_handlers[ identifier ].push_back( make_pair( compiled_filters, callback ) );
         }
     }
 }
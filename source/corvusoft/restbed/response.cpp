@@ -46,12 +46,12 @@ namespace restbed
     
     bool Response::has_header( const string& name ) const
     {
-        return Common::has_parameter( name, m_pimpl->m_headers );
+        return m_pimpl->m_headers.contains( name );
     }
     
-    Bytes Response::get_body( void ) const
+    const Bytes& Response::get_body( void ) const
     {
-        return m_pimpl->m_body;
+        return m_pimpl->m_body.flatten( );
     }
     
     double Response::get_version( void ) const
@@ -76,7 +76,12 @@ namespace restbed
     
     void Response::get_body( string& body, const function< string ( const Bytes& ) >& transform ) const
     {
-        body = ( transform == nullptr ) ? string( m_pimpl->m_body.begin( ), m_pimpl->m_body.end( ) ) : transform( m_pimpl->m_body );
+        body = ( transform == nullptr ) ? m_pimpl->m_body.to_string( ) : transform( m_pimpl->m_body.flatten( ) );
+    }
+    
+    void Response::get_body( BufferChain& body ) const
+    {
+        body = m_pimpl->m_body;
     }
     
     string Response::get_header( const string& name, const string& default_value ) const
@@ -86,8 +91,8 @@ namespace restbed
             return default_value;
         }
         
-        const auto headers = Common::get_parameters( name, m_pimpl->m_headers );
-        return ( headers.empty( ) ) ? default_value : headers.begin( )->second;
+        const auto header = m_pimpl->m_headers.find( name );
+        return ( header == nullptr ) ? default_value : *header;
     }
     
     string Response::get_header( const string& name, const function< string ( const string& ) >& transform ) const
@@ -97,25 +102,38 @@ namespace restbed
             return String::empty;
         }
         
-        const auto headers = Common::get_parameters( name, m_pimpl->m_headers );
-        const auto value = ( headers.empty( ) ) ? String::empty : headers.begin( )->second;
-        
-        return Common::transform( value, transform );
+        return Common::transform( get_header_view( name ), transform );
+    }
+    
+    const string& Response::get_header_view( const string& name ) const
+    {
+        const auto header = m_pimpl->m_headers.find( name );
+        return ( header == nullptr ) ? String::empty : *header;
     }
     
     multimap< string, string > Response::get_headers( const string& name ) const
     {
-        return Common::get_parameters( name, m_pimpl->m_headers );
+        return m_pimpl->m_headers.get_values( name );
+    }
+    
+    void Response::set_body( Bytes&& value )
+    {
+        m_pimpl->m_body = BufferChain( std::move( value ) );
     }
     
     void Response::set_body( const Bytes& value )
     {
-        m_pimpl->m_body = value;
+        m_pimpl->m_body = BufferChain( value );
     }
     
     void Response::set_body( const string& value )
     {
-        m_pimpl->m_body = String::to_bytes( value );
+        m_pimpl->m_body = BufferChain( value );
+    }
+    
+    void Response::set_body( const BufferChain& value )
+    {
+        m_pimpl->m_body = value;
     }
     
     void Response::set_version( const double value )
@@ -140,17 +158,16 @@ namespace restbed
     
     void Response::add_header( const string& name, const string& value )
     {
-        m_pimpl->m_headers.insert( make_pair( name, value ) );
+        m_pimpl->m_headers.add( name, value );
     }
 
     void Response::set_header( const string& name, const string& value )
     {
-        m_pimpl->m_headers.erase( name );
-        m_pimpl->m_headers.insert( make_pair( name, value ) );
+        m_pimpl->m_headers.set( name, value );
     }
 
     void Response::set_headers( const multimap< string, string >& values )
     {
-        m_pimpl->m_headers = values;
+        m_pimpl->m_headers.set_values( values );
     }
 }
@@ -14,6 +14,7 @@
 
 //Project Includes
 #include <corvusoft/restbed/byte.hpp>
+#include <corvusoft/restbed/buffer_chain.hpp>
 #include <corvusoft/restbed/common.hpp>
 
 //External Includes
@@ -31,6 +32,7 @@ namespace restbed
     
     namespace detail
     {
+        class SessionImpl;
         struct ResponseImpl;
     }
     
@@ -50,7 +52,7 @@ namespace restbed
             bool has_header( const std::string& name ) const;
             
             //Getters
-            Bytes get_body( void ) const;
+            const Bytes& get_body( void ) const;
             
             double get_version( void ) const;
             
@@ -62,23 +64,31 @@ namespace restbed
             
             void get_body( std::string& body, const std::function< std::string ( const Bytes& ) >& transform = nullptr ) const;
             
+            void get_body( BufferChain& body ) const;
+            
             template< typename Type, typename std::enable_if< std::is_arithmetic< Type >::value, Type >::type = 0 >
             Type get_header( const std::string& name, const Type default_value ) const
             {
-                return Common::parse_parameter( get_header( name ), default_value );
+                return Common::parse_parameter( get_header_view( name ), default_value );
             }
             
             std::string get_header( const std::string& name, const std::string& default_value ) const;
             
             std::string get_header( const std::string& name, const std::function< std::string ( const std::string& ) >& transform = nullptr ) const;
             
+            const std::string& get_header_view( const std::string& name ) const;
+            
             std::multimap< std::string, std::string > get_headers( const std::string& name = "" ) const;
             
             //Setters
+            void set_body( Bytes&& value );
+            
             void set_body( const Bytes& value );
             
             void set_body( const std::string& value );
             
+            void set_body( const BufferChain& value );
+            
             void set_version( const double value );
             
             void set_status_code( const int value );
@@ -118,6 +128,8 @@ namespace restbed
             //Friends
             friend Http;
             
+            friend detail::SessionImpl;
+            
             //Definitions
             
             //Constructors
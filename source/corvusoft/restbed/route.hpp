@@ -0,0 +1,266 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <map>
+#include <tuple>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <ciso646>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+
+//Project Includes
+#include <corvusoft/restbed/common.hpp>
+#include <corvusoft/restbed/request.hpp>
+#include <corvusoft/restbed/session.hpp>
+#include <corvusoft/restbed/resource.hpp>
+#include <corvusoft/restbed/status_code.hpp>
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    
+    template< typename... Types >
+    class Route
+    {
+        public:
+            //Friends
+            
+            //Definitions
+            typedef std::function< void ( const std::shared_ptr< Session >, const Types&... ) > Handler;
+            
+            //Constructors
+            explicit Route( const std::string& path ) : m_names( ),
+                m_resource( std::make_shared< Resource >( ) )
+            {
+                static const std::vector< std::string > kinds = { Parameter< Types >::get_kind( )... };
+                static const std::vector< std::string > patterns = { Parameter< Types >::get_pattern( )... };
+                
+                std::string route = "";
+                std::string::size_type position = 0;
+                
+                while ( position < path.length( ) )
+                {
+                    const auto start = path.find( '{', position );
+                    
+                    if ( start == std::string::npos )
+                    {
+                        route.append( path, position, std::string::npos );
+                        break;
+                    }
+                    
+                    const auto end = path.find( '}', start );
+                    
+                    if ( end == std::string::npos )
+                    {
+                        throw std::invalid_argument( "Route path parameter declaration is unterminated: " + path );
+                    }
+                    
+                    const auto index = m_names.size( );
+                    
+                    if ( index == sizeof...( Types ) )
+                    {
+                        throw std::invalid_argument( "Route path declares more parameters than its types: " + path );
+                    }
+                    
+                    const auto declaration = path.substr( start + 1, end - start - 1 );
+                    const auto colon = declaration.find( ':' );
+                    const auto name = strip( declaration.substr( 0, colon ) );
+                    
+                    if ( name.empty( ) )
+                    {
+                        throw std::invalid_argument( "Route path parameter is unnamed: " + path );
+                    }
+                    
+                    if ( colon not_eq std::string::npos and strip( declaration.substr( colon + 1 ) ) not_eq kinds[ index ] )
+                    {
+                        throw std::invalid_argument( "Route path parameter '" + name + "' must be declared as '" + kinds[ index ] + "': " + path );
+                    }
+                    
+                    route.append( path, position, start - position );
+                    route.append( "{" + name + ": " + patterns[ index ] + "}" );
+                    
+                    m_names.push_back( name );
+                    position = end + 1;
+                }
+                
+                if ( m_names.size( ) not_eq sizeof...( Types ) )
+                {
+                    throw std::invalid_argument( "Route path declares fewer parameters than its types: " + path );
+                }
+                
+                m_resource->set_path( route );
+            }
+            
+            virtual ~Route( void )
+            {
+                return;
+            }
+            
+            //Functionality
+            
+            //Getters
+            std::shared_ptr< Resource > get_resource( void ) const
+            {
+                return m_resource;
+            }
+            
+            //Setters
+            void set_method_handler( const std::string& method, const Handler& callback )
+            {
+                static const std::multimap< std::string, std::string > empty { };
+                set_method_handler( method, empty, callback );
+            }
+            
+            void set_method_handler( const std::string& method, const std::multimap< std::string, std::string >& filters, const Handler& callback )
+            {
+                if ( callback == nullptr )
+                {
+                    return m_resource->set_method_handler( method, filters, nullptr );
+                }
+                
+                const auto names = m_names;
+                
+                m_resource->set_method_handler( method, filters, [ names, callback ]( const std::shared_ptr< Session > session )
+                {
+                    dispatch( session, names, callback, typename Sequence< sizeof...( Types ) >::type( ) );
+                } );
+            }
+            
+            //Operators
+            
+            //Properties
+        
+        protected:
+            //Friends
+            
+            //Definitions
+            
+            //Constructors
+            
+            //Functionality
+            
+            //Getters
+            
+            //Setters
+            
+            //Operators
+            
+            //Properties
+        
+        private:
+            //Friends
+            
+            //Definitions
+            template< typename Type >
+            struct Parameter
+            {
+                static_assert( std::is_same< Type, std::string >::value or std::is_same< Type, bool >::value or std::is_floating_point< Type >::value or
+                               ( std::is_integral< Type >::value and not std::is_same< Type, char >::value and not std::is_same< Type, signed char >::value and
+                                 not std::is_same< Type, unsigned char >::value and not std::is_same< Type, wchar_t >::value and
+                                 not std::is_same< Type, char16_t >::value and not std::is_same< Type, char32_t >::value ),
+                               "Route parameters must be bool, a non-character integer, a floating point number or std::string." );
+                
+                static const char* get_kind( void )
+                {
+                    return std::is_same< Type, std::string >::value ? "string" :
+                           std::is_same< Type, bool >::value ? "bool" :
+                           std::is_floating_point< Type >::value ? "float" :
+                           std::is_signed< Type >::value ? "int" : "uint";
+                }
+                
+                static const char* get_pattern( void )
+                {
+                    return std::is_same< Type, std::string >::value ? ".+" :
+                           std::is_same< Type, bool >::value ? "(true|false|0|1)" :
+                           std::is_floating_point< Type >::value ? "[-+]?([0-9]+\\.?[0-9]*|\\.[0-9]+)([eE][-+]?[0-9]+)?" :
+                           std::is_signed< Type >::value ? "[-+]?[0-9]+" : "[+]?[0-9]+";
+                }
+            };
+            
+            template< std::size_t... Indexes >
+            struct Indices
+            {
+            };
+            
+            template< std::size_t Count, std::size_t... Indexes >
+            struct Sequence : Sequence< Count - 1, Count - 1, Indexes... >
+            {
+            };
+            
+            template< std::size_t... Indexes >
+            struct Sequence< 0, Indexes... >
+            {
+                typedef Indices< Indexes... > type;
+            };
+            
+            //Constructors
+            Route( void ) = delete;
+            
+            Route( const Route& original ) = delete;
+            
+            //Functionality
+            static std::string strip( const std::string& value )
+            {
+                const auto start = value.find_first_not_of( ' ' );
+                return ( start == std::string::npos ) ? "" : value.substr( start, value.find_last_not_of( ' ' ) - start + 1 );
+            }
+            
+            static bool convert( const std::string& value, std::string& result )
+            {
+                result = value;
+                return true;
+            }
+            
+            template< typename Type >
+            static bool convert( const std::string& value, Type& result )
+            {
+                return Common::parse( value, result );
+            }
+            
+            template< std::size_t... Indexes >
+            static void dispatch( const std::shared_ptr< Session > session, const std::vector< std::string >& names, const Handler& callback, Indices< Indexes... > )
+            {
+                std::tuple< Types... > values { };
+                const auto request = session->get_request( );
+                const bool converted[ ] = { true, convert( request->get_path_parameter( names[ Indexes ] ), std::get< Indexes >( values ) )... };
+                
+                for ( const auto success : converted )
+                {
+                    if ( not success )
+                    {
+                        return session->close( BAD_REQUEST );
+                    }
+                }
+                
+                callback( session, std::get< Indexes >( values )... );
+            }
+            
+            //Getters
+            
+            //Setters
+            
+            //Operators
+            Route& operator =( const Route& value ) = delete;
+            
+            //Properties
+            std::vector< std::string > m_names;
+            
+            std::shared_ptr< Resource > m_resource;
+    };
+}
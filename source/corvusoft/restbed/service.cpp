@@ -42,12 +42,12 @@ using std::string;
 using std::vector;
 using std::function;
 using std::exception;
+using std::uint64_t;
 using std::to_string;
 using std::unique_ptr;
 using std::shared_ptr;
 using std::error_code;
 using std::make_shared;
-using std::stable_sort;
 using std::runtime_error;
 using std::chrono::seconds;
 using std::invalid_argument;
@@ -156,10 +156,7 @@ namespace restbed
         
         m_pimpl->m_web_socket_manager = make_shared< WebSocketManagerImpl >( );
         
-        stable_sort( m_pimpl->m_rules.begin( ), m_pimpl->m_rules.end( ), [ ]( const shared_ptr< const Rule >& lhs, const shared_ptr< const Rule >& rhs )
-        {
-            return lhs->get_priority( ) < rhs->get_priority( );
-        } );
+        m_pimpl->m_rules.sort( );
         
         m_pimpl->http_start( );
 #ifdef BUILD_SSL
@@ -171,7 +168,7 @@ namespace restbed
             auto path = String::format( "/%s/%s", m_pimpl->m_settings->get_root( ).data( ), route.second.data( ) );
             path = String::replace( "//", "/", path );
             
-            m_pimpl->log( Logger::INFO, String::format( "Resource published on route '%s'.", path.data( ) ) );
+            m_pimpl->log( Logger::INFO, "Resource published on route '%s'.", path.data( ) );
         }
         
         if ( m_pimpl->m_ready_handler not_eq nullptr )
@@ -224,7 +221,7 @@ namespace restbed
         
         if ( rule not_eq nullptr )
         {
-            m_pimpl->m_rules.push_back( rule );
+            m_pimpl->m_rules.add( rule );
         }
     }
     
@@ -238,7 +235,7 @@ namespace restbed
         if ( rule not_eq nullptr )
         {
             rule->set_priority( priority );
-            m_pimpl->m_rules.push_back( rule );
+            m_pimpl->m_rules.add( rule );
         }
     }
     
@@ -269,8 +266,7 @@ namespace restbed
             m_pimpl->m_resource_routes[ sanitised_path ] = resource;
         }
         
-        const auto& methods = resource->m_pimpl->m_methods;
-        m_pimpl->m_supported_methods.insert( methods.begin( ), methods.end( ) );
+        m_pimpl->m_supported_methods |= resource->m_pimpl->m_methods;
     }
     
     void Service::suppress( const shared_ptr< const Resource >& resource )
@@ -289,11 +285,11 @@ namespace restbed
         {
             if ( m_pimpl->m_resource_routes.erase( path ) )
             {
-                m_pimpl->log( Logger::INFO, String::format( "Suppressed resource route '%s'.", path.data( ) ) );
+                m_pimpl->log( Logger::INFO, "Suppressed resource route '%s'.", path.data( ) );
             }
             else
             {
-                m_pimpl->log( Logger::WARNING, String::format( "Failed to suppress resource route '%s'; Not Found!", path.data( ) ) );
+                m_pimpl->log( Logger::WARNING, "Failed to suppress resource route '%s'; Not Found!", path.data( ) );
             }
         }
     }
@@ -450,4 +446,14 @@ namespace restbed
         
         m_pimpl->m_authentication_handler = value;
     }
+    
+    void Service::set_trace_handler( const function< void ( const TraceEvent, const uint64_t, const uint64_t, const steady_clock::time_point& ) >& value )
+    {
+        if ( is_up( ) )
+        {
+            throw runtime_error( "Runtime modifications of the service are prohibited." );
+        }
+        
+        m_pimpl->m_trace_handler = value;
+    }
 }
@@ -8,11 +8,13 @@
 #include <map>
 #include <chrono>
 #include <memory>
+#include <cstdint>
 #include <string>
 #include <stdexcept>
 #include <functional>
 
 //Project Includes
+#include <corvusoft/restbed/trace_event.hpp>
 
 //External Includes
 
@@ -99,6 +101,8 @@ namespace restbed
             
             void set_authentication_handler( const std::function< void ( const std::shared_ptr< Session >, const std::function< void ( const std::shared_ptr< Session > ) >& ) >& value );
             
+            void set_trace_handler( const std::function< void ( const TraceEvent, const std::uint64_t, const std::uint64_t, const std::chrono::steady_clock::time_point& ) >& value );
+            
             //Operators
             
             //Properties
@@ -3,6 +3,7 @@
  */
 
 //System Includes
+#include <utility>
 #include <ciso646>
 #include <system_error>
 
@@ -10,12 +11,16 @@
 #include "corvusoft/restbed/session.hpp"
 #include "corvusoft/restbed/request.hpp"
 #include "corvusoft/restbed/response.hpp"
+#include "corvusoft/restbed/settings.hpp"
 #include "corvusoft/restbed/web_socket.hpp"
+#include "corvusoft/restbed/multipart_parser.hpp"
+#include "corvusoft/restbed/urlencoded_parser.hpp"
 #include "corvusoft/restbed/context_value.hpp"
 #include "corvusoft/restbed/session_manager.hpp"
 #include "corvusoft/restbed/detail/socket_impl.hpp"
 #include "corvusoft/restbed/detail/request_impl.hpp"
 #include "corvusoft/restbed/detail/session_impl.hpp"
+#include "corvusoft/restbed/detail/http2_stream_impl.hpp"
 #include "corvusoft/restbed/detail/web_socket_impl.hpp"
 #include "corvusoft/restbed/detail/web_socket_manager_impl.hpp"
 
@@ -91,7 +96,8 @@ namespace restbed
     {
         return m_pimpl->m_request not_eq nullptr and
                m_pimpl->m_request->m_pimpl->m_socket not_eq nullptr and
-               m_pimpl->m_request->m_pimpl->m_socket->is_open( );
+               m_pimpl->m_request->m_pimpl->m_socket->is_open( ) and
+               ( m_pimpl->m_stream == nullptr or not m_pimpl->m_stream->m_reset );
     }
     
     bool Session::is_closed( void ) const
@@ -99,7 +105,22 @@ namespace restbed
         return not is_open( );
     }
     
+    void Session::close( Bytes&& body )
+    {
+        close( make_shared< const Bytes >( std::move( body ) ) );
+    }
+    
     void Session::close( const Bytes& body )
+    {
+        close( make_shared< const Bytes >( body ) );
+    }
+    
+    void Session::close( const shared_ptr< const Bytes >& body )
+    {
+        close( BufferChain( body ) );
+    }
+    
+    void Session::close( const BufferChain& body )
     {
         auto session = shared_from_this( );
         
@@ -109,7 +130,7 @@ namespace restbed
             return error_handler( 500, runtime_error( "Close failed: session already closed." ), session );
         }
         
-        m_pimpl->m_request->m_pimpl->m_socket->start_write( body, [ this, session ]( const error_code & error, size_t )
+        m_pimpl->write( body, true, [ this, session ]( const error_code & error, size_t )
         {
             if ( error )
             {
@@ -120,7 +141,33 @@ namespace restbed
             
             m_pimpl->m_manager->save( session, [ this, session ]( const shared_ptr< Session > )
             {
-                m_pimpl->m_request->m_pimpl->m_socket->close( );
+                m_pimpl->disconnect( );
+            } );
+        } );
+    }
+    
+    void Session::close( Response&& response )
+    {
+        auto session = shared_from_this( );
+        
+        if ( is_closed( ) )
+        {
+            const auto error_handler = m_pimpl->get_error_handler( );
+            return error_handler( 500, runtime_error( "Close failed: session already closed." ), session );
+        }
+        
+        m_pimpl->transmit( std::move( response ), true, [ this, session ]( const error_code & error, size_t )
+        {
+            if ( error )
+            {
+                const auto message = String::format( "Close failed: %s", error.message( ).data( ) );
+                const auto error_handler = m_pimpl->get_error_handler( );
+                return error_handler( 500, runtime_error( message ), session );
+            }
+            
+            m_pimpl->m_manager->save( session, [ this ]( const shared_ptr< Session > )
+            {
+                m_pimpl->disconnect( );
             } );
         } );
     }
@@ -135,7 +182,7 @@ namespace restbed
             return error_handler( 500, runtime_error( "Close failed: session already closed." ), session );
         }
         
-        m_pimpl->transmit( response, [ this, session ]( const error_code & error, size_t )
+        m_pimpl->transmit( response, true, [ this, session ]( const error_code & error, size_t )
         {
             if ( error )
             {
@@ -146,7 +193,7 @@ namespace restbed
             
             m_pimpl->m_manager->save( session, [ this ]( const shared_ptr< Session > )
             {
-                m_pimpl->m_request->m_pimpl->m_socket->close( );
+                m_pimpl->disconnect( );
             } );
         } );
     }
@@ -156,6 +203,11 @@ namespace restbed
         close( String::to_bytes( body ) );
     }
     
+    void Session::close( const int status, Bytes&& body )
+    {
+        close( status, std::move( body ), empty_headers );
+    }
+    
     void Session::close( const int status, const Bytes& body )
     {
         close( status, body, empty_headers );
@@ -176,17 +228,37 @@ namespace restbed
         close( status, String::to_bytes( body ), headers );
     }
     
-    void Session::close( const int status, const Bytes& body, const multimap< string, string >& headers )
+    void Session::close( const int status, Bytes&& body, const multimap< string, string >& headers )
     {
         Response response;
-        response.set_body( body );
+        response.set_body( std::move( body ) );
         response.set_headers( headers );
         response.set_status_code( status );
         
-        close( response );
+        close( std::move( response ) );
+    }
+    
+    void Session::close( const int status, const Bytes& body, const multimap< string, string >& headers )
+    {
+        close( status, Bytes( body ), headers );
+    }
+    
+    void Session::yield( Bytes&& body, const function< void ( const shared_ptr< Session > ) >& callback )
+    {
+        yield( make_shared< const Bytes >( std::move( body ) ), callback );
     }
     
     void Session::yield( const Bytes& body, const function< void ( const shared_ptr< Session > ) >& callback )
+    {
+        yield( make_shared< const Bytes >( body ), callback );
+    }
+    
+    void Session::yield( const shared_ptr< const Bytes >& body, const function< void ( const shared_ptr< Session > ) >& callback )
+    {
+        yield( BufferChain( body ), callback );
+    }
+    
+    void Session::yield( const BufferChain& body, const function< void ( const shared_ptr< Session > ) >& callback )
     {
         auto session = shared_from_this( );
         
@@ -196,7 +268,7 @@ namespace restbed
             return error_handler( 500, runtime_error( "Yield failed: session already closed." ), session );
         }
         
-        m_pimpl->m_request->m_pimpl->m_socket->start_write( body, [ this, session, callback ]( const error_code & error, size_t )
+        m_pimpl->write( body, false, [ this, session, callback ]( const error_code & error, size_t )
         {
             if ( error )
             {
@@ -217,6 +289,42 @@ namespace restbed
         yield( String::to_bytes( body ), callback );
     }
     
+    void Session::yield( Response&& response, const function< void ( const shared_ptr< Session > ) >& callback )
+    {
+        auto session = shared_from_this( );
+        
+        if ( is_closed( ) )
+        {
+            const auto error_handler = m_pimpl->get_error_handler( );
+            return error_handler( 500, runtime_error( "Yield failed: session already closed." ), session );
+        }
+        
+        m_pimpl->transmit( std::move( response ), callback == nullptr, [ this, session, callback ]( const error_code & error, size_t )
+        {
+            if ( error )
+            {
+                const auto message = String::format( "Yield failed: %s", error.message( ).data( ) );
+                const auto error_handler = m_pimpl->get_error_handler( );
+                return error_handler( 500, runtime_error( message ), session );
+            }
+            
+            if ( callback == nullptr )
+            {
+                //A pipelined request that handed the connection buffer to its successor is finished once written.
+                if ( m_pimpl->m_keep_alive_callback == nullptr )
+                {
+                    return;
+                }
+                
+                return m_pimpl->keep_alive( session );
+            }
+            else
+            {
+                callback( session );
+            }
+        } );
+    }
+    
     void Session::yield( const Response& response, const function< void ( const shared_ptr< Session > ) >& callback )
     {
         auto session = shared_from_this( );
@@ -227,7 +335,7 @@ namespace restbed
             return error_handler( 500, runtime_error( "Yield failed: session already closed." ), session );
         }
         
-        m_pimpl->transmit( response, [ this, session, callback ]( const error_code & error, size_t )
+        m_pimpl->transmit( response, callback == nullptr, [ this, session, callback ]( const error_code & error, size_t )
         {
             if ( error )
             {
@@ -238,12 +346,13 @@ namespace restbed
             
             if ( callback == nullptr )
             {
-                m_pimpl->m_request->m_pimpl->m_socket->start_read( m_pimpl->m_request->m_pimpl->m_buffer, "\r\n\r\n", [ this, session ]( const error_code & error, const size_t length )
+                //A pipelined request that handed the connection buffer to its successor is finished once written.
+                if ( m_pimpl->m_keep_alive_callback == nullptr )
                 {
-                    m_pimpl->m_keep_alive_callback( error, length, session );
-                } );
+                    return;
+                }
                 
-                return;
+                return m_pimpl->keep_alive( session );
             }
             else
             {
@@ -252,6 +361,11 @@ namespace restbed
         } );
     }
     
+    void Session::yield( const int status, Bytes&& body, const function< void ( const shared_ptr< Session > ) >& callback )
+    {
+        yield( status, std::move( body ), empty_headers, callback );
+    }
+    
     void Session::yield( const int status, const Bytes& body, const function< void ( const shared_ptr< Session > ) >& callback )
     {
         yield( status, body, empty_headers, callback );
@@ -272,14 +386,19 @@ namespace restbed
         yield( status, String::to_bytes( body ), headers, callback );
     }
     
-    void Session::yield( const int status, const Bytes& body, const multimap< string, string >& headers, const function< void ( const shared_ptr< Session > ) >& callback )
+    void Session::yield( const int status, Bytes&& body, const multimap< string, string >& headers, const function< void ( const shared_ptr< Session > ) >& callback )
     {
         Response response;
-        response.set_body( body );
+        response.set_body( std::move( body ) );
         response.set_headers( headers );
         response.set_status_code( status );
         
-        yield( response, callback );
+        yield( std::move( response ), callback );
+    }
+    
+    void Session::yield( const int status, const Bytes& body, const multimap< string, string >& headers, const function< void ( const shared_ptr< Session > ) >& callback )
+    {
+        yield( status, Bytes( body ), headers, callback );
     }
     
     void Session::fetch( const size_t length, const function< void ( const shared_ptr< Session >, const Bytes& ) >& callback )
@@ -292,11 +411,18 @@ namespace restbed
             return error_handler( 500, runtime_error( "Fetch failed: session already closed." ), session );
         }
         
+        const auto threshold = ( m_pimpl->m_settings == nullptr ) ? 0 : m_pimpl->m_settings->get_body_spill_threshold( );
+        
+        if ( threshold not_eq 0 and length > threshold )
+        {
+            return m_pimpl->spill_body( length, session, callback );
+        }
+        
         if ( length > m_pimpl->m_request->m_pimpl->m_buffer->size( ) )
         {
             size_t size = length - m_pimpl->m_request->m_pimpl->m_buffer->size( );
             
-            m_pimpl->m_request->m_pimpl->m_socket->start_read( m_pimpl->m_request->m_pimpl->m_buffer, size, [ this, session, length, callback ]( const error_code & error, size_t )
+            m_pimpl->read( size, [ this, session, length, callback ]( const error_code & error, size_t )
             {
                 if ( error )
                 {
@@ -324,7 +450,7 @@ namespace restbed
             return error_handler( 500, runtime_error( "Fetch failed: session already closed." ), session );
         }
         
-        m_pimpl->m_request->m_pimpl->m_socket->start_read( m_pimpl->m_request->m_pimpl->m_buffer, delimiter, [ this, session, callback ]( const error_code & error, size_t length )
+        m_pimpl->read( delimiter, [ this, session, callback ]( const error_code & error, size_t length )
         {
             if ( error )
             {
@@ -337,6 +463,58 @@ namespace restbed
         } );
     }
     
+    void Session::fetch( const size_t length, const shared_ptr< MultipartParser > parser, const function< void ( const shared_ptr< Session > ) >& callback )
+    {
+        auto session = shared_from_this( );
+        
+        if ( is_closed( ) )
+        {
+            const auto error_handler = m_pimpl->get_error_handler( );
+            return error_handler( 500, runtime_error( "Fetch failed: session already closed." ), session );
+        }
+        
+        m_pimpl->stream_body( length, session, [ parser ]( const Byte * data, const size_t size )
+        {
+            parser->parse( data, size );
+        },
+        [ this, parser, callback ]( const shared_ptr< Session > session )
+        {
+            try
+            {
+                parser->finish( );
+            }
+            catch ( const invalid_argument& ia )
+            {
+                return m_pimpl->get_error_handler( )( 400, ia, session );
+            }
+            
+            callback( session );
+        } );
+    }
+    
+    void Session::fetch( const size_t length, const shared_ptr< UrlencodedParser > parser, const function< void ( const shared_ptr< Session > ) >& callback )
+    {
+        auto session = shared_from_this( );
+        
+        if ( is_closed( ) )
+        {
+            const auto error_handler = m_pimpl->get_error_handler( );
+            return error_handler( 500, runtime_error( "Fetch failed: session already closed." ), session );
+        }
+        
+        //Parameters decode straight into the request's query parameters.
+        const auto request = m_pimpl->m_request;
+        
+        m_pimpl->stream_body( length, session, [ parser, request ]( const Byte * data, const size_t size )
+        {
+            parser->parse( data, size, request->m_pimpl->m_query_parameters );
+        },
+        [ parser, request, callback ]( const shared_ptr< Session > session )
+        {
+            parser->finish( request->m_pimpl->m_query_parameters );
+            callback( session );
+        } );
+    }
     
     void Session::upgrade( const int status, const function< void ( const shared_ptr< WebSocket > ) >& callback )
     {
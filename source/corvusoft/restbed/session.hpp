@@ -14,6 +14,7 @@
 
 //Project Includes
 #include <corvusoft/restbed/byte.hpp>
+#include <corvusoft/restbed/buffer_chain.hpp>
 #include <corvusoft/restbed/string.hpp>
 #include <corvusoft/restbed/context_value.hpp>
 
@@ -33,11 +34,14 @@ namespace restbed
     class Response;
     class Resource;
     class WebSocket;
+    class MultipartParser;
+    class UrlencodedParser;
     
     namespace detail
     {
         class SessionImpl;
         class ServiceImpl;
+        class RuleEngineImpl;
         class WebSocketManagerImpl;
     }
     
@@ -64,12 +68,22 @@ namespace restbed
             
             bool is_closed( void ) const;
             
+            void close( Bytes&& body );
+            
             void close( const Bytes& body );
             
+            void close( const std::shared_ptr< const Bytes >& body );
+            
+            void close( const BufferChain& body );
+            
+            void close( Response&& response );
+            
             void close( const Response& response );
             
             void close( const std::string& body = "" );
             
+            void close( const int status, Bytes&& body );
+            
             void close( const int status, const Bytes& body );
             
             void close( const int status, const std::string& body = "" );
@@ -78,20 +92,34 @@ namespace restbed
             
             void close( const int status, const std::string& body, const std::multimap< std::string, std::string >& headers );
             
+            void close( const int status, Bytes&& body, const std::multimap< std::string, std::string >& headers );
+            
             void close( const int status, const Bytes& body, const std::multimap< std::string, std::string >& headers );
             
+            void yield( Bytes&& data, const std::function< void ( const std::shared_ptr< Session > ) >& callback = nullptr );
+            
             void yield( const Bytes& data, const std::function< void ( const std::shared_ptr< Session > ) >& callback = nullptr );
             
+            void yield( const std::shared_ptr< const Bytes >& data, const std::function< void ( const std::shared_ptr< Session > ) >& callback = nullptr );
+            
+            void yield( const BufferChain& data, const std::function< void ( const std::shared_ptr< Session > ) >& callback = nullptr );
+            
             void yield( const std::string& data, const std::function< void ( const std::shared_ptr< Session > ) >& callback = nullptr );
             
+            void yield( Response&& response, const std::function< void ( const std::shared_ptr< Session > ) >& callback = nullptr );
+            
             void yield( const Response& response, const std::function< void ( const std::shared_ptr< Session > ) >& callback = nullptr );
             
             void yield( const int status, const std::string& body, const std::function< void ( const std::shared_ptr< Session > ) >& callback = nullptr );
             
+            void yield( const int status, Bytes&& body, const std::function< void ( const std::shared_ptr< Session > ) >& callback = nullptr );
+            
             void yield( const int status, const Bytes& body = { }, const std::function< void ( const std::shared_ptr< Session > ) >& callback = nullptr );
             
             void yield( const int status, const std::multimap< std::string, std::string >& headers, const std::function< void ( const std::shared_ptr< Session > ) >& callback = nullptr );
             
+            void yield( const int status, Bytes&& body, const std::multimap< std::string, std::string >& headers, const std::function< void ( const std::shared_ptr< Session > ) >& callback = nullptr );
+            
             void yield( const int status, const Bytes& body, const std::multimap< std::string, std::string >& headers, const std::function< void ( const std::shared_ptr< Session > ) >& callback = nullptr );
             
             void yield( const int status, const std::string& body, const std::multimap< std::string, std::string >& headers, const std::function< void ( const std::shared_ptr< Session > ) >& callback = nullptr );
@@ -100,6 +128,10 @@ namespace restbed
             
             void fetch( const std::string& delimiter, const std::function< void ( const std::shared_ptr< Session >, const Bytes& ) >& callback );
             
+            void fetch( const std::size_t length, const std::shared_ptr< MultipartParser > parser, const std::function< void ( const std::shared_ptr< Session > ) >& callback );
+            
+            void fetch( const std::size_t length, const std::shared_ptr< UrlencodedParser > parser, const std::function< void ( const std::shared_ptr< Session > ) >& callback );
+            
             void upgrade( const int status, const std::function< void ( const std::shared_ptr< WebSocket > ) >& callback );
             
             void upgrade( const int status, const Bytes& body, const std::function< void ( const std::shared_ptr< WebSocket > ) >& callback );
@@ -167,6 +199,7 @@ namespace restbed
             //Friends
             friend detail::ServiceImpl;
             friend detail::SessionImpl;
+            friend detail::RuleEngineImpl;
             friend detail::WebSocketManagerImpl;
             
             //Definitions
@@ -10,6 +10,7 @@
 #include "corvusoft/restbed/session.hpp"
 #include "corvusoft/restbed/settings.hpp"
 #include "corvusoft/restbed/session_manager.hpp"
+#include "corvusoft/restbed/detail/session_impl.hpp"
 
 //External Includes
 
@@ -21,6 +22,7 @@ using std::shared_ptr;
 using std::make_shared;
 
 //Project Namespaces
+using restbed::detail::SessionImpl;
 
 //External Namespaces
 
@@ -48,7 +50,7 @@ namespace restbed
     
     void SessionManager::create( const function< void ( const shared_ptr< Session > ) >& callback )
     {
-        callback( make_shared< Session >( String::empty ) );
+        callback( SessionImpl::acquire_session( ) );
     }
     
     void SessionManager::load( const shared_ptr< Session > session, const function< void ( const shared_ptr< Session > ) >& callback )
@@ -12,6 +12,7 @@
 
 //System Namespaces
 using std::map;
+using std::size_t;
 using std::string;
 using std::multimap;
 using std::make_pair;
@@ -68,11 +69,46 @@ namespace restbed
         return m_pimpl->m_case_insensitive_uris;
     }
     
+    size_t Settings::get_body_spill_threshold( void ) const
+    {
+        return m_pimpl->m_body_spill_threshold;
+    }
+    
+    string Settings::get_body_spill_directory( void ) const
+    {
+        return m_pimpl->m_body_spill_directory;
+    }
+    
+    size_t Settings::get_pipeline_limit( void ) const
+    {
+        return m_pimpl->m_pipeline_limit;
+    }
+    
+    size_t Settings::get_keep_alive_limit( void ) const
+    {
+        return m_pimpl->m_keep_alive_limit;
+    }
+    
+    bool Settings::get_http2_enabled( void ) const
+    {
+        return m_pimpl->m_http2_enabled;
+    }
+    
+    size_t Settings::get_http2_stream_limit( void ) const
+    {
+        return m_pimpl->m_http2_stream_limit;
+    }
+    
     milliseconds Settings::get_connection_timeout( void ) const
     {
         return m_pimpl->m_connection_timeout;
     }
     
+    milliseconds Settings::get_keep_alive_timeout( void ) const
+    {
+        return m_pimpl->m_keep_alive_timeout;
+    }
+    
     string Settings::get_status_message( const int code ) const
     {
         return ( m_pimpl->m_status_messages.count( code ) ) ?  m_pimpl->m_status_messages.at( code ) : "No Appropriate Status Message Found";
@@ -133,6 +169,36 @@ namespace restbed
         m_pimpl->m_case_insensitive_uris = value;
     }
     
+    void Settings::set_body_spill_threshold( const size_t value )
+    {
+        m_pimpl->m_body_spill_threshold = value;
+    }
+    
+    void Settings::set_body_spill_directory( const string& value )
+    {
+        m_pimpl->m_body_spill_directory = value;
+    }
+    
+    void Settings::set_pipeline_limit( const size_t value )
+    {
+        m_pimpl->m_pipeline_limit = value;
+    }
+    
+    void Settings::set_keep_alive_limit( const size_t value )
+    {
+        m_pimpl->m_keep_alive_limit = value;
+    }
+    
+    void Settings::set_http2_enabled( const bool value )
+    {
+        m_pimpl->m_http2_enabled = value;
+    }
+    
+    void Settings::set_http2_stream_limit( const size_t value )
+    {
+        m_pimpl->m_http2_stream_limit = value;
+    }
+    
     void Settings::set_connection_timeout( const seconds& value )
     {
         m_pimpl->m_connection_timeout = duration_cast< milliseconds >( value );
@@ -143,6 +209,16 @@ namespace restbed
         m_pimpl->m_connection_timeout = value;
     }
     
+    void Settings::set_keep_alive_timeout( const seconds& value )
+    {
+        m_pimpl->m_keep_alive_timeout = duration_cast< milliseconds >( value );
+    }
+    
+    void Settings::set_keep_alive_timeout( const milliseconds& value )
+    {
+        m_pimpl->m_keep_alive_timeout = value;
+    }
+    
     void Settings::set_status_message( const int code, const string& message )
     {
         m_pimpl->m_status_messages[ code ] = message;
@@ -9,6 +9,7 @@
 #include <chrono>
 #include <memory>
 #include <string>
+#include <cstddef>
 #include <cstdint>
 
 //Project Includes
@@ -58,8 +59,22 @@ namespace restbed
             
             bool get_case_insensitive_uris( void ) const;
             
+            std::size_t get_body_spill_threshold( void ) const;
+            
+            std::string get_body_spill_directory( void ) const;
+            
+            std::size_t get_pipeline_limit( void ) const;
+            
+            std::size_t get_keep_alive_limit( void ) const;
+            
+            bool get_http2_enabled( void ) const;
+            
+            std::size_t get_http2_stream_limit( void ) const;
+            
             std::chrono::milliseconds get_connection_timeout( void ) const;
             
+            std::chrono::milliseconds get_keep_alive_timeout( void ) const;
+            
             std::string get_status_message( const int code ) const;
             
             std::map< int, std::string > get_status_messages( void ) const;
@@ -85,10 +100,26 @@ namespace restbed
             
             void set_case_insensitive_uris( const bool value );
             
+            void set_body_spill_threshold( const std::size_t value );
+            
+            void set_body_spill_directory( const std::string& value );
+            
+            void set_pipeline_limit( const std::size_t value );
+            
+            void set_keep_alive_limit( const std::size_t value );
+            
+            void set_http2_enabled( const bool value );
+            
+            void set_http2_stream_limit( const std::size_t value );
+            
             void set_connection_timeout( const std::chrono::seconds& value );
             
             void set_connection_timeout( const std::chrono::milliseconds& value );
             
+            void set_keep_alive_timeout( const std::chrono::seconds& value );
+            
+            void set_keep_alive_timeout( const std::chrono::milliseconds& value );
+            
             void set_status_message( const int code, const std::string& message );
             
             void set_status_messages( const std::map< int, std::string >& values );
@@ -3,10 +3,9 @@
  */
 
 //System Includes
-#include <regex>
-#include <memory>
+#include <array>
+#include <cstdio>
 #include <ciso646>
-#include <algorithm>
 
 //Project Includes
 #include "corvusoft/restbed/string.hpp"
@@ -14,16 +13,11 @@
 //External Includes
 
 //System Namespaces
-using std::regex;
+using std::array;
 using std::string;
 using std::vector;
-using std::smatch;
 using std::multimap;
-using std::transform;
-using std::unique_ptr;
-using std::regex_match;
-using std::regex_replace;
-using std::regex_constants::icase;
+using std::vsnprintf;
 
 //Project Namespaces
 
@@ -33,6 +27,38 @@ namespace restbed
 {
     const string String::empty = "";
     
+    static char fold_lowercase( const char character )
+    {
+        return ( character >= 'A' and character <= 'Z' ) ? static_cast< char >( character - 'A' + 'a' ) : character;
+    }
+    
+    static string::size_type find( const string& value, const string& target, const string::size_type start, const bool insensitive )
+    {
+        if ( not insensitive )
+        {
+            return value.find( target, start );
+        }
+        
+        const auto length = target.length( );
+        
+        for ( auto position = start; position + length <= value.length( ); position++ )
+        {
+            string::size_type index = 0;
+            
+            while ( index < length and fold_lowercase( value[ position + index ] ) == fold_lowercase( target[ index ] ) )
+            {
+                index++;
+            }
+            
+            if ( index == length )
+            {
+                return position;
+            }
+        }
+        
+        return string::npos;
+    }
+    
     Bytes String::to_bytes( const string& value )
     {
         return Bytes( value.begin( ), value.end( ) );
@@ -45,32 +71,60 @@ namespace restbed
     
     string String::lowercase( const string& value )
     {
-        string result = "";
-        transform( value.begin( ), value.end( ), back_inserter( result ), [ ]( const char value ) { return static_cast< char >( tolower( value ) ); } );
+        string result = value;
+        lowercase_in_place( result );
         return result;
     }
     
     string String::uppercase( const string& value )
     {
-        string result = "";
-        transform( value.begin( ), value.end( ), back_inserter( result ), [ ]( const char value ) { return static_cast< char >( toupper( value ) ); } );
+        string result = value;
+        uppercase_in_place( result );
         return result;
     }
     
+    void String::lowercase_in_place( string& value )
+    {
+        for ( auto& character : value )
+        {
+            character = fold_lowercase( character );
+        }
+    }
+    
+    void String::uppercase_in_place( string& value )
+    {
+        for ( auto& character : value )
+        {
+            if ( character >= 'a' and character <= 'z' )
+            {
+                character = static_cast< char >( character - 'a' + 'A' );
+            }
+        }
+    }
+    
     string String::format( const char* format, ... )
     {
         va_list arguments;
         va_start( arguments, format );
         
+        va_list retry;
+        va_copy( retry, arguments );
+        
+        char buffer[ 1025 ];
+        int length = vsnprintf( buffer, sizeof( buffer ), format, arguments );
+        
         string formatted = "";
-        string::size_type length = 1024;
-        string::size_type required_length = String::format( formatted, length, format, arguments );
         
-        if ( required_length > length )
+        if ( length > 0 and static_cast< size_t >( length ) < sizeof( buffer ) )
         {
-            String::format( formatted, required_length, format, arguments );
+            formatted.assign( buffer, length );
+        }
+        else if ( length > 0 )
+        {
+            String::format( formatted, length, format, retry );
         }
         
+        va_end( retry );
         va_end( arguments );
         
         return formatted;
@@ -78,30 +132,64 @@ namespace restbed
     
     vector< string > String::split( const string& value, const char delimiter )
     {
-        vector< string > tokens;
+        vector< Token > tokens;
+        split( value, delimiter, tokens );
+        
+        vector< string > result;
+        result.reserve( tokens.size( ) );
+        
+        for ( const auto& token : tokens )
+        {
+            result.emplace_back( value, token.first, token.second );
+        }
+        
+        return result;
+    }
+    
+    void String::split( const string& value, const char delimiter, vector< Token >& tokens )
+    {
+        tokens.clear( );
+        
         string::size_type start = 0;
         string::size_type end = 0;
         
         while ( ( end = value.find( delimiter, start ) ) not_eq string::npos )
         {
-            const auto text = value.substr( start, end - start );
-            
-            if ( not text.empty( ) )
+            if ( end > start )
             {
-                tokens.push_back( text );
+                tokens.emplace_back( start, end - start );
             }
             
             start = end + 1;
         }
         
-        const auto token = value.substr( start );
+        if ( start < value.length( ) )
+        {
+            tokens.emplace_back( start, value.length( ) - start );
+        }
+    }
+    
+    bool String::equals( const string& lhs, const string& rhs, const Option option )
+    {
+        if ( lhs.length( ) not_eq rhs.length( ) )
+        {
+            return false;
+        }
         
-        if ( not token.empty( ) )
+        if ( not ( option & String::Option::CASE_INSENSITIVE ) )
         {
-            tokens.push_back( token );
+            return lhs == rhs;
+        }
+        
+        for ( string::size_type index = 0; index < lhs.length( ); index++ )
+        {
+            if ( fold_lowercase( lhs[ index ] ) not_eq fold_lowercase( rhs[ index ] ) )
+            {
+                return false;
+            }
         }
         
-        return tokens;
+        return true;
     }
     
     string String::join( const multimap< string, string >& values, const string& pair_delimiter, const string& delimiter )
@@ -138,38 +226,58 @@ namespace restbed
             return value;
         }
         
-        static const regex escape( "([.^$|()\\[\\]{}*+?\\\\])" );
-        const auto expression = regex_replace( target, escape, "\\$1" );
-        auto pattern = regex( expression );
+        const bool insensitive = ( option & String::Option::CASE_INSENSITIVE );
+        auto position = find( value, target, 0, insensitive );
         
-        if ( option & String::Option::CASE_INSENSITIVE )
+        if ( position == string::npos )
         {
-            pattern.assign( expression, icase );
+            return value;
         }
         
-        smatch match;
+        //Replacement repeats until no match remains; a substitute containing the target is applied once.
+        const bool repeat = find( substitute, target, 0, insensitive ) == string::npos;
+        
         string result = value;
+        string replaced = "";
         
-        while ( regex_search( result, match, pattern ) )
+        do
         {
-            result = regex_replace( result, pattern, substitute );
+            replaced.clear( );
+            replaced.reserve( result.length( ) );
+            
+            string::size_type start = 0;
+            
+            while ( position not_eq string::npos )
+            {
+                replaced.append( result, start, position - start );
+                replaced.append( substitute );
+                
+                start = position + target.length( );
+                position = find( result, target, start, insensitive );
+            }
+            
+            replaced.append( result, start, string::npos );
+            result.swap( replaced );
+            
+            position = ( repeat ) ? find( result, target, 0, insensitive ) : string::npos;
         }
+        while ( position not_eq string::npos );
         
         return result;
     }
     
     string::size_type String::format( string& output, const string::size_type length, const char* format, va_list arguments )
     {
-        unique_ptr< char[ ] > formatted( new char[ length + 1 ] );
+        output.resize( length + 1 );
         
-        int required_length = vsnprintf( formatted.get( ), length + 1, format, arguments );
+        int required_length = vsnprintf( &output[ 0 ], length + 1, format, arguments );
         
-        if ( required_length == -1 )
+        if ( required_length < 0 )
         {
             required_length = 0;
         }
         
-        output = formatted.get( );
+        output.resize( ( static_cast< string::size_type >( required_length ) < length ) ? required_length : length );
         
         return required_length;
     }
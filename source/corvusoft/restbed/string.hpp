@@ -8,6 +8,7 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <utility>
 #include <cstdarg>
 
 //Project Includes
@@ -37,6 +38,9 @@ namespace restbed
                 CASE_INSENSITIVE = 1
             };
             
+            //Offset and length of a token within the string it was split from.
+            typedef std::pair< std::string::size_type, std::string::size_type > Token;
+            
             //Constructors
             
             //Functionality
@@ -48,10 +52,18 @@ namespace restbed
             
             static std::string uppercase( const std::string& value );
             
+            static void lowercase_in_place( std::string& value );
+            
+            static void uppercase_in_place( std::string& value );
+            
             static std::string format( const char* format, ... );
             
             static std::vector< std::string > split( const std::string& text, const char delimiter );
             
+            static void split( const std::string& text, const char delimiter, std::vector< Token >& tokens );
+            
+            static bool equals( const std::string& lhs, const std::string& rhs, const Option option = CASE_SENSITIVE );
+            
             static std::string join( const std::multimap< std::string, std::string >& values, const std::string& pair_delimiter, const std::string& delimiter );
             
             static std::string remove( const std::string& needle, const std::string& haystack, const Option option = CASE_SENSITIVE );
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+
+//Project Includes
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    
+    enum TraceEvent : int
+    {
+        CONNECTION_ACCEPTED = 0,
+        HEADERS_RECEIVED = 1,
+        REQUEST_PARSED = 2,
+        ROUTE_RESOLVED = 3,
+        RULES_COMPLETED = 4,
+        HANDLER_STARTED = 5,
+        HANDLER_FINISHED = 6,
+        WRITE_QUEUED = 7,
+        WRITE_COMPLETED = 8
+    };
+}
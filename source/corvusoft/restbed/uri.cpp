@@ -3,9 +3,10 @@
  */
 
 //System Includes
-#include <regex>
-#include <cstdio>
+#include <array>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <stdexcept>
 
 #if defined(_WIN32)
@@ -27,12 +28,13 @@
 
 //System Namespaces
 using std::stoi;
-using std::regex;
-using std::smatch;
-using std::strtol;
+using std::array;
+using std::size_t;
+using std::memchr;
+using std::int8_t;
 using std::string;
+using std::vector;
 using std::multimap;
-using std::snprintf;
 using std::to_string;
 using std::unique_ptr;
 using std::runtime_error;
@@ -45,14 +47,147 @@ using restbed::detail::UriImpl;
 
 namespace restbed
 {
+    static const array< Byte, 256 >& reserved_characters( void )
+    {
+        static const array< Byte, 256 > characters = [ ]( )
+        {
+            array< Byte, 256 > table { };
+            
+            //unsafe and reserved characters
+            for ( const Byte character : string( " \"<>#%{}|\\^~[]`$&+,/:;=?@" ) )
+            {
+                table[ character ] = 1;
+            }
+            
+            return table;
+        }( );
+        
+        return characters;
+    }
+    
+    static const array< int8_t, 256 >& hexadecimal_values( void )
+    {
+        static const array< int8_t, 256 > values = [ ]( )
+        {
+            array< int8_t, 256 > table;
+            table.fill( -1 );
+            
+            for ( int digit = 0; digit < 10; digit++ )
+            {
+                table[ '0' + digit ] = static_cast< int8_t >( digit );
+            }
+            
+            for ( int digit = 0; digit < 6; digit++ )
+            {
+                table[ 'a' + digit ] = static_cast< int8_t >( digit + 10 );
+                table[ 'A' + digit ] = static_cast< int8_t >( digit + 10 );
+            }
+            
+            return table;
+        }( );
+        
+        return values;
+    }
+    
+    static string percent_encode( const char* data, const size_t size )
+    {
+        static const char digits[ ] = "0123456789ABCDEF";
+        const auto& reserved = reserved_characters( );
+        
+        size_t length = size;
+        
+        for ( size_t index = 0; index < size; index++ )
+        {
+            length += reserved[ static_cast< Byte >( data[ index ] ) ] * 2;
+        }
+        
+        string encoded = String::empty;
+        encoded.reserve( length );
+        
+        size_t position = 0;
+        
+        while ( position < size )
+        {
+            size_t run = position;
+            
+            while ( run < size and not reserved[ static_cast< Byte >( data[ run ] ) ] )
+            {
+                run++;
+            }
+            
+            encoded.append( data + position, run - position );
+            
+            if ( run == size )
+            {
+                break;
+            }
+            
+            const Byte character = static_cast< Byte >( data[ run ] );
+            const char escape[ 3 ] = { '%', digits[ character >> 4 ], digits[ character & 0x0F ] };
+            encoded.append( escape, sizeof( escape ) );
+            
+            position = run + 1;
+        }
+        
+        return encoded;
+    }
+    
+    //Malformed escape sequences are copied through verbatim.
+    static string percent_decode( const char* data, const size_t size, const bool plus_as_space )
+    {
+        const auto& hexadecimal = hexadecimal_values( );
+        
+        string result = String::empty;
+        result.reserve( size );
+        
+        size_t position = 0;
+        
+        while ( position < size )
+        {
+            const char* escape = static_cast< const char* >( memchr( data + position, '%', size - position ) );
+            const size_t run = ( escape == nullptr ) ? size : static_cast< size_t >( escape - data );
+            
+            if ( plus_as_space )
+            {
+                for ( size_t index = position; index < run; index++ )
+                {
+                    result.push_back( ( data[ index ] == '+' ) ? ' ' : data[ index ] );
+                }
+            }
+            else
+            {
+                result.append( data + position, run - position );
+            }
+            
+            if ( run == size )
+            {
+                break;
+            }
+            
+            const auto high = ( run + 1 < size ) ? hexadecimal[ static_cast< Byte >( data[ run + 1 ] ) ] : -1;
+            const auto low = ( run + 2 < size ) ? hexadecimal[ static_cast< Byte >( data[ run + 2 ] ) ] : -1;
+            
+            if ( high < 0 or low < 0 )
+            {
+                result.push_back( '%' );
+                position = run + 1;
+                continue;
+            }
+            
+            result.push_back( static_cast< char >( ( high << 4 ) | low ) );
+            position = run + 3;
+        }
+        
+        return result;
+    }
+    
     Uri::Uri( const string& value, bool relative ) : m_pimpl( new UriImpl )
     {
-        if ( not is_valid( value ) )
+        if ( not m_pimpl->parse( value ) )
         {
             throw invalid_argument( "Argument is not a valid URI: " + value );
         }
         
-        m_pimpl->m_uri = value;
         m_pimpl->m_relative = relative;
     }
     
@@ -83,9 +218,8 @@ namespace restbed
     
     bool Uri::is_valid( const string& value )
     {
-        static const regex pattern( "^[a-zA-Z][a-zA-Z0-9+\\-.]*://(([a-zA-Z0-9\\-._~%!$&'()*+,;=]+)(:([a-zA-Z0-9\\-._~%!$&'()*+,;=]+))?@)?([a-zA-Z0-9\\-._~%!$&'()*+,;=:\\[\\]]*(:[0-9]+)?)?[a-zA-Z0-9\\-._~%!$&'()*+,;=:@/]+(\\?[a-zA-Z0-9\\-._~%!$&'()*+,;=:@/]*)?(#[a-zA-Z0-9\\-._~%!$&'()*+,;=:@/?]*)?$" );
-        
-        return regex_match( value, pattern );
+        UriImpl components;
+        return components.parse( value );
     }
     
     Uri Uri::parse( const string& value )
@@ -100,88 +234,22 @@ namespace restbed
     
     string Uri::decode( const string& value )
     {
-        string result = String::empty;
-        
-        for ( string::size_type index = 0; index not_eq value.length( ); index++ )
-        {
-            if ( value[ index ] == '%' )
-            {
-                char hexidecimal[ 3 ] = { 0 };
-                hexidecimal[ 0 ] = value[ ++index ];
-                hexidecimal[ 1 ] = value[ ++index ];
-                
-                char byte = static_cast< char >( strtol( hexidecimal, nullptr, 16 ) );
-                result.push_back( byte );
-            }
-            else
-            {
-                result.push_back( value[ index ] );
-            }
-        }
-        
-        return result;
+        return percent_decode( value.data( ), value.length( ), false );
     }
     
     string Uri::decode_parameter( const string& value )
     {
-        return decode( String::replace( "+", " ", value ) );
+        return percent_decode( value.data( ), value.length( ), true );
     }
     
     string Uri::encode( const Bytes& value )
     {
-        string encoded = String::empty;
-        
-        for ( Byte character : value )
-        {
-            char hexidecimal[ 4 ] = { 0 };
-            
-            switch ( character )
-            {
-                //unsafe carachters
-                case ' ':
-                case '\"':
-                case '<':
-                case '>':
-                case '#':
-                case '%':
-                case '{':
-                case '}':
-                case '|':
-                case '\\':
-                case '^':
-                case '~':
-                case '[':
-                case ']':
-                case '`':
-                
-                //reserved characters
-                case '$':
-                case '&':
-                case '+':
-                case ',':
-                case '/':
-                case ':':
-                case ';':
-                case '=':
-                case '?':
-                case '@':
-                    snprintf( hexidecimal, sizeof( hexidecimal ), "%%%02X", character );
-                    encoded.append( hexidecimal );
-                    break;
-                    
-                default:
-                    hexidecimal[ 0 ] = character;
-                    encoded.append( hexidecimal );
-                    break;
-            }
-        }
-        
-        return encoded;
+        return percent_encode( reinterpret_cast< const char* >( value.data( ) ), value.size( ) );
     }
     
     string Uri::encode( const string& value )
     {
-        return encode( Bytes( value.begin( ), value.end( ) ) );
+        return percent_encode( value.data( ), value.length( ) );
     }
     
     string Uri::encode_parameter( const string& value )
@@ -191,15 +259,9 @@ namespace restbed
     
     uint16_t Uri::get_port( void ) const
     {
-        smatch match;
-        string port = String::empty;
-        static const regex pattern( "^[a-zA-Z][a-zA-Z0-9+\\-.]*://(([a-zA-Z0-9\\-._~%!$&'()*+,;=]+)(:([a-zA-Z0-9\\-._~%!$&'()*+,;=]+))?@)?([a-zA-Z0-9\\-._~%]+|\\[[a-zA-Z0-9\\-._~%!$&'()*+,;=:]+\\]):([0-9]+)" );
+        string port = m_pimpl->get_component( m_pimpl->m_port );
         
-        if ( regex_search( m_pimpl->m_uri, match, pattern ) )
-        {
-            port = match[ 6 ];
-        }
-        else
+        if ( port.empty( ) )
         {
             const auto scheme = get_scheme( );
             
@@ -224,81 +286,32 @@ namespace restbed
     
     string Uri::get_path( void ) const
     {
-        static const regex pattern( "^([a-zA-Z][a-zA-Z0-9+\\-.]*://([^/?#]+)?)?([a-zA-Z0-9\\-._~%!$&'()*+,;=:@/]*)" );
-        
-        smatch match;
-        
-        if ( regex_search( m_pimpl->m_uri, match, pattern ) )
-        {
-            return ( is_absolute( ) ) ? match[ 3 ] : string( match[ 2 ] ) + string( match[ 3 ] );
-        }
-        
-        return String::empty;
+        return m_pimpl->get_component( ( is_absolute( ) ) ? m_pimpl->m_path : m_pimpl->m_relative_path );
     }
     
     string Uri::get_query( void ) const
     {
-        smatch match;
-        static const regex pattern( "^[^?#]+\\?([^#]+)" );
-        
-        if ( regex_search( m_pimpl->m_uri, match, pattern ) )
-        {
-            return match[ 1 ];
-        }
-        
-        return String::empty;
+        return m_pimpl->get_component( m_pimpl->m_query );
     }
     
     string Uri::get_scheme( void ) const
     {
-        smatch match;
-        static const regex pattern( "^([a-zA-Z][a-zA-Z0-9+\\-.]*):" );
-        
-        if ( regex_search( m_pimpl->m_uri, match, pattern ) )
-        {
-            return match[ 1 ];
-        }
-        
-        return String::empty;
+        return m_pimpl->get_component( m_pimpl->m_scheme );
     }
     
     string Uri::get_fragment( void ) const
     {
-        smatch match;
-        static const regex pattern( "#(.+)" );
-        
-        if ( regex_search( m_pimpl->m_uri, match, pattern ) )
-        {
-            return match[ 1 ];
-        }
-        
-        return String::empty;
+        return m_pimpl->get_component( m_pimpl->m_fragment );
     }
     
     string Uri::get_username( void ) const
     {
-        smatch match;
-        static const regex pattern( "^[a-zA-Z0-9+\\-.]+://([a-zA-Z0-9\\-._~%!$&'()*+,;=]+)(:([a-zA-Z0-9\\-._~%!$&'()*+,;=]+))?@" );
-        
-        if ( regex_search( m_pimpl->m_uri, match, pattern ) )
-        {
-            return match[ 1 ];
-        }
-        
-        return String::empty;
+        return m_pimpl->get_component( m_pimpl->m_username );
     }
     
     string Uri::get_password( void ) const
     {
-        smatch match;
-        static const regex pattern( "^[a-zA-Z0-9+\\-.]+://([a-zA-Z0-9\\-._~%!$&'()*+,;=]+):([a-zA-Z0-9\\-._~%!$&'()*+,;=]+)@" );
-        
-        if ( regex_search( m_pimpl->m_uri, match, pattern ) )
-        {
-            return match[ 2 ];
-        }
-        
-        return String::empty;
+        return m_pimpl->get_component( m_pimpl->m_password );
     }
     
     string Uri::get_authority( void ) const
@@ -308,30 +321,32 @@ namespace restbed
             return String::empty;
         }
         
-        smatch match;
-        static const regex pattern( "^[a-zA-Z][a-zA-Z0-9+\\-.]*://(([a-zA-Z0-9\\-._~%!$&'()*+,;=]+)(:([a-zA-Z0-9\\-._~%!$&'()*+,;=]+))?@)?([a-zA-Z0-9\\-._~%]+|\\[[a-zA-Z0-9\\-._~%!$&'()*+,;=:]+\\])" );
-        
-        if ( regex_search( m_pimpl->m_uri, match, pattern ) )
-        {
-            return match[ 5 ];
-        }
-        
-        return String::empty;
+        return m_pimpl->get_component( m_pimpl->m_authority );
     }
     
     multimap< string, string > Uri::get_query_parameters( void ) const
     {
         multimap< string, string > parameters;
         
-        auto query = String::split( get_query( ), '&' );
+        const auto query = get_query( );
         
-        for ( auto parameter : query )
+        vector< String::Token > tokens;
+        String::split( query, '&', tokens );
+        
+        for ( const auto& token : tokens )
         {
-            auto index = parameter.find_first_of( '=' );
-            auto name = decode_parameter( parameter.substr( 0, index ) );
-            auto value = decode_parameter( parameter.substr( index + 1, parameter.length( ) ) );
+            const char* parameter = query.data( ) + token.first;
+            const char* separator = static_cast< const char* >( memchr( parameter, '=', token.second ) );
+            
+            if ( separator == nullptr )
+            {
+                const auto name = percent_decode( parameter, token.second, true );
+                parameters.insert( make_pair( name, name ) );
+                continue;
+            }
             
-            parameters.insert( make_pair( name, value ) );
+            const size_t length = separator - parameter;
+            parameters.insert( make_pair( percent_decode( parameter, length, true ), percent_decode( separator + 1, token.second - length - 1, true ) ) );
         }
         
         return parameters;
@@ -339,7 +354,10 @@ namespace restbed
     
     Uri& Uri::operator =( const Uri& rhs )
     {
-        m_pimpl->m_uri = rhs.m_pimpl->m_uri;
+        const auto relative = m_pimpl->m_relative;
+        *m_pimpl = *rhs.m_pimpl;
+        m_pimpl->m_relative = relative;
+        
         return *this;
     }
     
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <cstring>
+#include <utility>
+#include <ciso646>
+
+//Project Includes
+#include "corvusoft/restbed/uri.hpp"
+#include "corvusoft/restbed/urlencoded_parser.hpp"
+#include "corvusoft/restbed/detail/urlencoded_parser_impl.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::size_t;
+using std::string;
+using std::memchr;
+using std::multimap;
+using std::make_pair;
+
+//Project Namespaces
+using restbed::detail::UrlencodedParserImpl;
+
+//External Namespaces
+
+namespace restbed
+{
+    static void insert_parameter( const string& pair, multimap< string, string >& parameters )
+    {
+        if ( pair.empty( ) )
+        {
+            return;
+        }
+        
+        const auto separator = pair.find( '=' );
+        
+        if ( separator == string::npos )
+        {
+            const auto name = Uri::decode_parameter( pair );
+            parameters.insert( make_pair( name, name ) );
+            return;
+        }
+        
+        parameters.insert( make_pair( Uri::decode_parameter( pair.substr( 0, separator ) ), Uri::decode_parameter( pair.substr( separator + 1 ) ) ) );
+    }
+    
+    UrlencodedParser::UrlencodedParser( void ) : m_pimpl( new UrlencodedParserImpl )
+    {
+        return;
+    }
+    
+    UrlencodedParser::~UrlencodedParser( void )
+    {
+        return;
+    }
+    
+    void UrlencodedParser::parse( const Bytes& data, multimap< string, string >& parameters )
+    {
+        parse( data.data( ), data.size( ), parameters );
+    }
+    
+    void UrlencodedParser::parse( const Byte* data, const size_t length, multimap< string, string >& parameters )
+    {
+        const char* position = reinterpret_cast< const char* >( data );
+        const char* end = position + length;
+        
+        while ( position not_eq end )
+        {
+            const char* separator = static_cast< const char* >( memchr( position, '&', static_cast< size_t >( end - position ) ) );
+            
+            if ( separator == nullptr )
+            {
+                m_pimpl->m_pending.append( position, end );
+                return;
+            }
+            
+            m_pimpl->m_pending.append( position, separator );
+            insert_parameter( m_pimpl->m_pending, parameters );
+            m_pimpl->m_pending.clear( );
+            
+            position = separator + 1;
+        }
+    }
+    
+    void UrlencodedParser::finish( multimap< string, string >& parameters )
+    {
+        insert_parameter( m_pimpl->m_pending, parameters );
+        m_pimpl->m_pending.clear( );
+    }
+}
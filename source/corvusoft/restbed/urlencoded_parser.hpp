@@ -0,0 +1,97 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <map>
+#include <string>
+#include <memory>
+#include <cstddef>
+
+//Project Includes
+#include <corvusoft/restbed/byte.hpp>
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+namespace restbed
+{
+    //Forward Declarations
+    
+    namespace detail
+    {
+        struct UrlencodedParserImpl;
+    }
+    
+    class UrlencodedParser
+    {
+        public:
+            //Friends
+            
+            //Definitions
+            
+            //Constructors
+            UrlencodedParser( void );
+            
+            virtual ~UrlencodedParser( void );
+            
+            //Functionality
+            void parse( const Bytes& data, std::multimap< std::string, std::string >& parameters );
+            
+            void parse( const Byte* data, const std::size_t length, std::multimap< std::string, std::string >& parameters );
+            
+            void finish( std::multimap< std::string, std::string >& parameters );
+            
+            //Getters
+            
+            //Setters
+            
+            //Operators
+            
+            //Properties
+        
+        protected:
+            //Friends
+            
+            //Definitions
+            
+            //Constructors
+            
+            //Functionality
+            
+            //Getters
+            
+            //Setters
+            
+            //Operators
+            
+            //Properties
+        
+        private:
+            //Friends
+            
+            //Definitions
+            
+            //Constructors
+            UrlencodedParser( const UrlencodedParser& original ) = delete;
+            
+            //Functionality
+            
+            //Getters
+            
+            //Setters
+            
+            //Operators
+            UrlencodedParser& operator =( const UrlencodedParser& value ) = delete;
+            
+            //Properties
+            std::unique_ptr< detail::UrlencodedParserImpl > m_pimpl;
+    };
+}
@@ -3,11 +3,13 @@
  */
 
 //System Includes
+#include <utility>
 #include <ciso646>
 
 //Project Includes
 #include "corvusoft/restbed/string.hpp"
 #include "corvusoft/restbed/web_socket.hpp"
+#include "corvusoft/restbed/buffer_chain.hpp"
 #include "corvusoft/restbed/detail/socket_impl.hpp"
 #include "corvusoft/restbed/detail/web_socket_impl.hpp"
 #include "corvusoft/restbed/detail/web_socket_manager_impl.hpp"
@@ -73,6 +75,11 @@ namespace restbed
         m_pimpl->m_socket->close( );
     }
     
+    void WebSocket::send( Bytes&& body, const function< void ( const shared_ptr< WebSocket > ) > callback )
+    {
+        send( make_shared< WebSocketMessage >( WebSocketMessage::BINARY_FRAME, std::move( body ) ), callback );
+    }
+    
     void WebSocket::send( const Bytes& body, const function< void ( const shared_ptr< WebSocket > ) > callback )
     {
         send( make_shared< WebSocketMessage >( WebSocketMessage::BINARY_FRAME, body ), callback );
@@ -90,9 +97,19 @@ namespace restbed
     
     void WebSocket::send( const shared_ptr< WebSocketMessage > message, const function< void ( const shared_ptr< WebSocket > ) > callback )
     {
-        const auto data = m_pimpl->m_manager->compose( message );
+        BufferChain frame;
+        
+        if ( message->get_mask_flag( ) )
+        {
+            frame.append( m_pimpl->m_manager->compose( message ) );
+        }
+        else
+        {
+            frame.append( m_pimpl->m_manager->compose_header( message ) );
+            frame.append( shared_ptr< const Bytes >( message, &message->get_data( ) ) );
+        }
         
-        m_pimpl->m_socket->start_write( data, [ this, callback ]( const error_code & code, size_t )
+        m_pimpl->m_socket->start_write( frame, [ this, callback ]( const error_code & code, size_t )
         {
             if ( code )
             {
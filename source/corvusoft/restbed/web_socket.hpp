@@ -53,6 +53,8 @@ namespace restbed
             
             void close( void );
             
+            void send( Bytes&& body, const std::function< void ( const std::shared_ptr< WebSocket > ) > callback = nullptr );
+            
             void send( const Bytes& body, const std::function< void ( const std::shared_ptr< WebSocket > ) > callback = nullptr );
             
             void send( const std::string& body, const std::function< void ( const std::shared_ptr< WebSocket > ) > callback = nullptr );
@@ -3,6 +3,7 @@
  */
 
 //System Includes
+#include <utility>
 
 //Project Includes
 #include "corvusoft/restbed/string.hpp"
@@ -37,6 +38,11 @@ namespace restbed
         *m_pimpl = *original.m_pimpl;
     }
     
+    WebSocketMessage::WebSocketMessage( const WebSocketMessage::OpCode code, Bytes&& data ) : WebSocketMessage( code, std::move( data ), 0 )
+    {
+        return;
+    }
+    
     WebSocketMessage::WebSocketMessage( const WebSocketMessage::OpCode code, const Bytes& data ) : WebSocketMessage( code, data, 0 )
     {
         return;
@@ -47,14 +53,19 @@ namespace restbed
         return;
     }
     
-    WebSocketMessage::WebSocketMessage( const WebSocketMessage::OpCode code, const Bytes& data, const uint32_t mask ) : m_pimpl( new WebSocketMessageImpl )
+    WebSocketMessage::WebSocketMessage( const WebSocketMessage::OpCode code, const Bytes& data, const uint32_t mask ) : WebSocketMessage( code, Bytes( data ), mask )
     {
-        m_pimpl->m_data = data;
+        return;
+    }
+    
+    WebSocketMessage::WebSocketMessage( const WebSocketMessage::OpCode code, Bytes&& data, const uint32_t mask ) : m_pimpl( new WebSocketMessageImpl )
+    {
+        m_pimpl->m_data = std::move( data );
         m_pimpl->m_mask = mask;
         m_pimpl->m_opcode = code;
         m_pimpl->m_mask_flag = ( mask == 0 ) ? false : true;
         
-        const auto length = data.size( );
+        const auto length = m_pimpl->m_data.size( );
         
         if ( length <= 125 )
         {
@@ -77,7 +88,7 @@ namespace restbed
         return;
     }
     
-    Bytes WebSocketMessage::get_data( void ) const
+    const Bytes& WebSocketMessage::get_data( void ) const
     {
         return m_pimpl->m_data;
     }
@@ -117,6 +128,11 @@ namespace restbed
         return make_tuple( m_pimpl->m_reserved_flag_one, m_pimpl->m_reserved_flag_two, m_pimpl->m_reserved_flag_three );
     }
     
+    void WebSocketMessage::set_data( Bytes&& value )
+    {
+        m_pimpl->m_data = std::move( value );
+    }
+    
     void WebSocketMessage::set_data( const Bytes& value )
     {
         m_pimpl->m_data = value;
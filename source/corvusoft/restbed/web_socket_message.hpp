@@ -52,10 +52,14 @@ namespace restbed
             
             WebSocketMessage( const WebSocketMessage& original );
             
+            WebSocketMessage( const OpCode code, Bytes&& data );
+            
             WebSocketMessage( const OpCode code, const Bytes& data = { } );
             
             WebSocketMessage( const OpCode code, const std::string& data );
             
+            WebSocketMessage( const OpCode code, Bytes&& data, const std::uint32_t mask );
+            
             WebSocketMessage( const OpCode code, const Bytes& data, const std::uint32_t mask );
             
             WebSocketMessage( const OpCode code, const std::string& data, const std::uint32_t mask );
@@ -66,7 +70,7 @@ namespace restbed
             Bytes to_bytes( void ) const;
             
             //Getters
-            Bytes get_data( void ) const;
+            const Bytes& get_data( void ) const;
             
             OpCode get_opcode( void ) const;
             
@@ -83,6 +87,8 @@ namespace restbed
             std::tuple< bool, bool, bool > get_reserved_flags( void ) const;
             
             //Setters
+            void set_data( Bytes&& value );
+            
             void set_data( const Bytes& value );
             
             void set_data( const std::string& value );
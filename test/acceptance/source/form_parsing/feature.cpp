@@ -0,0 +1,151 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <map>
+#include <thread>
+#include <string>
+#include <memory>
+#include <functional>
+
+//Project Includes
+#include <restbed>
+
+//External Includes
+#include <catch.hpp>
+
+//System Namespaces
+using std::thread;
+using std::string;
+using std::multimap;
+using std::to_string;
+using std::shared_ptr;
+using std::make_shared;
+
+//Project Namespaces
+using namespace restbed;
+
+//External Namespaces
+
+void reply( const shared_ptr< Session > session, const string& body )
+{
+    session->close( 200, body, { { "Content-Length", to_string( body.length( ) ) } } );
+}
+
+void multipart_handler( const shared_ptr< Session > session )
+{
+    const size_t length = session->get_request( )->get_header( "Content-Length", 0 );
+    
+    auto names = make_shared< string >( );
+    auto parser = make_shared< MultipartParser >( "boundary" );
+    
+    parser->set_part_data_handler( [ names ]( const Bytes & data )
+    {
+        names->append( data.begin( ), data.end( ) );
+        names->push_back( ';' );
+    } );
+    
+    session->fetch( length, parser, [ names ]( const shared_ptr< Session > session )
+    {
+        reply( session, *names );
+    } );
+}
+
+void urlencoded_handler( const shared_ptr< Session > session )
+{
+    const size_t length = session->get_request( )->get_header( "Content-Length", 0 );
+    
+    session->fetch( length, make_shared< UrlencodedParser >( ), [ ]( const shared_ptr< Session > session )
+    {
+        const auto request = session->get_request( );
+        reply( session, request->get_query_parameter( "first" ) + ";" + request->get_query_parameter( "second" ) );
+    } );
+}
+
+shared_ptr< const Response > post( const string& path, const string& body )
+{
+    auto request = make_shared< Request >( );
+    request->set_port( 1984 );
+    request->set_method( "POST" );
+    request->set_host( "localhost" );
+    request->set_path( path );
+    request->set_body( body );
+    request->set_header( "Content-Length", to_string( body.length( ) ) );
+    
+    auto response = Http::sync( request );
+    
+    const size_t length = response->get_header( "Content-Length", 0 );
+    Http::fetch( length, response );
+    
+    return response;
+}
+
+SCENARIO( "streaming form bodies through the built-in parsers", "[session]" )
+{
+    auto multipart = make_shared< Resource >( );
+    multipart->set_path( "/multipart" );
+    multipart->set_method_handler( "POST", multipart_handler );
+    
+    auto urlencoded = make_shared< Resource >( );
+    urlencoded->set_path( "/urlencoded" );
+    urlencoded->set_method_handler( "POST", urlencoded_handler );
+    
+    auto settings = make_shared< Settings >( );
+    settings->set_port( 1984 );
+    settings->set_default_header( "Connection", "close" );
+    
+    shared_ptr< thread > worker = nullptr;
+    
+    Service service;
+    service.publish( multipart );
+    service.publish( urlencoded );
+    service.set_ready_handler( [ &worker ]( Service & service )
+    {
+        worker = make_shared< thread >( [ &service ] ( )
+        {
+            GIVEN( "I publish resources that parse multipart and urlencoded bodies as they arrive" )
+            {
+                WHEN( "I perform a HTTP 'POST' request with a multipart/form-data body" )
+                {
+                    const string body = "--boundary\r\nContent-Disposition: form-data; name=\"a\"\r\n\r\nalpha\r\n"
+                                        "--boundary\r\nContent-Disposition: form-data; name=\"b\"\r\n\r\nbeta\r\n--boundary--\r\n";
+                    
+                    const auto response = post( "/multipart", body );
+                    
+                    THEN( "I should see each part's data" )
+                    {
+                        REQUIRE( 200 == response->get_status_code( ) );
+                        REQUIRE( String::to_string( response->get_body( ) ) == "alpha;beta;" );
+                    }
+                }
+                
+                WHEN( "I perform a HTTP 'POST' request with a truncated multipart/form-data body" )
+                {
+                    const auto response = post( "/multipart", "--boundary\r\n\r\nalpha" );
+                    
+                    THEN( "I should see a '400' (Bad Request) status code" )
+                    {
+                        REQUIRE( 400 == response->get_status_code( ) );
+                    }
+                }
+                
+                WHEN( "I perform a HTTP 'POST' request with an application/x-www-form-urlencoded body" )
+                {
+                    const auto response = post( "/urlencoded", "first=hello+there&second=%2Fpath" );
+                    
+                    THEN( "I should see the decoded parameters" )
+                    {
+                        REQUIRE( 200 == response->get_status_code( ) );
+                        REQUIRE( String::to_string( response->get_body( ) ) == "hello there;/path" );
+                    }
+                }
+                
+                service.stop( );
+            }
+        } );
+    } );
+    
+    service.start( settings );
+    worker->join( );
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <string>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <ciso646>
+#include <functional>
+
+//Project Includes
+#include <restbed>
+
+//External Includes
+#include <catch.hpp>
+
+//System Namespaces
+using std::map;
+using std::mutex;
+using std::atomic;
+using std::future;
+using std::thread;
+using std::string;
+using std::vector;
+using std::uint64_t;
+using std::to_string;
+using std::lock_guard;
+using std::shared_ptr;
+using std::make_shared;
+using std::chrono::steady_clock;
+
+//Project Namespaces
+using namespace restbed;
+
+//External Namespaces
+
+void get_handler( const shared_ptr< Session > session )
+{
+    const auto request = session->get_request( );
+    const auto body = "Hello from " + request->get_path( ) + " over HTTP/" + to_string( static_cast< int >( request->get_version( ) ) );
+    
+    session->close( 200, body, { { "Content-Length", to_string( body.length( ) ) } } );
+}
+
+void post_handler( const shared_ptr< Session > session )
+{
+    const auto request = session->get_request( );
+    const size_t length = request->get_header( "Content-Length", 0 );
+    
+    session->fetch( length, [ ]( const shared_ptr< Session > session, const Bytes& body )
+    {
+        session->close( 201, body, { { "Content-Length", to_string( body.size( ) ) } } );
+    } );
+}
+
+SCENARIO( "multiplexing concurrent client requests over one HTTP/2 connection", "[client]" )
+{
+    auto resource = make_shared< Resource >( );
+    resource->set_path( "/resources/{name: .*}" );
+    resource->set_method_handler( "GET", get_handler );
+    resource->set_method_handler( "POST", post_handler );
+    
+    auto settings = make_shared< Settings >( );
+    settings->set_port( 1984 );
+    settings->set_http2_enabled( true );
+    
+    atomic< int > connections( 0 );
+    shared_ptr< thread > worker = nullptr;
+    
+    Service service;
+    service.publish( resource );
+    service.set_trace_handler( [ &connections ]( const TraceEvent event, const uint64_t, const uint64_t, const steady_clock::time_point& )
+    {
+        if ( event == CONNECTION_ACCEPTED )
+        {
+            connections++;
+        }
+    } );
+    service.set_ready_handler( [ &worker, &connections ]( Service & service )
+    {
+        worker = make_shared< thread >( [ &service, &connections ] ( )
+        {
+            GIVEN( "I publish a resource with HTTP/2 enabled" )
+            {
+                WHEN( "I perform four 'GET' requests at once and then a 'POST' with a body, all with HTTP/2 enabled on the client" )
+                {
+                    auto client = make_shared< Settings >( );
+                    client->set_http2_enabled( true );
+                    
+                    mutex lock;
+                    map< string, int > statuses;
+                    map< string, string > bodies;
+                    vector< future< shared_ptr< Response > > > responses;
+                    
+                    for ( const string name : { "alpha", "beta", "gamma", "delta" } )
+                    {
+                        auto request = make_shared< Request >( );
+                        request->set_port( 1984 );
+                        request->set_host( "localhost" );
+                        request->set_method( "GET" );
+                        request->set_path( "/resources/" + name );
+                        
+                        responses.push_back( Http::async( request, [ &lock, &statuses, &bodies, name ]( const shared_ptr< Request >, const shared_ptr< Response > response )
+                        {
+                            const auto length = response->get_header( "Content-Length", 0 );
+                            const auto body = Http::fetch( length, response );
+                            
+                            lock_guard< mutex > guard( lock );
+                            statuses[ name ] = response->get_status_code( );
+                            bodies[ name ] = string( body.begin( ), body.end( ) );
+                        }, client ) );
+                    }
+                    
+                    for ( auto& response : responses )
+                    {
+                        response.wait( );
+                    }
+                    
+                    auto request = make_shared< Request >( );
+                    request->set_port( 1984 );
+                    request->set_host( "localhost" );
+                    request->set_method( "POST" );
+                    request->set_path( "/resources/echo" );
+                    request->set_header( "Content-Length", "11" );
+                    request->set_body( "ping ~ pong" );
+                    
+                    const auto response = Http::sync( request, client );
+                    const auto body = Http::fetch( 11, response );
+                    
+                    THEN( "I should see every response, all served over a single HTTP/2 connection" )
+                    {
+                        REQUIRE( statuses.size( ) == 4 );
+                        
+                        for ( const auto& status : statuses )
+                        {
+                            REQUIRE( status.second == 200 );
+                            REQUIRE( bodies[ status.first ] == "Hello from /resources/" + status.first + " over HTTP/2" );
+                        }
+                        
+                        REQUIRE( response->get_status_code( ) == 201 );
+                        REQUIRE( response->get_version( ) == 2.0 );
+                        REQUIRE( string( body.begin( ), body.end( ) ) == "ping ~ pong" );
+                        REQUIRE( connections == 1 );
+                    }
+                }
+                
+                service.stop( );
+            }
+        } );
+    } );
+    
+    service.start( settings );
+    worker->join( );
+}
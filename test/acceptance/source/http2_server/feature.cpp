@@ -0,0 +1,306 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <map>
+#include <set>
+#include <thread>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <ciso646>
+#include <functional>
+#include <system_error>
+
+//Project Includes
+#include <restbed>
+
+//External Includes
+#include <asio.hpp>
+#include <catch.hpp>
+
+//System Namespaces
+using std::map;
+using std::set;
+using std::thread;
+using std::string;
+using std::uint8_t;
+using std::uint32_t;
+using std::to_string;
+using std::error_code;
+using std::shared_ptr;
+using std::make_shared;
+
+//Project Namespaces
+using namespace restbed;
+
+//External Namespaces
+using asio::ip::tcp;
+using asio::io_service;
+
+struct Exchange
+{
+    map< uint32_t, string > status { };
+    
+    map< uint32_t, string > bodies { };
+};
+
+void get_handler( const shared_ptr< Session > session )
+{
+    const auto request = session->get_request( );
+    const auto body = "Hello from " + request->get_path( ) + " over HTTP/" + to_string( static_cast< int >( request->get_version( ) ) );
+    
+    session->close( 200, body, { { "Content-Length", to_string( body.length( ) ) }, { "Connection", "close" } } );
+}
+
+void post_handler( const shared_ptr< Session > session )
+{
+    const auto request = session->get_request( );
+    const size_t length = request->get_header( "Content-Length", 0 );
+    
+    session->fetch( length, [ ]( const shared_ptr< Session > session, const Bytes& body )
+    {
+        session->close( 201, body, { { "Content-Length", to_string( body.size( ) ) } } );
+    } );
+}
+
+string frame( const uint8_t type, const uint8_t flags, const uint32_t id, const string& payload )
+{
+    string data;
+    data.push_back( static_cast< char >( payload.length( ) >> 16 ) );
+    data.push_back( static_cast< char >( payload.length( ) >> 8 ) );
+    data.push_back( static_cast< char >( payload.length( ) ) );
+    data.push_back( static_cast< char >( type ) );
+    data.push_back( static_cast< char >( flags ) );
+    data.push_back( static_cast< char >( id >> 24 ) );
+    data.push_back( static_cast< char >( id >> 16 ) );
+    data.push_back( static_cast< char >( id >> 8 ) );
+    data.push_back( static_cast< char >( id ) );
+    
+    return data + payload;
+}
+
+//Header block of literal fields without indexing, so the test needs no compression context.
+string headers( const string& method, const string& path, const map< string, string >& fields = { } )
+{
+    string block;
+    
+    const auto literal = [ &block ]( const string & name, const string & value )
+    {
+        block.push_back( 0x00 );
+        block.push_back( static_cast< char >( name.length( ) ) );
+        block += name;
+        block.push_back( static_cast< char >( value.length( ) ) );
+        block += value;
+    };
+    
+    literal( ":method", method );
+    literal( ":scheme", "http" );
+    literal( ":path", path );
+    literal( ":authority", "localhost" );
+    
+    for ( const auto& field : fields )
+    {
+        literal( field.first, field.second );
+    }
+    
+    return block;
+}
+
+//Reads frames until every expected stream has ended; the response status is recorded only for the common indexed codes.
+Exchange receive( tcp::socket& socket, asio::streambuf& buffer, set< uint32_t > streams, error_code& error )
+{
+    static const map< uint8_t, string > indexed = { { 0x88, "200" }, { 0x89, "204" }, { 0x8a, "206" }, { 0x8b, "304" }, { 0x8c, "400" }, { 0x8d, "404" }, { 0x8e, "500" } };
+    
+    Exchange exchange;
+    
+    while ( not streams.empty( ) )
+    {
+        if ( buffer.size( ) < 9 )
+        {
+            asio::read( socket, buffer, asio::transfer_at_least( 9 - buffer.size( ) ), error );
+            
+            if ( error )
+            {
+                break;
+            }
+        }
+        
+        const auto header = asio::buffer_cast< const uint8_t* >( buffer.data( ) );
+        const size_t length = ( header[ 0 ] << 16 ) | ( header[ 1 ] << 8 ) | header[ 2 ];
+        const uint8_t type = header[ 3 ];
+        const uint8_t flags = header[ 4 ];
+        const uint32_t id = ( ( header[ 5 ] & 0x7F ) << 24 ) | ( header[ 6 ] << 16 ) | ( header[ 7 ] << 8 ) | header[ 8 ];
+        
+        if ( buffer.size( ) < 9 + length )
+        {
+            asio::read( socket, buffer, asio::transfer_at_least( 9 + length - buffer.size( ) ), error );
+            
+            if ( error )
+            {
+                break;
+            }
+        }
+        
+        const string payload( asio::buffer_cast< const char* >( buffer.data( ) ) + 9, length );
+        buffer.consume( 9 + length );
+        
+        if ( type == 0x1 and not payload.empty( ) )
+        {
+            const auto status = indexed.find( static_cast< uint8_t >( payload[ 0 ] ) );
+            exchange.status[ id ] = ( status == indexed.end( ) ) ? "other" : status->second;
+        }
+        else if ( type == 0x0 )
+        {
+            exchange.bodies[ id ] += payload;
+        }
+        else if ( type == 0x3 )
+        {
+            streams.erase( id );
+        }
+        
+        if ( ( type == 0x0 or type == 0x1 ) and ( flags & 0x1 ) )
+        {
+            streams.erase( id );
+        }
+    }
+    
+    return exchange;
+}
+
+SCENARIO( "serving concurrent HTTP/2 streams to a client with prior knowledge", "[service]" )
+{
+    auto resource = make_shared< Resource >( );
+    resource->set_path( "/resources/{name: .*}" );
+    resource->set_method_handler( "GET", get_handler );
+    resource->set_method_handler( "POST", post_handler );
+    
+    auto settings = make_shared< Settings >( );
+    settings->set_port( 1984 );
+    settings->set_http2_enabled( true );
+    
+    shared_ptr< thread > worker = nullptr;
+    
+    Service service;
+    service.publish( resource );
+    service.set_ready_handler( [ &worker ]( Service & service )
+    {
+        worker = make_shared< thread >( [ &service ] ( )
+        {
+            GIVEN( "I publish a resource with HTTP/2 enabled" )
+            {
+                WHEN( "I open a connection with the HTTP/2 preface and send three requests at once, one with a body" )
+                {
+                    io_service io_service;
+                    tcp::socket socket( io_service );
+                    socket.connect( tcp::endpoint( asio::ip::address::from_string( "127.0.0.1" ), 1984 ) );
+                    
+                    string requests = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+                    requests += frame( 0x4, 0x0, 0, "" );
+                    requests += frame( 0x1, 0x5, 1, headers( "GET", "/resources/one" ) );
+                    requests += frame( 0x1, 0x4, 3, headers( "POST", "/resources/two", { { "content-length", "7" } } ) );
+                    requests += frame( 0x1, 0x5, 5, headers( "GET", "/resources/three" ) );
+                    requests += frame( 0x0, 0x0, 3, "pay" );
+                    requests += frame( 0x0, 0x1, 3, "load" );
+                    
+                    error_code error;
+                    asio::write( socket, asio::buffer( requests ), error );
+                    
+                    asio::streambuf buffer;
+                    const auto exchange = receive( socket, buffer, { 1, 3, 5 }, error );
+                    
+                    asio::write( socket, asio::buffer( frame( 0x1, 0x5, 7, headers( "GET", "/resources/four" ) ) ), error );
+                    const auto followup = receive( socket, buffer, { 7 }, error );
+                    
+                    REQUIRE_FALSE( error );
+                    
+                    THEN( "I should see every stream answered on the one connection" )
+                    {
+                        REQUIRE( exchange.status.at( 1 ) == "200" );
+                        REQUIRE( exchange.bodies.at( 1 ) == "Hello from /resources/one over HTTP/2" );
+                        REQUIRE( exchange.status.at( 3 ) == "other" );
+                        REQUIRE( exchange.bodies.at( 3 ) == "payload" );
+                        REQUIRE( exchange.status.at( 5 ) == "200" );
+                        REQUIRE( exchange.bodies.at( 5 ) == "Hello from /resources/three over HTTP/2" );
+                    }
+                    
+                    AND_THEN( "I should see a later stream served although earlier responses asked to close" )
+                    {
+                        REQUIRE( followup.status.at( 7 ) == "200" );
+                        REQUIRE( followup.bodies.at( 7 ) == "Hello from /resources/four over HTTP/2" );
+                    }
+                    
+                    socket.close( );
+                }
+                
+                service.stop( );
+            }
+        } );
+    } );
+    
+    service.start( settings );
+    worker->join( );
+}
+
+SCENARIO( "upgrading a cleartext HTTP/1.1 connection to HTTP/2", "[service]" )
+{
+    auto resource = make_shared< Resource >( );
+    resource->set_path( "/resources/{name: .*}" );
+    resource->set_method_handler( "GET", get_handler );
+    
+    auto settings = make_shared< Settings >( );
+    settings->set_port( 1984 );
+    settings->set_http2_enabled( true );
+    
+    shared_ptr< thread > worker = nullptr;
+    
+    Service service;
+    service.publish( resource );
+    service.set_ready_handler( [ &worker ]( Service & service )
+    {
+        worker = make_shared< thread >( [ &service ] ( )
+        {
+            GIVEN( "I publish a resource with HTTP/2 enabled" )
+            {
+                WHEN( "I send an HTTP/1.1 request asking to upgrade to h2c" )
+                {
+                    io_service io_service;
+                    tcp::socket socket( io_service );
+                    socket.connect( tcp::endpoint( asio::ip::address::from_string( "127.0.0.1" ), 1984 ) );
+                    
+                    string request = "GET /resources/upgraded HTTP/1.1\r\nHost: localhost\r\nConnection: Upgrade, HTTP2-Settings\r\nUpgrade: h2c\r\nHTTP2-Settings: AAMAAABkAAQAAP__\r\n\r\n";
+                    request += "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+                    request += frame( 0x4, 0x0, 0, "" );
+                    
+                    error_code error;
+                    asio::write( socket, asio::buffer( request ), error );
+                    
+                    asio::streambuf buffer;
+                    asio::read_until( socket, buffer, "\r\n\r\n", error );
+                    
+                    const string received( asio::buffer_cast< const char* >( buffer.data( ) ), buffer.size( ) );
+                    const auto status = received.substr( 0, received.find( "\r\n" ) );
+                    buffer.consume( received.find( "\r\n\r\n" ) + 4 );
+                    
+                    const auto exchange = receive( socket, buffer, { 1 }, error );
+                    
+                    THEN( "I should see the protocol switched and the request answered on stream one" )
+                    {
+                        REQUIRE_FALSE( error );
+                        REQUIRE( status == "HTTP/1.1 101 Switching Protocols" );
+                        REQUIRE( exchange.status.at( 1 ) == "200" );
+                        REQUIRE( exchange.bodies.at( 1 ) == "Hello from /resources/upgraded over HTTP/2" );
+                    }
+                    
+                    socket.close( );
+                }
+                
+                service.stop( );
+            }
+        } );
+    } );
+    
+    service.start( settings );
+    worker->join( );
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <chrono>
+#include <thread>
+#include <string>
+#include <memory>
+#include <ciso646>
+#include <functional>
+#include <system_error>
+
+//Project Includes
+#include <restbed>
+
+//External Includes
+#include <asio.hpp>
+#include <catch.hpp>
+
+//System Namespaces
+using std::thread;
+using std::string;
+using std::to_string;
+using std::error_code;
+using std::shared_ptr;
+using std::make_shared;
+using std::chrono::seconds;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+using std::chrono::duration_cast;
+
+//Project Namespaces
+using namespace restbed;
+
+//External Namespaces
+using asio::ip::tcp;
+using asio::io_service;
+
+void post_handler( const shared_ptr< Session > session )
+{
+    const auto request = session->get_request( );
+    const size_t length = request->get_header( "Content-Length", 0 );
+    
+    session->fetch( length, [ ]( const shared_ptr< Session > session, const Bytes& body )
+    {
+        session->yield( 201, body, { { "Content-Length", to_string( body.size( ) ) } } );
+    } );
+}
+
+void get_handler( const shared_ptr< Session > session )
+{
+    const auto request = session->get_request( );
+    const auto body = to_string( request->get_path_parameters( ).size( ) ) + ":" + to_string( request->get_body( ).size( ) );
+    
+    session->yield( 200, body, { { "Content-Length", to_string( body.length( ) ) } } );
+}
+
+string exchange( const string& requests, error_code& error )
+{
+    io_service io_service;
+    tcp::socket socket( io_service );
+    tcp::endpoint endpoint( asio::ip::address::from_string( "127.0.0.1" ), 1984 );
+    
+    socket.connect( endpoint, error );
+    
+    if ( error )
+    {
+        return "";
+    }
+    
+    asio::write( socket, asio::buffer( requests ), error );
+    
+    asio::streambuf buffer;
+    asio::read( socket, buffer, error );
+    
+    return string( asio::buffer_cast< const char* >( buffer.data( ) ), buffer.size( ) );
+}
+
+SCENARIO( "keep-alive requests start from a clean request and honour the request limit", "[session]" )
+{
+    auto echo = make_shared< Resource >( );
+    echo->set_path( "/echo/{id: .*}" );
+    echo->set_method_handler( "POST", post_handler );
+    
+    auto inspect = make_shared< Resource >( );
+    inspect->set_path( "/inspect" );
+    inspect->set_method_handler( "GET", get_handler );
+    
+    auto settings = make_shared< Settings >( );
+    settings->set_port( 1984 );
+    settings->set_keep_alive_limit( 2 );
+    
+    shared_ptr< thread > worker = nullptr;
+    
+    Service service;
+    service.publish( echo );
+    service.publish( inspect );
+    service.set_ready_handler( [ &worker ]( Service & service )
+    {
+        worker = make_shared< thread >( [ &service ] ( )
+        {
+            GIVEN( "I publish resources with a keep-alive limit of two requests" )
+            {
+                WHEN( "I send three requests over one connection, the first with a path parameter and a body" )
+                {
+                    string requests = "POST /echo/1 HTTP/1.1\r\nHost: localhost\r\nContent-Length: 5\r\n\r\nhello";
+                    requests += "GET /inspect HTTP/1.1\r\nHost: localhost\r\n\r\n";
+                    requests += "GET /inspect HTTP/1.1\r\nHost: localhost\r\n\r\n";
+                    
+                    error_code error;
+                    const auto responses = exchange( requests, error );
+                    
+                    THEN( "I should see the second request free of the first's state" )
+                    {
+                        REQUIRE( error == asio::error::eof );
+                        REQUIRE( responses.find( "\r\n\r\nhello" ) not_eq string::npos );
+                        REQUIRE( responses.find( "\r\n\r\n0:0" ) not_eq string::npos );
+                    }
+                    
+                    AND_THEN( "I should see the connection closed after the second response" )
+                    {
+                        REQUIRE( responses.find( "Connection: close" ) not_eq string::npos );
+                        REQUIRE( responses.find( "0:0" ) == responses.rfind( "0:0" ) );
+                    }
+                }
+                
+                service.stop( );
+            }
+        } );
+    } );
+    
+    service.start( settings );
+    worker->join( );
+}
+
+SCENARIO( "idle keep-alive connections are closed after the keep-alive timeout", "[session]" )
+{
+    auto inspect = make_shared< Resource >( );
+    inspect->set_path( "/inspect" );
+    inspect->set_method_handler( "GET", get_handler );
+    
+    auto settings = make_shared< Settings >( );
+    settings->set_port( 1984 );
+    settings->set_connection_timeout( seconds( 10 ) );
+    settings->set_keep_alive_timeout( milliseconds( 200 ) );
+    
+    shared_ptr< thread > worker = nullptr;
+    
+    Service service;
+    service.publish( inspect );
+    service.set_ready_handler( [ &worker ]( Service & service )
+    {
+        worker = make_shared< thread >( [ &service ] ( )
+        {
+            GIVEN( "I publish a resource with a '200' millisecond keep-alive timeout" )
+            {
+                WHEN( "I send one request and leave the connection idle" )
+                {
+                    const auto start = steady_clock::now( );
+                    
+                    error_code error;
+                    const auto responses = exchange( "GET /inspect HTTP/1.1\r\nHost: localhost\r\n\r\n", error );
+                    
+                    const auto elapsed = duration_cast< milliseconds >( steady_clock::now( ) - start );
+                    
+                    THEN( "I should see the response and then the connection closed well before the connection timeout" )
+                    {
+                        REQUIRE( responses.find( "\r\n\r\n0:0" ) not_eq string::npos );
+                        REQUIRE( elapsed < seconds( 5 ) );
+                    }
+                }
+                
+                service.stop( );
+            }
+        } );
+    } );
+    
+    service.start( settings );
+    worker->join( );
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <thread>
+#include <string>
+#include <memory>
+#include <functional>
+
+//Project Includes
+#include <restbed>
+
+//External Includes
+#include <catch.hpp>
+
+//System Namespaces
+using std::thread;
+using std::string;
+using std::to_string;
+using std::shared_ptr;
+using std::make_shared;
+
+//Project Namespaces
+using namespace restbed;
+
+//External Namespaces
+
+const string expected_body( 200000, 'x' );
+
+void post_handler( const shared_ptr< Session > session )
+{
+    const auto request = session->get_request( );
+    const size_t length = request->get_header( "Content-Length", 0 );
+    
+    session->fetch( length, [ ]( const shared_ptr< Session > session, const Bytes & body )
+    {
+        const auto file = session->get_request( )->get_body_file( );
+        
+        if ( file == nullptr )
+        {
+            const auto size = to_string( body.size( ) );
+            return session->close( 200, size, { { "Content-Length", to_string( size.length( ) ) } } );
+        }
+        
+        const bool valid = body.empty( ) and file->get_size( ) == expected_body.length( ) and String::to_string( file->read( 0, file->get_size( ) ) ) == expected_body;
+        session->close( valid ? 201 : 500, "", { { "Content-Length", "0" } } );
+    } );
+}
+
+SCENARIO( "spilling large request bodies to disk", "[session]" )
+{
+    auto resource = make_shared< Resource >( );
+    resource->set_path( "/resources" );
+    resource->set_method_handler( "POST", post_handler );
+    
+    auto settings = make_shared< Settings >( );
+    settings->set_port( 1984 );
+    settings->set_body_spill_threshold( 1024 );
+    settings->set_default_header( "Connection", "close" );
+    
+    shared_ptr< thread > worker = nullptr;
+    
+    Service service;
+    service.publish( resource );
+    service.set_ready_handler( [ &worker ]( Service & service )
+    {
+        worker = make_shared< thread >( [ &service ] ( )
+        {
+            GIVEN( "I publish a resource at '/resources' with a spill threshold of 1024 bytes" )
+            {
+                WHEN( "I perform a HTTP 'POST' request with a body below the threshold" )
+                {
+                    auto request = make_shared< Request >( );
+                    request->set_port( 1984 );
+                    request->set_method( "POST" );
+                    request->set_host( "localhost" );
+                    request->set_path( "/resources" );
+                    request->set_body( "hello" );
+                    request->set_header( "Content-Length", "5" );
+                    
+                    auto response = Http::sync( request );
+                    
+                    THEN( "I should see the body held in memory" )
+                    {
+                        REQUIRE( 200 == response->get_status_code( ) );
+                        
+                        const size_t length = response->get_header( "Content-Length", 0 );
+                        Http::fetch( length, response );
+                        REQUIRE( String::to_string( response->get_body( ) ) == "5" );
+                    }
+                }
+                
+                WHEN( "I perform a HTTP 'POST' request with a body above the threshold" )
+                {
+                    auto request = make_shared< Request >( );
+                    request->set_port( 1984 );
+                    request->set_method( "POST" );
+                    request->set_host( "localhost" );
+                    request->set_path( "/resources" );
+                    request->set_body( expected_body );
+                    request->set_header( "Content-Length", to_string( expected_body.length( ) ) );
+                    
+                    auto response = Http::sync( request );
+                    
+                    THEN( "I should see a '201' (Created) status code confirming the body was written to a file" )
+                    {
+                        REQUIRE( 201 == response->get_status_code( ) );
+                    }
+                }
+                
+                service.stop( );
+            }
+        } );
+    } );
+    
+    service.start( settings );
+    worker->join( );
+}
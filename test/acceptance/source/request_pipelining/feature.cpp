@@ -0,0 +1,129 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <chrono>
+#include <thread>
+#include <string>
+#include <memory>
+#include <ciso646>
+#include <functional>
+#include <system_error>
+
+//Project Includes
+#include <restbed>
+
+//External Includes
+#include <asio.hpp>
+#include <catch.hpp>
+
+//System Namespaces
+using std::thread;
+using std::string;
+using std::to_string;
+using std::error_code;
+using std::shared_ptr;
+using std::make_shared;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+using std::chrono::duration_cast;
+
+//Project Namespaces
+using namespace restbed;
+
+//External Namespaces
+using asio::ip::tcp;
+using asio::io_service;
+
+void get_handler( const shared_ptr< Session > session )
+{
+    const auto request = session->get_request( );
+    const auto id = request->get_query_parameter( "id" );
+    
+    std::this_thread::sleep_for( milliseconds( 200 ) );
+    
+    if ( request->get_header( "Connection" ) == "close" )
+    {
+        return session->close( 200, id, { { "Content-Length", to_string( id.length( ) ) } } );
+    }
+    
+    session->yield( 200, id, { { "Content-Length", to_string( id.length( ) ) } } );
+}
+
+SCENARIO( "pipelined requests are dispatched concurrently and answered in order", "[session]" )
+{
+    auto resource = make_shared< Resource >( );
+    resource->set_path( "/resource" );
+    resource->set_method_handler( "GET", get_handler );
+    
+    auto settings = make_shared< Settings >( );
+    settings->set_port( 1984 );
+    settings->set_worker_limit( 4 );
+    settings->set_pipeline_limit( 16 );
+    
+    shared_ptr< thread > worker = nullptr;
+    
+    Service service;
+    service.publish( resource );
+    service.set_ready_handler( [ &worker ]( Service & service )
+    {
+        worker = make_shared< thread >( [ &service ] ( )
+        {
+            GIVEN( "I publish a resource that takes '200' milliseconds to answer" )
+            {
+                WHEN( "I pipeline five requests over a single connection" )
+                {
+                    io_service io_service;
+                    tcp::socket socket( io_service );
+                    tcp::endpoint endpoint( asio::ip::address::from_string( "127.0.0.1" ), 1984 );
+                    
+                    error_code error;
+                    socket.connect( endpoint, error );
+                    REQUIRE( not error );
+                    
+                    string requests = "";
+                    
+                    for ( int id = 0; id < 5; id++ )
+                    {
+                        requests += "GET /resource?id=" + to_string( id ) + " HTTP/1.1\r\nHost: localhost\r\n";
+                        requests += ( id == 4 ) ? "Connection: close\r\n\r\n" : "\r\n";
+                    }
+                    
+                    const auto start = steady_clock::now( );
+                    asio::write( socket, asio::buffer( requests ), error );
+                    
+                    asio::streambuf buffer;
+                    asio::read( socket, buffer, error );
+                    
+                    const auto elapsed = duration_cast< milliseconds >( steady_clock::now( ) - start );
+                    const string responses( asio::buffer_cast< const char* >( buffer.data( ) ), buffer.size( ) );
+                    
+                    THEN( "I should see every response in request order" )
+                    {
+                        REQUIRE( error == asio::error::eof );
+                        
+                        string bodies = "";
+                        
+                        for ( auto position = responses.find( "\r\n\r\n" ); position not_eq string::npos; position = responses.find( "\r\n\r\n", position + 4 ) )
+                        {
+                            bodies += responses.substr( position + 4, 1 );
+                        }
+                        
+                        REQUIRE( bodies == "01234" );
+                    }
+                    
+                    AND_THEN( "I should see them handled concurrently" )
+                    {
+                        REQUIRE( elapsed < milliseconds( 900 ) );
+                    }
+                }
+                
+                service.stop( );
+            }
+        } );
+    } );
+    
+    service.start( settings );
+    worker->join( );
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <ciso646>
+#include <functional>
+
+//Project Includes
+#include <restbed>
+
+//External Includes
+#include <catch.hpp>
+
+//System Namespaces
+using std::mutex;
+using std::thread;
+using std::vector;
+using std::uint64_t;
+using std::lock_guard;
+using std::shared_ptr;
+using std::make_shared;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+//Project Namespaces
+using namespace restbed;
+
+//External Namespaces
+
+struct Trace
+{
+    TraceEvent event = CONNECTION_ACCEPTED;
+    uint64_t connection = 0;
+    uint64_t request = 0;
+    steady_clock::time_point timestamp { };
+};
+
+void get_handler( const shared_ptr< Session > session )
+{
+    session->close( 200, "Hello, World!", { { "Content-Length", "13" } } );
+}
+
+SCENARIO( "tracing request processing stages", "[service]" )
+{
+    auto resource = make_shared< Resource >( );
+    resource->set_path( "/resources/1" );
+    resource->set_method_handler( "GET", get_handler );
+    
+    auto settings = make_shared< Settings >( );
+    settings->set_port( 1984 );
+    settings->set_default_header( "Connection", "close" );
+    
+    mutex lock;
+    vector< Trace > traces;
+    shared_ptr< thread > worker = nullptr;
+    
+    Service service;
+    service.publish( resource );
+    service.set_trace_handler( [ &lock, &traces ]( const TraceEvent event, const uint64_t connection, const uint64_t request, const steady_clock::time_point & timestamp )
+    {
+        lock_guard< mutex > guard( lock );
+        
+        Trace trace;
+        trace.event = event;
+        trace.connection = connection;
+        trace.request = request;
+        trace.timestamp = timestamp;
+        traces.push_back( trace );
+    } );
+    service.set_ready_handler( [ &worker, &lock, &traces ]( Service & service )
+    {
+        worker = make_shared< thread >( [ &service, &lock, &traces ] ( )
+        {
+            GIVEN( "I publish a resource at '/resources/1' with a trace handler" )
+            {
+                WHEN( "I perform a HTTP 'GET' request to '/resources/1'" )
+                {
+                    auto request = make_shared< Request >( );
+                    request->set_port( 1984 );
+                    request->set_host( "localhost" );
+                    request->set_path( "/resources/1" );
+                    
+                    auto response = Http::sync( request );
+                    std::this_thread::sleep_for( milliseconds( 500 ) );
+                    
+                    THEN( "I should see a '200' (OK) status code" )
+                    {
+                        REQUIRE( 200 == response->get_status_code( ) );
+                    }
+                    
+                    AND_THEN( "I should see each processing stage traced in order" )
+                    {
+                        lock_guard< mutex > guard( lock );
+                        
+                        const vector< TraceEvent > expectation =
+                        {
+                            CONNECTION_ACCEPTED,
+                            HEADERS_RECEIVED,
+                            REQUEST_PARSED,
+                            ROUTE_RESOLVED,
+                            RULES_COMPLETED,
+                            HANDLER_STARTED,
+                            HANDLER_FINISHED,
+                            WRITE_QUEUED,
+                            WRITE_COMPLETED
+                        };
+                        
+                        REQUIRE( traces.size( ) == expectation.size( ) );
+                        
+                        for ( size_t index = 0; index < traces.size( ); index++ )
+                        {
+                            REQUIRE( traces[ index ].event == expectation[ index ] );
+                            REQUIRE( traces[ index ].connection == 1 );
+                            REQUIRE( traces[ index ].timestamp >= traces.front( ).timestamp );
+                        }
+                        
+                        REQUIRE( traces.front( ).request == 0 );
+                        REQUIRE( traces.back( ).request == 1 );
+                    }
+                }
+                
+                service.stop( );
+            }
+        } );
+    } );
+    
+    service.start( settings );
+    worker->join( );
+}
@@ -41,12 +41,24 @@ void json_method_handler( const shared_ptr< Session > session )
     session->close( 2 );
 }
 
+void text_method_handler( const shared_ptr< Session > session )
+{
+    session->close( 3 );
+}
+
+void csv_method_handler( const shared_ptr< Session > session )
+{
+    session->close( 4 );
+}
+
 SCENARIO( "resource method filters", "[resource]" )
 {
     auto resource = make_shared< Resource >( );
     resource->set_path( "/resource" );
     resource->set_method_handler( "GET", { { "Content-Type", "application/xml" } }, xml_method_handler );
     resource->set_method_handler( "GET", { { "Content-Type", "application/json" } }, json_method_handler );
+    resource->set_method_handler( "GET", { { "Content-Type", "text/.*" } }, text_method_handler );
+    resource->set_method_handler( "GET", { { "Content-Type", "application/(vnd\\.)?csv" } }, csv_method_handler );
     
     auto settings = make_shared< Settings >( );
     settings->set_port( 1984 );
@@ -102,6 +114,46 @@ SCENARIO( "resource method filters", "[resource]" )
                     }
                 }
                 
+                WHEN( "I perform a HTTP 'GET' request to '/resource' with header 'Content-Type: text/plain'" )
+                {
+                    auto request = make_shared< Request >( );
+                    request->set_port( 1984 );
+                    request->set_host( "localhost" );
+                    request->set_path( "/resource" );
+                    
+                    multimap< string, string > headers;
+                    headers.insert( make_pair( "content-type", "text/plain" ) );
+                    request->set_headers( headers );
+                    
+                    auto response = Http::sync( request );
+                    
+                    THEN( "I should see a '3' (No Appropriate Status Message Found) status code" )
+                    {
+                        REQUIRE( 3 == response->get_status_code( ) );
+                        REQUIRE( "No Appropriate Status Message Found" == response->get_status_message( ) );
+                    }
+                }
+                
+                WHEN( "I perform a HTTP 'GET' request to '/resource' with header 'Content-Type: application/vnd.csv'" )
+                {
+                    auto request = make_shared< Request >( );
+                    request->set_port( 1984 );
+                    request->set_host( "localhost" );
+                    request->set_path( "/resource" );
+                    
+                    multimap< string, string > headers;
+                    headers.insert( make_pair( "content-type", "application/vnd.csv" ) );
+                    request->set_headers( headers );
+                    
+                    auto response = Http::sync( request );
+                    
+                    THEN( "I should see a '4' (No Appropriate Status Message Found) status code" )
+                    {
+                        REQUIRE( 4 == response->get_status_code( ) );
+                        REQUIRE( "No Appropriate Status Message Found" == response->get_status_message( ) );
+                    }
+                }
+                
                 service.stop( );
             }
         } );
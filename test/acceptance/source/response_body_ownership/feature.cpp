@@ -0,0 +1,104 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <map>
+#include <thread>
+#include <string>
+#include <memory>
+#include <utility>
+#include <functional>
+
+//Project Includes
+#include <restbed>
+
+//External Includes
+#include <catch.hpp>
+
+//System Namespaces
+using std::thread;
+using std::string;
+using std::multimap;
+using std::shared_ptr;
+using std::make_shared;
+
+//Project Namespaces
+using namespace restbed;
+
+//External Namespaces
+
+void get_handler( const shared_ptr< Session > session )
+{
+    static const auto raw = make_shared< const Bytes >( String::to_bytes( "HTTP/1.1 200 OK\r\nContent-Length: 5\r\nConnection: close\r\n\r\nhello" ) );
+    
+    const auto mode = session->get_request( )->get_query_parameter( "mode" );
+    
+    if ( mode == "shared" )
+    {
+        return session->close( raw );
+    }
+    
+    if ( mode == "moved" )
+    {
+        Response response;
+        response.set_status_code( 200 );
+        response.set_header( "Content-Length", "5" );
+        response.set_body( Bytes { 'h', 'e', 'l', 'l', 'o' } );
+        
+        return session->close( std::move( response ) );
+    }
+    
+    session->close( 200, Bytes { 'h', 'e', 'l', 'l', 'o' }, { { "Content-Length", "5" } } );
+}
+
+SCENARIO( "closing a session with moved and shared response bodies", "[session]" )
+{
+    auto resource = make_shared< Resource >( );
+    resource->set_path( "/resources" );
+    resource->set_method_handler( "GET", get_handler );
+    
+    auto settings = make_shared< Settings >( );
+    settings->set_port( 1984 );
+    settings->set_default_header( "Connection", "close" );
+    
+    shared_ptr< thread > worker = nullptr;
+    
+    Service service;
+    service.publish( resource );
+    service.set_ready_handler( [ &worker ]( Service & service )
+    {
+        worker = make_shared< thread >( [ &service ] ( )
+        {
+            GIVEN( "I publish a resource at '/resources' that hands its body over without copying" )
+            {
+                for ( const string mode : { "shared", "moved", "status" } )
+                {
+                    WHEN( "I perform a HTTP 'GET' request with mode '" + mode + "'" )
+                    {
+                        auto request = make_shared< Request >( );
+                        request->set_port( 1984 );
+                        request->set_host( "localhost" );
+                        request->set_path( "/resources" );
+                        request->set_query_parameter( "mode", mode );
+                        
+                        auto response = Http::sync( request );
+                        
+                        THEN( "I should see a '200' (OK) status code and the body 'hello'" )
+                        {
+                            REQUIRE( 200 == response->get_status_code( ) );
+                            
+                            Http::fetch( 5, response );
+                            REQUIRE( String::to_string( response->get_body( ) ) == "hello" );
+                        }
+                    }
+                }
+                
+                service.stop( );
+            }
+        } );
+    } );
+    
+    service.start( settings );
+    worker->join( );
+}
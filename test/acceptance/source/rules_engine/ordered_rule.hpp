@@ -0,0 +1,69 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <thread>
+#include <string>
+#include <memory>
+#include <ciso646>
+#include <functional>
+
+//Project Includes
+#include <restbed>
+
+//External Includes
+
+//System Namespaces
+using std::thread;
+using std::string;
+using std::function;
+using std::shared_ptr;
+
+//Project Namespaces
+using namespace restbed;
+
+//External Namespaces
+
+class OrderedRule : public Rule
+{
+    public:
+        OrderedRule( const char marker, const bool asynchronous, string& trail ) : Rule( ),
+            m_marker( marker ),
+            m_asynchronous( asynchronous ),
+            m_trail( trail )
+        {
+            return;
+        }
+        
+        virtual ~OrderedRule( void )
+        {
+            return;
+        }
+        
+        bool condition( const shared_ptr< Session > ) final override
+        {
+            return true;
+        }
+        
+        void action( const shared_ptr< Session > session, const function< void ( const shared_ptr< Session > ) >& callback ) final override
+        {
+            m_trail.push_back( m_marker );
+            
+            if ( m_asynchronous )
+            {
+                thread( callback, session ).detach( );
+            }
+            else
+            {
+                callback( session );
+            }
+        }
+        
+    private:
+        const char m_marker;
+        
+        const bool m_asynchronous;
+        
+        string& m_trail;
+};
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <thread>
+#include <string>
+#include <memory>
+#include <ciso646>
+#include <functional>
+
+//Project Includes
+#include <restbed>
+#include "ordered_rule.hpp"
+
+//External Includes
+#include <catch.hpp>
+
+//System Namespaces
+using std::thread;
+using std::string;
+using std::to_string;
+using std::shared_ptr;
+using std::make_shared;
+
+//Project Namespaces
+using namespace restbed;
+
+//External Namespaces
+
+string trail = "";
+
+void get_method_handler( const shared_ptr< Session > session )
+{
+    session->close( OK, trail, { { "Content-Length", to_string( trail.length( ) ) } } );
+}
+
+SCENARIO( "rules engine ordering with inline and asynchronous actions", "[resource]" )
+{
+    const string markers = "ABCDEFGHIJKLMNO";
+    
+    auto resource = make_shared< Resource >( );
+    resource->set_path( "/resources" );
+    resource->set_method_handler( "GET", get_method_handler );
+    
+    auto settings = make_shared< Settings >( );
+    settings->set_port( 1984 );
+    settings->set_default_header( "Connection", "close" );
+    
+    Service service;
+    
+    for ( int index = static_cast< int >( markers.length( ) ) - 1; index >= 0; index-- )
+    {
+        const auto asynchronous = ( index % 3 == 0 );
+        const auto rule = make_shared< OrderedRule >( markers[ index ], asynchronous, trail );
+        
+        if ( index < 5 )
+        {
+            service.add_rule( rule, index );
+        }
+        else
+        {
+            resource->add_rule( rule, index );
+        }
+    }
+    
+    service.publish( resource );
+    
+    shared_ptr< thread > worker = nullptr;
+    
+    service.set_ready_handler( [ &worker, &markers ]( Service & service )
+    {
+        worker = make_shared< thread >( [ &service, &markers ] ( )
+        {
+            GIVEN( "I publish a resource with fifteen prioritised rules, every third completing asynchronously" )
+            {
+                WHEN( "I perform two HTTP 'GET' requests to '/resources'" )
+                {
+                    auto request = make_shared< Request >( );
+                    request->set_port( 1984 );
+                    request->set_host( "localhost" );
+                    request->set_path( "/resources" );
+                    
+                    trail.clear( );
+                    auto response = Http::sync( request );
+                    auto body = Http::fetch( markers.length( ), response );
+                    
+                    THEN( "I should see every rule applied once in priority order" )
+                    {
+                        REQUIRE( 200 == response->get_status_code( ) );
+                        REQUIRE( markers == string( body.begin( ), body.end( ) ) );
+                    }
+                    
+                    request = make_shared< Request >( );
+                    request->set_port( 1984 );
+                    request->set_host( "localhost" );
+                    request->set_path( "/resources" );
+                    
+                    trail.clear( );
+                    response = Http::sync( request );
+                    body = Http::fetch( markers.length( ), response );
+                    
+                    AND_THEN( "I should see the same order for a subsequent request" )
+                    {
+                        REQUIRE( 200 == response->get_status_code( ) );
+                        REQUIRE( markers == string( body.begin( ), body.end( ) ) );
+                    }
+                }
+                
+                service.stop( );
+            }
+        } );
+    } );
+    
+    service.start( settings );
+    worker->join( );
+}
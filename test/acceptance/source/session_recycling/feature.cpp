@@ -0,0 +1,100 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <map>
+#include <thread>
+#include <string>
+#include <memory>
+#include <ciso646>
+#include <utility>
+#include <functional>
+
+//Project Includes
+#include <restbed>
+
+//External Includes
+#include <catch.hpp>
+
+//System Namespaces
+using std::thread;
+using std::string;
+using std::multimap;
+using std::make_pair;
+using std::shared_ptr;
+using std::make_shared;
+
+//Project Namespaces
+using namespace restbed;
+
+//External Namespaces
+
+void get_handler( const shared_ptr< Session > session )
+{
+    const auto request = session->get_request( );
+    
+    if ( session->has( "visited" ) or request->has_path_parameter( "id" ) or request->has_query_parameter( "first" ) == request->has_header( "X-Second" ) )
+    {
+        return session->close( 500 );
+    }
+    
+    session->set( "visited", true );
+    session->close( 204 );
+}
+
+SCENARIO( "recycled sessions and requests start from a clean state", "[session]" )
+{
+    auto resource = make_shared< Resource >( );
+    resource->set_path( "/resources" );
+    resource->set_method_handler( "GET", get_handler );
+    
+    auto settings = make_shared< Settings >( );
+    settings->set_port( 1984 );
+    settings->set_default_header( "Connection", "close" );
+    
+    shared_ptr< thread > worker = nullptr;
+    
+    Service service;
+    service.publish( resource );
+    service.set_ready_handler( [ &worker ]( Service & service )
+    {
+        worker = make_shared< thread >( [ &service ] ( )
+        {
+            GIVEN( "I publish a resource at '/resources' that fails on state left by a previous connection" )
+            {
+                WHEN( "I perform consecutive HTTP 'GET' requests on new connections" )
+                {
+                    for ( int index = 0; index < 8; index++ )
+                    {
+                        auto request = make_shared< Request >( );
+                        request->set_port( 1984 );
+                        request->set_host( "localhost" );
+                        request->set_path( "/resources" );
+                        
+                        if ( index % 2 == 0 )
+                        {
+                            request->set_query_parameter( "first", "true" );
+                        }
+                        else
+                        {
+                            request->set_header( "X-Second", "true" );
+                        }
+                        
+                        auto response = Http::sync( request );
+                        
+                        THEN( "I should see a '204' (No Content) status code" )
+                        {
+                            REQUIRE( 204 == response->get_status_code( ) );
+                        }
+                    }
+                }
+                
+                service.stop( );
+            }
+        } );
+    } );
+    
+    service.start( settings );
+    worker->join( );
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <thread>
+#include <string>
+#include <memory>
+#include <ciso646>
+#include <stdexcept>
+#include <functional>
+
+//Project Includes
+#include <restbed>
+
+//External Includes
+#include <catch.hpp>
+
+//System Namespaces
+using std::thread;
+using std::string;
+using std::shared_ptr;
+using std::make_shared;
+
+//Project Namespaces
+using namespace restbed;
+
+//External Namespaces
+
+void get_handler( const shared_ptr< Session > session, const string& name, const int& id )
+{
+    REQUIRE( 100 == id );
+    REQUIRE( "events" == name );
+    
+    session->close( 204 );
+}
+
+SCENARIO( "typed route path parameters", "[resource]" )
+{
+    Route< string, int > route( "/resources/queues/{name:string}/messages/{id:int}" );
+    route.set_method_handler( "GET", get_handler );
+    
+    auto resource = route.get_resource( );
+    resource->set_default_header( "Connection", "close" );
+    
+    auto settings = make_shared< Settings >( );
+    settings->set_port( 1984 );
+    
+    shared_ptr< thread > worker = nullptr;
+    
+    Service service;
+    service.publish( resource );
+    service.set_ready_handler( [ &worker ]( Service & service )
+    {
+        worker = make_shared< thread >( [ &service ] ( )
+        {
+            GIVEN( "I publish a route at '/resources/queues/{name:string}/messages/{id:int}' with a HTTP 'GET' method handler" )
+            {
+                WHEN( "I perform a HTTP 'GET' request to '/resources/queues/events/messages/100'" )
+                {
+                    auto request = make_shared< Request >( );
+                    request->set_port( 1984 );
+                    request->set_host( "localhost" );
+                    request->set_path( "/resources/queues/events/messages/100" );
+                    
+                    auto response = Http::sync( request );
+                    
+                    THEN( "I should see a '204' (No Content) status code" )
+                    {
+                        REQUIRE( 204 == response->get_status_code( ) );
+                        REQUIRE( "No Content" == response->get_status_message( ) );
+                    }
+                }
+                
+                WHEN( "I perform a HTTP 'GET' request to '/resources/queues/events/messages/one'" )
+                {
+                    auto request = make_shared< Request >( );
+                    request->set_port( 1984 );
+                    request->set_host( "localhost" );
+                    request->set_path( "/resources/queues/events/messages/one" );
+                    
+                    auto response = Http::sync( request );
+                    
+                    THEN( "I should see a '404' (Not Found) status code" )
+                    {
+                        REQUIRE( 404 == response->get_status_code( ) );
+                    }
+                }
+                
+                WHEN( "I perform a HTTP 'GET' request to '/resources/queues/events/messages/99999999999999999999'" )
+                {
+                    auto request = make_shared< Request >( );
+                    request->set_port( 1984 );
+                    request->set_host( "localhost" );
+                    request->set_path( "/resources/queues/events/messages/99999999999999999999" );
+                    
+                    auto response = Http::sync( request );
+                    
+                    THEN( "I should see a '400' (Bad Request) status code" )
+                    {
+                        REQUIRE( 400 == response->get_status_code( ) );
+                    }
+                }
+                
+                service.stop( );
+            }
+        } );
+    } );
+    
+    service.start( settings );
+    worker->join( );
+}
@@ -0,0 +1,360 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <cmath>
+#include <atomic>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include <ciso646>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <condition_variable>
+
+//Project Includes
+#include "load_generator.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::mutex;
+using std::size_t;
+using std::thread;
+using std::string;
+using std::vector;
+using std::uint64_t;
+using std::unique_lock;
+using std::shared_ptr;
+using std::lock_guard;
+using std::runtime_error;
+using std::condition_variable;
+using std::chrono::seconds;
+using std::chrono::duration;
+using std::chrono::nanoseconds;
+using std::chrono::duration_cast;
+
+//Project Namespaces
+
+//External Namespaces
+using asio::ip::tcp;
+using asio::io_service;
+using asio::error_code;
+
+PlainTransport::PlainTransport( io_service& io_service, const std::uint16_t port ) : m_socket( io_service )
+{
+    m_socket.connect( tcp::endpoint( asio::ip::address_v4::loopback( ), port ) );
+    m_socket.set_option( tcp::no_delay( true ) );
+}
+
+void PlainTransport::write( const char* data, const size_t length )
+{
+    asio::write( m_socket, asio::buffer( data, length ) );
+}
+
+size_t PlainTransport::read_some( char* data, const size_t length )
+{
+    return m_socket.read_some( asio::buffer( data, length ) );
+}
+
+void PlainTransport::abort( void )
+{
+    error_code error;
+    m_socket.shutdown( tcp::socket::shutdown_both, error );
+}
+
+#ifdef BUILD_SSL
+SecureTransport::SecureTransport( io_service& io_service, asio::ssl::context& context, const std::uint16_t port ) : m_stream( io_service, context )
+{
+    m_stream.lowest_layer( ).connect( tcp::endpoint( asio::ip::address_v4::loopback( ), port ) );
+    m_stream.lowest_layer( ).set_option( tcp::no_delay( true ) );
+    m_stream.handshake( asio::ssl::stream_base::client );
+}
+
+void SecureTransport::write( const char* data, const size_t length )
+{
+    asio::write( m_stream, asio::buffer( data, length ) );
+}
+
+size_t SecureTransport::read_some( char* data, const size_t length )
+{
+    return m_stream.read_some( asio::buffer( data, length ) );
+}
+
+void SecureTransport::abort( void )
+{
+    error_code error;
+    m_stream.lowest_layer( ).shutdown( tcp::socket::shutdown_both, error );
+}
+#endif
+
+Connection::Connection( const shared_ptr< Transport >& transport ) : m_transport( transport ),
+    m_buffer( )
+{
+    return;
+}
+
+void Connection::abort( void )
+{
+    auto transport = m_transport;
+    
+    if ( transport not_eq nullptr )
+    {
+        transport->abort( );
+    }
+}
+
+void Connection::reset( const shared_ptr< Transport >& transport )
+{
+    m_buffer.clear( );
+    m_transport = transport;
+}
+
+void Connection::send( const string& data )
+{
+    m_transport->write( data.data( ), data.size( ) );
+}
+
+string Connection::receive( const size_t length )
+{
+    char chunk[ 16384 ];
+    
+    while ( m_buffer.size( ) < length )
+    {
+        const auto size = m_transport->read_some( chunk, sizeof( chunk ) );
+        m_buffer.append( chunk, size );
+    }
+    
+    const auto data = m_buffer.substr( 0, length );
+    m_buffer.erase( 0, length );
+    
+    return data;
+}
+
+string Connection::receive_until( const string& delimiter )
+{
+    char chunk[ 16384 ];
+    size_t offset = 0;
+    size_t position = string::npos;
+    
+    while ( ( position = m_buffer.find( delimiter, offset ) ) == string::npos )
+    {
+        offset = ( m_buffer.size( ) < delimiter.size( ) ) ? 0 : m_buffer.size( ) - delimiter.size( );
+        
+        const auto size = m_transport->read_some( chunk, sizeof( chunk ) );
+        m_buffer.append( chunk, size );
+    }
+    
+    return receive( position + delimiter.size( ) );
+}
+
+int Connection::receive_response( string* body )
+{
+    auto headers = receive_until( "\r\n\r\n" );
+    
+    if ( headers.compare( 0, 5, "HTTP/" ) not_eq 0 or headers.size( ) < 12 )
+    {
+        throw runtime_error( "Malformed response status line." );
+    }
+    
+    const auto status = std::atoi( headers.data( ) + 9 );
+    
+    std::transform( headers.begin( ), headers.end( ), headers.begin( ), ::tolower );
+    const auto position = headers.find( "\r\ncontent-length:" );
+    const size_t length = ( position == string::npos ) ? 0 : std::strtoull( headers.data( ) + position + 17, nullptr, 10 );
+    
+    if ( body not_eq nullptr )
+    {
+        *body = receive( length );
+    }
+    else if ( length not_eq 0 )
+    {
+        receive( length );
+    }
+    
+    return status;
+}
+
+Result run( const Scenario& scenario, const Options& options )
+{
+    mutex lock;
+    size_t finished = 0;
+    condition_variable completed;
+    vector< shared_ptr< Connection > > active;
+    
+    vector< uint64_t > samples;
+    std::atomic< uint64_t > errors( 0 );
+    
+    const auto paced = scenario.paced and options.mode == OPEN_LOOP;
+    const auto interval = duration_cast< nanoseconds >( duration< double >( scenario.connections / options.rate ) );
+    
+    const auto begin = Clock::now( );
+    const auto measure = begin + options.warmup;
+    const auto finish = measure + options.duration;
+    
+    vector< thread > workers;
+    
+    for ( size_t index = 0; index < scenario.connections; index++ )
+    {
+        workers.emplace_back( [ &, index ]( )
+        {
+            io_service io_service;
+            vector< uint64_t > local;
+            shared_ptr< Connection > connection = nullptr;
+            auto scheduled = begin + ( interval * index ) / scenario.connections;
+            
+            while ( Clock::now( ) < finish and ( not paced or scheduled < finish ) )
+            {
+                try
+                {
+                    if ( connection == nullptr )
+                    {
+                        connection = scenario.connect( io_service );
+                        
+                        lock_guard< mutex > guard( lock );
+                        active.push_back( connection );
+                    }
+                    
+                    auto start = Clock::now( );
+                    
+                    if ( paced )
+                    {
+                        if ( scheduled > start )
+                        {
+                            std::this_thread::sleep_until( scheduled );
+                        }
+                        
+                        start = scheduled;
+                        scheduled += interval;
+                    }
+                    
+                    const auto position = local.size( );
+                    connection->exchange( start, local );
+                    
+                    if ( start < measure )
+                    {
+                        local.resize( position );
+                    }
+                }
+                catch ( const std::exception& )
+                {
+                    const auto now = Clock::now( );
+                    
+                    if ( now >= measure and now < finish )
+                    {
+                        errors++;
+                    }
+                    
+                    lock_guard< mutex > guard( lock );
+                    active.erase( std::remove( active.begin( ), active.end( ), connection ), active.end( ) );
+                    connection = nullptr;
+                }
+            }
+            
+            lock_guard< mutex > guard( lock );
+            samples.insert( samples.end( ), local.begin( ), local.end( ) );
+            active.erase( std::remove( active.begin( ), active.end( ), connection ), active.end( ) );
+            finished++;
+            completed.notify_all( );
+        } );
+    }
+    
+    {
+        unique_lock< mutex > guard( lock );
+        
+        const auto drained = completed.wait_until( guard, finish + seconds( 2 ), [ & ]( )
+        {
+            return finished == scenario.connections;
+        } );
+        
+        if ( not drained )
+        {
+            for ( auto& connection : active )
+            {
+                connection->abort( );
+            }
+        }
+    }
+    
+    for ( auto& worker : workers )
+    {
+        worker.join( );
+    }
+    
+    std::sort( samples.begin( ), samples.end( ) );
+    
+    auto percentile = [ &samples ]( const double rank )
+    {
+        if ( samples.empty( ) )
+        {
+            return 0.0;
+        }
+        
+        const auto position = static_cast< size_t >( std::ceil( rank * samples.size( ) ) );
+        return samples[ std::max< size_t >( position, 1 ) - 1 ] / 1000.0;
+    };
+    
+    Result result;
+    result.scenario = scenario.name;
+    result.mode = ( not scenario.paced ) ? "push" : ( options.mode == OPEN_LOOP ) ? "open" : "closed";
+    result.connections = scenario.connections;
+    result.requests = samples.size( );
+    result.errors = errors;
+    result.elapsed = duration< double >( options.duration ).count( );
+    result.throughput = result.requests / result.elapsed;
+    result.mean = ( samples.empty( ) ) ? 0 : std::accumulate( samples.begin( ), samples.end( ), 0.0 ) / samples.size( ) / 1000.0;
+    result.p50 = percentile( 0.50 );
+    result.p99 = percentile( 0.99 );
+    result.p999 = percentile( 0.999 );
+    result.max = ( samples.empty( ) ) ? 0 : samples.back( ) / 1000.0;
+    
+    return result;
+}
+
+string report( const vector< Result >& results, const bool json )
+{
+    char line[ 512 ];
+    string body = "";
+    
+    if ( json )
+    {
+        body = "[\n";
+        
+        for ( size_t index = 0; index < results.size( ); index++ )
+        {
+            const auto& result = results[ index ];
+            
+            snprintf( line, sizeof( line ),
+                      "  { \"scenario\": \"%s\", \"mode\": \"%s\", \"connections\": %zu, \"requests\": %llu, \"errors\": %llu, "
+                      "\"elapsed_s\": %.3f, \"requests_per_second\": %.1f, \"mean_us\": %.1f, \"p50_us\": %.1f, "
+                      "\"p99_us\": %.1f, \"p999_us\": %.1f, \"max_us\": %.1f }%s\n",
+                      result.scenario.data( ), result.mode.data( ), result.connections,
+                      static_cast< unsigned long long >( result.requests ), static_cast< unsigned long long >( result.errors ),
+                      result.elapsed, result.throughput, result.mean, result.p50, result.p99, result.p999, result.max,
+                      ( index + 1 < results.size( ) ) ? "," : "" );
+            
+            body.append( line );
+        }
+        
+        body.append( "]\n" );
+        return body;
+    }
+    
+    snprintf( line, sizeof( line ), "%-12s %-7s %6s %10s %7s %11s %10s %10s %10s %10s %10s\n",
+              "scenario", "mode", "conns", "requests", "errors", "req/s", "mean(us)", "p50(us)", "p99(us)", "p999(us)", "max(us)" );
+    body.append( line );
+    
+    for ( const auto& result : results )
+    {
+        snprintf( line, sizeof( line ), "%-12s %-7s %6zu %10llu %7llu %11.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                  result.scenario.data( ), result.mode.data( ), result.connections,
+                  static_cast< unsigned long long >( result.requests ), static_cast< unsigned long long >( result.errors ),
+                  result.throughput, result.mean, result.p50, result.p99, result.p999, result.max );
+        
+        body.append( line );
+    }
+    
+    return body;
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+//Project Includes
+
+//External Includes
+#include <asio.hpp>
+    
+#ifdef BUILD_SSL
+    #include <asio/ssl.hpp>
+#endif
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+typedef std::chrono::steady_clock Clock;
+
+enum Mode : int
+{
+    CLOSED_LOOP = 0,
+    OPEN_LOOP = 1
+};
+
+struct Options
+{
+    Mode mode = CLOSED_LOOP;
+    std::uint16_t port = 1984;
+    std::size_t connections = 8;
+    std::size_t workers = 0;
+    double rate = 1000;
+    std::chrono::milliseconds warmup { 1000 };
+    std::chrono::milliseconds duration { 5000 };
+    std::size_t body_size = 1024 * 1024;
+    std::size_t routes = 512;
+    std::size_t depth = 8;
+    std::size_t subscribers = 64;
+    std::size_t events = 100;
+    std::size_t message_size = 128;
+    bool json = false;
+    std::string output = "";
+    std::vector< std::string > scenarios { };
+};
+
+struct Result
+{
+    std::string scenario = "";
+    std::string mode = "";
+    std::size_t connections = 0;
+    std::uint64_t requests = 0;
+    std::uint64_t errors = 0;
+    double elapsed = 0;
+    double throughput = 0;
+    double mean = 0;
+    double p50 = 0;
+    double p99 = 0;
+    double p999 = 0;
+    double max = 0;
+};
+
+class Transport
+{
+    public:
+        virtual ~Transport( void ) = default;
+        
+        virtual void write( const char* data, const std::size_t length ) = 0;
+        
+        virtual std::size_t read_some( char* data, const std::size_t length ) = 0;
+        
+        virtual void abort( void ) = 0;
+};
+
+class PlainTransport : public Transport
+{
+    public:
+        PlainTransport( asio::io_service& io_service, const std::uint16_t port );
+        
+        void write( const char* data, const std::size_t length );
+        
+        std::size_t read_some( char* data, const std::size_t length );
+        
+        void abort( void );
+    
+    private:
+        asio::ip::tcp::socket m_socket;
+};
+
+#ifdef BUILD_SSL
+class SecureTransport : public Transport
+{
+    public:
+        SecureTransport( asio::io_service& io_service, asio::ssl::context& context, const std::uint16_t port );
+        
+        void write( const char* data, const std::size_t length );
+        
+        std::size_t read_some( char* data, const std::size_t length );
+        
+        void abort( void );
+    
+    private:
+        asio::ssl::stream< asio::ip::tcp::socket > m_stream;
+};
+#endif
+
+class Connection
+{
+    public:
+        explicit Connection( const std::shared_ptr< Transport >& transport );
+        
+        virtual ~Connection( void ) = default;
+        
+        //Perform one unit of work, recording a latency sample (nanoseconds since start) per completed request.
+        virtual void exchange( const Clock::time_point& start, std::vector< std::uint64_t >& samples ) = 0;
+        
+        void abort( void );
+    
+    protected:
+        void reset( const std::shared_ptr< Transport >& transport );
+        
+        void send( const std::string& data );
+        
+        std::string receive( const std::size_t length );
+        
+        std::string receive_until( const std::string& delimiter );
+        
+        int receive_response( std::string* body = nullptr );
+        
+        std::shared_ptr< Transport > m_transport;
+    
+    private:
+        std::string m_buffer;
+};
+
+struct Scenario
+{
+    std::string name = "";
+    bool paced = true;
+    std::size_t connections = 0;
+    std::function< std::shared_ptr< Connection > ( asio::io_service& ) > connect = nullptr;
+};
+
+Result run( const Scenario& scenario, const Options& options );
+
+std::string report( const std::vector< Result >& results, const bool json );
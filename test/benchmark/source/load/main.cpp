@@ -0,0 +1,296 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ *
+ * Load generator measuring request throughput and latency against an
+ * in-process service.
+ *
+ * Usage:
+ *    ./load_benchmark_suite [--scenario get,pipelined,...|all] [--mode closed|open] [--rate N]
+ *                           [--connections N] [--warmup S] [--duration S] [--workers N] [--port N]
+ *                           [--body-size N] [--routes N] [--depth N] [--subscribers N] [--events N]
+ *                           [--message-size N] [--json] [--output FILE]
+ *
+ * Closed-loop mode issues the next request as soon as the previous response
+ * arrives. Open-loop mode issues requests at a fixed aggregate rate and
+ * measures latency from the intended send time, so queueing delay caused by
+ * a stalled server is not hidden (coordinated omission).
+ */
+
+//System Includes
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <cstdint>
+#include <ciso646>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+//Project Includes
+#include <restbed>
+#include "scenarios.hpp"
+#include "load_generator.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::string;
+using std::thread;
+using std::vector;
+using std::promise;
+using std::shared_ptr;
+using std::make_shared;
+using std::invalid_argument;
+using std::chrono::seconds;
+using std::chrono::milliseconds;
+
+//Project Namespaces
+using namespace restbed;
+
+//External Namespaces
+
+static void usage( void )
+{
+    string scenarios = "";
+    
+    for ( const auto& name : available_scenarios( ) )
+    {
+        scenarios += ( scenarios.empty( ) ) ? name : "," + name;
+    }
+    
+    fprintf( stderr, "Usage: load_benchmark_suite [--scenario %s|all] [--mode closed|open] [--rate N]\n"
+             "       [--connections N] [--warmup S] [--duration S] [--workers N] [--port N] [--body-size N]\n"
+             "       [--routes N] [--depth N] [--subscribers N] [--events N] [--message-size N] [--json] [--output FILE]\n", scenarios.data( ) );
+}
+
+static Options parse( const int argc, const char** argv )
+{
+    Options options;
+    
+    for ( int index = 1; index < argc; index++ )
+    {
+        const string name = argv[ index ];
+        
+        if ( name == "--json" )
+        {
+            options.json = true;
+            continue;
+        }
+        
+        if ( name == "--help" or index + 1 >= argc )
+        {
+            throw invalid_argument( ( name == "--help" ) ? "" : "Missing value for option '" + name + "'." );
+        }
+        
+        const string value = argv[ ++index ];
+        
+        if ( name == "--scenario" )
+        {
+            for ( size_t start = 0, end = 0; start <= value.size( ); start = end + 1 )
+            {
+                end = value.find( ',', start );
+                end = ( end == string::npos ) ? value.size( ) : end;
+                
+                if ( end > start )
+                {
+                    options.scenarios.push_back( value.substr( start, end - start ) );
+                }
+            }
+        }
+        else if ( name == "--mode" )
+        {
+            if ( value not_eq "closed" and value not_eq "open" )
+            {
+                throw invalid_argument( "Unknown mode '" + value + "'." );
+            }
+            
+            options.mode = ( value == "open" ) ? OPEN_LOOP : CLOSED_LOOP;
+        }
+        else if ( name == "--rate" )
+        {
+            options.rate = std::max( std::atof( value.data( ) ), 1.0 );
+        }
+        else if ( name == "--connections" )
+        {
+            options.connections = std::max( std::strtoul( value.data( ), nullptr, 10 ), 1ul );
+        }
+        else if ( name == "--warmup" )
+        {
+            options.warmup = milliseconds( static_cast< long long >( std::atof( value.data( ) ) * 1000 ) );
+        }
+        else if ( name == "--duration" )
+        {
+            options.duration = milliseconds( std::max( static_cast< long long >( std::atof( value.data( ) ) * 1000 ), 1ll ) );
+        }
+        else if ( name == "--workers" )
+        {
+            options.workers = std::strtoul( value.data( ), nullptr, 10 );
+        }
+        else if ( name == "--port" )
+        {
+            options.port = static_cast< std::uint16_t >( std::strtoul( value.data( ), nullptr, 10 ) );
+        }
+        else if ( name == "--body-size" )
+        {
+            options.body_size = std::strtoul( value.data( ), nullptr, 10 );
+        }
+        else if ( name == "--routes" )
+        {
+            options.routes = std::max( std::strtoul( value.data( ), nullptr, 10 ), 1ul );
+        }
+        else if ( name == "--depth" )
+        {
+            options.depth = std::max( std::strtoul( value.data( ), nullptr, 10 ), 1ul );
+        }
+        else if ( name == "--subscribers" )
+        {
+            options.subscribers = std::max( std::strtoul( value.data( ), nullptr, 10 ), 1ul );
+        }
+        else if ( name == "--events" )
+        {
+            options.events = std::max( std::strtoul( value.data( ), nullptr, 10 ), 1ul );
+        }
+        else if ( name == "--message-size" )
+        {
+            options.message_size = std::strtoul( value.data( ), nullptr, 10 );
+        }
+        else if ( name == "--output" )
+        {
+            options.output = value;
+        }
+        else
+        {
+            throw invalid_argument( "Unknown option '" + name + "'." );
+        }
+    }
+    
+    if ( options.scenarios.empty( ) or ( options.scenarios.size( ) == 1 and options.scenarios.front( ) == "all" ) )
+    {
+        options.scenarios = available_scenarios( );
+    }
+    
+    if ( options.workers == 0 )
+    {
+        options.workers = std::max( thread::hardware_concurrency( ), 1u );
+    }
+    
+    return options;
+}
+
+static Result execute( const string& name, const Options& options )
+{
+    auto settings = make_shared< Settings >( );
+    settings->set_port( options.port );
+    settings->set_worker_limit( static_cast< unsigned int >( options.workers ) );
+    settings->set_connection_timeout( milliseconds( options.warmup + options.duration + seconds( 30 ) ) );
+    
+    Service service;
+    const auto scenario = make_scenario( name, options, service, settings );
+    
+    auto ready = make_shared< promise< void > >( );
+    auto started = ready->get_future( );
+    
+    service.set_ready_handler( [ ready ]( Service& )
+    {
+        ready->set_value( );
+    } );
+    
+    thread server( [ &service, settings, ready ]( )
+    {
+        try
+        {
+            service.start( settings );
+        }
+        catch ( ... )
+        {
+            try
+            {
+                ready->set_exception( std::current_exception( ) );
+            }
+            catch ( const std::future_error& )
+            {
+                return;
+            }
+        }
+    } );
+    
+    try
+    {
+        started.get( );
+    }
+    catch ( ... )
+    {
+        server.join( );
+        throw;
+    }
+    
+    const auto result = run( scenario, options );
+    
+    service.stop( );
+    server.join( );
+    
+    return result;
+}
+
+int main( const int argc, const char** argv )
+{
+    Options options;
+    
+    try
+    {
+        options = parse( argc, argv );
+    }
+    catch ( const invalid_argument& error )
+    {
+        if ( error.what( )[ 0 ] not_eq '\0' )
+        {
+            fprintf( stderr, "%s\n", error.what( ) );
+        }
+        
+        usage( );
+        return EXIT_FAILURE;
+    }
+    
+    vector< Result > results;
+    
+    for ( const auto& name : options.scenarios )
+    {
+        try
+        {
+            results.push_back( execute( name, options ) );
+        }
+        catch ( const std::exception& error )
+        {
+            fprintf( stderr, "Scenario '%s' failed: %s\n", name.data( ), error.what( ) );
+            return EXIT_FAILURE;
+        }
+    }
+    
+    const auto body = report( results, options.json );
+    
+    if ( options.output.empty( ) )
+    {
+        fputs( body.data( ), stdout );
+        return EXIT_SUCCESS;
+    }
+    
+    auto file = fopen( options.output.data( ), "w" );
+    auto written = file not_eq nullptr and fputs( body.data( ), file ) >= 0;
+    
+    if ( file not_eq nullptr )
+    {
+        written = ( fclose( file ) == 0 ) and written;
+    }
+    
+    if ( not written )
+    {
+        fprintf( stderr, "Failed to write results to '%s'.\n", options.output.data( ) );
+        return EXIT_FAILURE;
+    }
+    
+    return EXIT_SUCCESS;
+}
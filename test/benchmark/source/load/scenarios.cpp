@@ -0,0 +1,575 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <mutex>
+#include <atomic>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <ciso646>
+#include <unistd.h>
+#include <algorithm>
+#include <stdexcept>
+
+//Project Includes
+#include "scenarios.hpp"
+
+//External Includes
+#ifdef BUILD_SSL
+    #include <openssl/pem.h>
+    #include <openssl/sha.h>
+    #include <openssl/evp.h>
+    #include <openssl/x509.h>
+    #include <openssl/rsa.h>
+#endif
+
+//System Namespaces
+using std::mutex;
+using std::size_t;
+using std::string;
+using std::vector;
+using std::uint8_t;
+using std::uint64_t;
+using std::multimap;
+using std::to_string;
+using std::shared_ptr;
+using std::lock_guard;
+using std::make_shared;
+using std::runtime_error;
+using std::invalid_argument;
+using std::chrono::nanoseconds;
+using std::chrono::milliseconds;
+using std::chrono::duration_cast;
+
+//Project Namespaces
+using namespace restbed;
+
+//External Namespaces
+using asio::io_service;
+
+static uint64_t elapsed( const Clock::time_point& start )
+{
+    return duration_cast< nanoseconds >( Clock::now( ) - start ).count( );
+}
+
+static const string GET_REQUEST = "GET /resource HTTP/1.1\r\nHost: localhost\r\n\r\n";
+
+static void get_method_handler( const shared_ptr< Session > session )
+{
+    session->yield( OK, "Hello, World!", { { "Content-Length", "13" } } );
+}
+
+class KeepAliveConnection : public Connection
+{
+    public:
+        KeepAliveConnection( const shared_ptr< Transport >& transport, const size_t depth ) : Connection( transport ),
+            m_requests( )
+        {
+            for ( size_t index = 0; index < depth; index++ )
+            {
+                m_requests.append( GET_REQUEST );
+            }
+        }
+        
+        void exchange( const Clock::time_point& start, vector< uint64_t >& samples )
+        {
+            send( m_requests );
+            
+            for ( size_t count = m_requests.size( ) / GET_REQUEST.size( ); count not_eq 0; count-- )
+            {
+                if ( receive_response( ) not_eq OK )
+                {
+                    throw runtime_error( "Unexpected response status." );
+                }
+                
+                samples.push_back( elapsed( start ) );
+            }
+        }
+    
+    private:
+        string m_requests;
+};
+
+static void post_method_handler( const shared_ptr< Session > session )
+{
+    const auto request = session->get_request( );
+    const size_t length = request->get_header( "Content-Length", 0 );
+    
+    session->fetch( length, [ ]( const shared_ptr< Session > session, const Bytes& )
+    {
+        session->yield( OK, "", { { "Content-Length", "0" } } );
+    } );
+}
+
+class UploadConnection : public Connection
+{
+    public:
+        UploadConnection( const shared_ptr< Transport >& transport, const size_t size ) : Connection( transport ),
+            m_request( "POST /upload HTTP/1.1\r\nHost: localhost\r\nContent-Type: application/octet-stream\r\nContent-Length: " + to_string( size ) + "\r\n\r\n" )
+        {
+            m_request.append( size, 'x' );
+        }
+        
+        void exchange( const Clock::time_point& start, vector< uint64_t >& samples )
+        {
+            send( m_request );
+            
+            if ( receive_response( ) not_eq OK )
+            {
+                throw runtime_error( "Unexpected response status." );
+            }
+            
+            samples.push_back( elapsed( start ) );
+        }
+    
+    private:
+        string m_request;
+};
+
+class RoutingConnection : public Connection
+{
+    public:
+        RoutingConnection( const shared_ptr< Transport >& transport, const size_t routes, const size_t seed ) : Connection( transport ),
+            m_routes( routes ),
+            m_generator( static_cast< std::minstd_rand::result_type >( seed + 1 ) )
+        {
+            return;
+        }
+        
+        void exchange( const Clock::time_point& start, vector< uint64_t >& samples )
+        {
+            const auto route = m_generator( ) % m_routes;
+            const auto path = ( route % 2 == 0 ) ? "/static/" + to_string( route ) : "/dynamic/" + to_string( route ) + "/" + to_string( m_generator( ) % 1000 );
+            
+            send( "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n" );
+            
+            if ( receive_response( ) not_eq OK )
+            {
+                throw runtime_error( "Unexpected response status." );
+            }
+            
+            samples.push_back( elapsed( start ) );
+        }
+    
+    private:
+        size_t m_routes;
+        
+        std::minstd_rand m_generator;
+};
+
+class EventStreamConnection : public Connection
+{
+    public:
+        explicit EventStreamConnection( const shared_ptr< Transport >& transport ) : Connection( transport )
+        {
+            send( "GET /events HTTP/1.1\r\nHost: localhost\r\nAccept: text/event-stream\r\n\r\n" );
+            
+            const auto headers = receive_until( "\r\n\r\n" );
+            
+            if ( headers.compare( 0, 12, "HTTP/1.1 200" ) not_eq 0 )
+            {
+                throw runtime_error( "Event stream subscription refused." );
+            }
+        }
+        
+        void exchange( const Clock::time_point&, vector< uint64_t >& samples )
+        {
+            const auto event = receive_until( "\n\n" );
+            const auto position = event.find( "data: " );
+            
+            if ( position == string::npos )
+            {
+                throw runtime_error( "Malformed event." );
+            }
+            
+            const auto published = std::strtoull( event.data( ) + position + 6, nullptr, 10 );
+            const auto now = duration_cast< nanoseconds >( Clock::now( ).time_since_epoch( ) ).count( );
+            
+            samples.push_back( now - published );
+        }
+};
+
+#ifdef BUILD_SSL
+class HandshakeConnection : public Connection
+{
+    public:
+        explicit HandshakeConnection( const std::uint16_t port ) : Connection( nullptr ),
+            m_port( port ),
+            m_io_service( ),
+            m_context( asio::ssl::context::sslv23 )
+        {
+            m_context.set_verify_mode( asio::ssl::verify_none );
+        }
+        
+        void exchange( const Clock::time_point& start, vector< uint64_t >& samples )
+        {
+            reset( make_shared< SecureTransport >( m_io_service, m_context, m_port ) );
+            
+            send( "GET /resource HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n" );
+            const auto status = receive_response( );
+            
+            reset( nullptr );
+            
+            if ( status not_eq OK )
+            {
+                throw runtime_error( "Unexpected response status." );
+            }
+            
+            samples.push_back( elapsed( start ) );
+        }
+    
+    private:
+        std::uint16_t m_port;
+        
+        io_service m_io_service;
+        
+        asio::ssl::context m_context;
+};
+
+class WebSocketConnection : public Connection
+{
+    public:
+        WebSocketConnection( const shared_ptr< Transport >& transport, const size_t size ) : Connection( transport ),
+            m_frame( )
+        {
+            send( "GET /echo HTTP/1.1\r\nHost: localhost\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                  "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n\r\n" );
+            
+            const auto headers = receive_until( "\r\n\r\n" );
+            
+            if ( headers.compare( 0, 12, "HTTP/1.1 101" ) not_eq 0 )
+            {
+                throw runtime_error( "WebSocket upgrade refused." );
+            }
+            
+            const uint8_t mask[ 4 ] = { 0x12, 0x34, 0x56, 0x78 };
+            
+            m_frame.push_back( static_cast< char >( 0x82 ) );
+            
+            if ( size <= 125 )
+            {
+                m_frame.push_back( static_cast< char >( 0x80 | size ) );
+            }
+            else if ( size <= 0xFFFF )
+            {
+                m_frame.push_back( static_cast< char >( 0x80 | 126 ) );
+                m_frame.push_back( static_cast< char >( size >> 8 ) );
+                m_frame.push_back( static_cast< char >( size & 0xFF ) );
+            }
+            else
+            {
+                m_frame.push_back( static_cast< char >( 0x80 | 127 ) );
+                
+                for ( int shift = 56; shift >= 0; shift -= 8 )
+                {
+                    m_frame.push_back( static_cast< char >( ( static_cast< uint64_t >( size ) >> shift ) & 0xFF ) );
+                }
+            }
+            
+            m_frame.append( reinterpret_cast< const char* >( mask ), 4 );
+            
+            for ( size_t index = 0; index < size; index++ )
+            {
+                m_frame.push_back( static_cast< char >( 'x' ^ mask[ index % 4 ] ) );
+            }
+        }
+        
+        void exchange( const Clock::time_point& start, vector< uint64_t >& samples )
+        {
+            send( m_frame );
+            
+            const auto header = receive( 2 );
+            uint64_t length = static_cast< uint8_t >( header[ 1 ] ) & 0x7F;
+            
+            if ( length == 126 or length == 127 )
+            {
+                const auto extended = receive( ( length == 126 ) ? 2 : 8 );
+                length = 0;
+                
+                for ( const auto byte : extended )
+                {
+                    length = ( length << 8 ) | static_cast< uint8_t >( byte );
+                }
+            }
+            
+            receive( length );
+            
+            if ( ( static_cast< uint8_t >( header[ 0 ] ) & 0x0F ) not_eq 0x02 )
+            {
+                throw runtime_error( "Unexpected WebSocket frame." );
+            }
+            
+            samples.push_back( elapsed( start ) );
+        }
+    
+    private:
+        string m_frame;
+};
+
+static string base64_encode( const unsigned char* data, const size_t length )
+{
+    string encoded( 4 * ( ( length + 2 ) / 3 ), '\0' );
+    const auto size = EVP_EncodeBlock( reinterpret_cast< unsigned char* >( &encoded[ 0 ] ), data, static_cast< int >( length ) );
+    encoded.resize( size );
+    
+    return encoded;
+}
+
+static void echo_method_handler( const shared_ptr< Session > session )
+{
+    const auto request = session->get_request( );
+    
+    auto key = request->get_header( "Sec-WebSocket-Key" );
+    key.append( "258EAFA5-E914-47DA-95CA-C5AB0DC85B11" );
+    
+    unsigned char hash[ SHA_DIGEST_LENGTH ];
+    SHA1( reinterpret_cast< const unsigned char* >( key.data( ) ), key.length( ), hash );
+    
+    const multimap< string, string > headers
+    {
+        { "Upgrade", "websocket" },
+        { "Connection", "Upgrade" },
+        { "Sec-WebSocket-Accept", base64_encode( hash, SHA_DIGEST_LENGTH ) }
+    };
+    
+    session->upgrade( SWITCHING_PROTOCOLS, headers, [ ]( const shared_ptr< WebSocket > socket )
+    {
+        socket->set_message_handler( [ ]( const shared_ptr< WebSocket > source, const shared_ptr< WebSocketMessage > message )
+        {
+            const auto opcode = message->get_opcode( );
+            
+            if ( opcode == WebSocketMessage::TEXT_FRAME or opcode == WebSocketMessage::BINARY_FRAME )
+            {
+                source->send( make_shared< WebSocketMessage >( opcode, message->get_data( ) ) );
+            }
+            else if ( opcode == WebSocketMessage::CONNECTION_CLOSE_FRAME )
+            {
+                source->close( );
+            }
+        } );
+    } );
+}
+
+static void create_certificate( const string& private_key, const string& certificate )
+{
+    EVP_PKEY* key = nullptr;
+    EVP_PKEY_CTX* context = EVP_PKEY_CTX_new_id( EVP_PKEY_RSA, nullptr );
+    
+    if ( context == nullptr or EVP_PKEY_keygen_init( context ) <= 0 or EVP_PKEY_CTX_set_rsa_keygen_bits( context, 2048 ) <= 0 or EVP_PKEY_keygen( context, &key ) <= 0 )
+    {
+        EVP_PKEY_CTX_free( context );
+        throw runtime_error( "Failed to generate benchmark private key." );
+    }
+    
+    EVP_PKEY_CTX_free( context );
+    
+    X509* x509 = X509_new( );
+    X509_set_version( x509, 2 );
+    ASN1_INTEGER_set( X509_get_serialNumber( x509 ), 1 );
+    X509_gmtime_adj( X509_getm_notBefore( x509 ), 0 );
+    X509_gmtime_adj( X509_getm_notAfter( x509 ), 86400 );
+    X509_set_pubkey( x509, key );
+    
+    auto name = X509_get_subject_name( x509 );
+    X509_NAME_add_entry_by_txt( name, "CN", MBSTRING_ASC, reinterpret_cast< const unsigned char* >( "localhost" ), -1, -1, 0 );
+    X509_set_issuer_name( x509, name );
+    X509_sign( x509, key, EVP_sha256( ) );
+    
+    auto file = fopen( private_key.data( ), "wb" );
+    auto written = file not_eq nullptr and PEM_write_PrivateKey( file, key, nullptr, nullptr, 0, nullptr, nullptr );
+    
+    if ( file not_eq nullptr )
+    {
+        fclose( file );
+    }
+    
+    file = fopen( certificate.data( ), "wb" );
+    written = written and file not_eq nullptr and PEM_write_X509( file, x509 );
+    
+    if ( file not_eq nullptr )
+    {
+        fclose( file );
+    }
+    
+    X509_free( x509 );
+    EVP_PKEY_free( key );
+    
+    if ( not written )
+    {
+        throw runtime_error( "Failed to write benchmark certificate." );
+    }
+}
+#endif
+
+vector< string > available_scenarios( void )
+{
+#ifdef BUILD_SSL
+    return { "get", "pipelined", "post", "routes", "tls", "sse", "websocket" };
+#else
+    return { "get", "pipelined", "post", "routes", "sse" };
+#endif
+}
+
+Scenario make_scenario( const string& name, const Options& options, Service& service, const shared_ptr< Settings >& settings )
+{
+    const auto port = options.port;
+    
+    Scenario scenario;
+    scenario.name = name;
+    scenario.connections = options.connections;
+    
+    if ( name == "get" or name == "pipelined" )
+    {
+        auto resource = make_shared< Resource >( );
+        resource->set_path( "/resource" );
+        resource->set_method_handler( "GET", get_method_handler );
+        service.publish( resource );
+        
+        const size_t depth = ( name == "get" ) ? 1 : options.depth;
+        
+        scenario.connect = [ port, depth ]( io_service & io_service )
+        {
+            return make_shared< KeepAliveConnection >( make_shared< PlainTransport >( io_service, port ), depth );
+        };
+    }
+    else if ( name == "post" )
+    {
+        auto resource = make_shared< Resource >( );
+        resource->set_path( "/upload" );
+        resource->set_method_handler( "POST", post_method_handler );
+        service.publish( resource );
+        
+        const auto size = options.body_size;
+        
+        scenario.connect = [ port, size ]( io_service & io_service )
+        {
+            return make_shared< UploadConnection >( make_shared< PlainTransport >( io_service, port ), size );
+        };
+    }
+    else if ( name == "routes" )
+    {
+        for ( size_t route = 0; route < options.routes; route++ )
+        {
+            auto resource = make_shared< Resource >( );
+            resource->set_path( ( route % 2 == 0 ) ? "/static/" + to_string( route ) : "/dynamic/" + to_string( route ) + "/{id: [0-9]+}" );
+            resource->set_method_handler( "GET", get_method_handler );
+            service.publish( resource );
+        }
+        
+        const auto routes = std::max< size_t >( options.routes, 1 );
+        auto seed = make_shared< std::atomic< size_t > >( 0 );
+        
+        scenario.connect = [ port, routes, seed ]( io_service & io_service )
+        {
+            return make_shared< RoutingConnection >( make_shared< PlainTransport >( io_service, port ), routes, ( *seed )++ );
+        };
+    }
+    else if ( name == "sse" )
+    {
+        auto lock = make_shared< mutex >( );
+        auto sessions = make_shared< vector< shared_ptr< Session > > >( );
+        
+        auto resource = make_shared< Resource >( );
+        resource->set_path( "/events" );
+        resource->set_method_handler( "GET", [ lock, sessions ]( const shared_ptr< Session > session )
+        {
+            const multimap< string, string > headers
+            {
+                { "Connection", "keep-alive" },
+                { "Cache-Control", "no-cache" },
+                { "Content-Type", "text/event-stream" }
+            };
+            
+            session->yield( OK, headers, [ lock, sessions ]( const shared_ptr< Session > session )
+            {
+                lock_guard< mutex > guard( *lock );
+                sessions->push_back( session );
+            } );
+        } );
+        service.publish( resource );
+        
+        const auto interval = milliseconds( std::max< size_t >( 1000 / std::max< size_t >( options.events, 1 ), 1 ) );
+        
+        service.schedule( [ lock, sessions ]( )
+        {
+            const auto now = duration_cast< nanoseconds >( Clock::now( ).time_since_epoch( ) ).count( );
+            const auto message = "data: " + to_string( now ) + "\n\n";
+            
+            lock_guard< mutex > guard( *lock );
+            
+            sessions->erase( std::remove_if( sessions->begin( ), sessions->end( ), [ ]( const shared_ptr< Session >& session )
+            {
+                return session->is_closed( );
+            } ), sessions->end( ) );
+            
+            for ( auto& session : *sessions )
+            {
+                session->yield( message );
+            }
+        }, interval );
+        
+        scenario.paced = false;
+        scenario.connections = options.subscribers;
+        scenario.connect = [ port ]( io_service & io_service )
+        {
+            return make_shared< EventStreamConnection >( make_shared< PlainTransport >( io_service, port ) );
+        };
+    }
+#ifdef BUILD_SSL
+    else if ( name == "tls" )
+    {
+        const char* directory = getenv( "TMPDIR" );
+        const string prefix = string( ( directory == nullptr ) ? "/tmp" : directory ) + "/restbed-benchmark-" + to_string( getpid( ) );
+        
+        create_certificate( prefix + ".key", prefix + ".crt" );
+        
+        auto ssl_settings = make_shared< SSLSettings >( );
+        ssl_settings->set_port( port );
+        ssl_settings->set_http_disabled( true );
+        ssl_settings->set_private_key( Uri( "file://" + prefix + ".key" ) );
+        ssl_settings->set_certificate( Uri( "file://" + prefix + ".crt" ) );
+        settings->set_ssl_settings( ssl_settings );
+        
+        service.schedule( [ prefix ]( )
+        {
+            remove( ( prefix + ".key" ).data( ) );
+            remove( ( prefix + ".crt" ).data( ) );
+        } );
+        
+        auto resource = make_shared< Resource >( );
+        resource->set_path( "/resource" );
+        resource->set_method_handler( "GET", [ ]( const shared_ptr< Session > session )
+        {
+            session->close( OK, "Hello, World!", { { "Content-Length", "13" }, { "Connection", "close" } } );
+        } );
+        service.publish( resource );
+        
+        scenario.connect = [ port ]( io_service & )
+        {
+            return make_shared< HandshakeConnection >( port );
+        };
+    }
+    else if ( name == "websocket" )
+    {
+        auto resource = make_shared< Resource >( );
+        resource->set_path( "/echo" );
+        resource->set_method_handler( "GET", echo_method_handler );
+        service.publish( resource );
+        
+        const auto size = options.message_size;
+        
+        scenario.connect = [ port, size ]( io_service & io_service )
+        {
+            return make_shared< WebSocketConnection >( make_shared< PlainTransport >( io_service, port ), size );
+        };
+    }
+#endif
+    else
+    {
+        throw invalid_argument( "Unknown benchmark scenario '" + name + "'." );
+    }
+    
+    return scenario;
+}
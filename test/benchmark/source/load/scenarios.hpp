@@ -0,0 +1,28 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <memory>
+#include <string>
+#include <vector>
+
+//Project Includes
+#include <restbed>
+#include "load_generator.hpp"
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+//Names of every scenario available in this build, in execution order.
+std::vector< std::string > available_scenarios( void );
+
+//Publish the server side of the named scenario and return its client side; throws std::invalid_argument on unknown names.
+Scenario make_scenario( const std::string& name, const Options& options, restbed::Service& service, const std::shared_ptr< restbed::Settings >& settings );
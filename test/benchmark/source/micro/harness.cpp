@@ -0,0 +1,129 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <cstdio>
+#include <ciso646>
+#include <algorithm>
+
+//Project Includes
+#include "harness.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::size_t;
+using std::string;
+using std::vector;
+using std::uint64_t;
+using std::function;
+using std::chrono::duration;
+using std::chrono::milliseconds;
+using std::chrono::nanoseconds;
+using std::chrono::steady_clock;
+using std::chrono::duration_cast;
+
+//Project Namespaces
+
+//External Namespaces
+
+static nanoseconds measure( const function< void ( const uint64_t ) >& body, const uint64_t iterations )
+{
+    const auto start = steady_clock::now( );
+    body( iterations );
+    return duration_cast< nanoseconds >( steady_clock::now( ) - start );
+}
+
+Harness::Harness( void ) : m_benchmarks( )
+{
+    return;
+}
+
+void Harness::add( const string& name, const size_t bytes, const function< void ( const uint64_t ) >& body )
+{
+    m_benchmarks.push_back( Benchmark { name, bytes, body } );
+}
+
+vector< Measurement > Harness::run( const string& filter, const milliseconds& minimum_time, const size_t repetitions ) const
+{
+    vector< Measurement > measurements;
+    
+    for ( const auto& benchmark : m_benchmarks )
+    {
+        if ( not filter.empty( ) and benchmark.name.find( filter ) == string::npos )
+        {
+            continue;
+        }
+        
+        uint64_t iterations = 1;
+        auto elapsed = measure( benchmark.body, iterations );
+        
+        while ( elapsed < minimum_time / 10 and iterations < ( uint64_t( 1 ) << 40 ) )
+        {
+            iterations *= 2;
+            elapsed = measure( benchmark.body, iterations );
+        }
+        
+        const auto scale = duration< double >( minimum_time ).count( ) / std::max( duration< double >( elapsed ).count( ), 1e-9 );
+        iterations = std::max< uint64_t >( static_cast< uint64_t >( iterations * scale ), 1 );
+        
+        vector< double > samples;
+        
+        for ( size_t repetition = 0; repetition < std::max< size_t >( repetitions, 1 ); repetition++ )
+        {
+            samples.push_back( static_cast< double >( measure( benchmark.body, iterations ).count( ) ) / iterations );
+        }
+        
+        std::sort( samples.begin( ), samples.end( ) );
+        
+        Measurement measurement;
+        measurement.name = benchmark.name;
+        measurement.iterations = iterations;
+        measurement.nanoseconds = samples[ samples.size( ) / 2 ];
+        measurement.bytes_per_second = ( benchmark.bytes == 0 ) ? 0 : benchmark.bytes * 1e9 / measurement.nanoseconds;
+        
+        measurements.push_back( measurement );
+    }
+    
+    return measurements;
+}
+
+string Harness::report( const vector< Measurement >& measurements, const bool json )
+{
+    char line[ 512 ];
+    string body = "";
+    
+    if ( json )
+    {
+        body = "[\n";
+        
+        for ( size_t index = 0; index < measurements.size( ); index++ )
+        {
+            const auto& measurement = measurements[ index ];
+            
+            snprintf( line, sizeof( line ), "  { \"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.2f, \"bytes_per_second\": %.0f }%s\n",
+                      measurement.name.data( ), static_cast< unsigned long long >( measurement.iterations ),
+                      measurement.nanoseconds, measurement.bytes_per_second, ( index + 1 < measurements.size( ) ) ? "," : "" );
+            
+            body.append( line );
+        }
+        
+        body.append( "]\n" );
+        return body;
+    }
+    
+    snprintf( line, sizeof( line ), "%-40s %14s %14s %12s\n", "benchmark", "iterations", "ns/op", "MB/s" );
+    body.append( line );
+    
+    for ( const auto& measurement : measurements )
+    {
+        snprintf( line, sizeof( line ), "%-40s %14llu %14.2f %12.1f\n",
+                  measurement.name.data( ), static_cast< unsigned long long >( measurement.iterations ),
+                  measurement.nanoseconds, measurement.bytes_per_second / ( 1024 * 1024 ) );
+        
+        body.append( line );
+    }
+    
+    return body;
+}
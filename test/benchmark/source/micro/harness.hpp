@@ -0,0 +1,74 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+#pragma once
+
+//System Includes
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+//Project Includes
+
+//External Includes
+
+//System Namespaces
+
+//Project Namespaces
+
+//External Namespaces
+
+struct Measurement
+{
+    std::string name = "";
+    std::uint64_t iterations = 0;
+    double nanoseconds = 0;
+    double bytes_per_second = 0;
+};
+
+class Harness
+{
+    public:
+        Harness( void );
+        
+        //Register a benchmark; the body performs the operation 'iterations' times, bytes is the input size per operation.
+        void add( const std::string& name, const std::size_t bytes, const std::function< void ( const std::uint64_t iterations ) >& body );
+        
+        std::vector< Measurement > run( const std::string& filter, const std::chrono::milliseconds& minimum_time, const std::size_t repetitions ) const;
+        
+        static std::string report( const std::vector< Measurement >& measurements, const bool json );
+    
+    private:
+        struct Benchmark
+        {
+            std::string name;
+            std::size_t bytes;
+            std::function< void ( const std::uint64_t ) > body;
+        };
+        
+        std::vector< Benchmark > m_benchmarks;
+};
+
+//Prevent the optimiser from discarding a computed value.
+template< typename Type >
+inline void keep( const Type& value )
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+    asm volatile( "" : : "g"( &value ) : "memory" );
+#else
+    static volatile const void* sink = nullptr;
+    sink = &value;
+#endif
+}
+
+void register_uri_benchmarks( Harness& harness );
+
+void register_string_benchmarks( Harness& harness );
+
+void register_common_benchmarks( Harness& harness );
+
+void register_web_socket_benchmarks( Harness& harness );
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ *
+ * Microbenchmarks for the URI, string, parameter lookup and WebSocket frame
+ * codecs exercised on every request.
+ *
+ * Usage:
+ *    ./micro_benchmark_suite [--filter TEXT] [--min-time S] [--repetitions N] [--json] [--output FILE]
+ */
+
+//System Includes
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <ciso646>
+#include <algorithm>
+
+//Project Includes
+#include "harness.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::string;
+using std::chrono::milliseconds;
+
+//Project Namespaces
+
+//External Namespaces
+
+int main( const int argc, const char** argv )
+{
+    bool json = false;
+    string filter = "";
+    string output = "";
+    size_t repetitions = 3;
+    milliseconds minimum_time( 200 );
+    
+    for ( int index = 1; index < argc; index++ )
+    {
+        const string name = argv[ index ];
+        
+        if ( name == "--json" )
+        {
+            json = true;
+        }
+        else if ( index + 1 < argc and name == "--filter" )
+        {
+            filter = argv[ ++index ];
+        }
+        else if ( index + 1 < argc and name == "--min-time" )
+        {
+            minimum_time = milliseconds( std::max( static_cast< long long >( std::atof( argv[ ++index ] ) * 1000 ), 1ll ) );
+        }
+        else if ( index + 1 < argc and name == "--repetitions" )
+        {
+            repetitions = std::max( std::strtoul( argv[ ++index ], nullptr, 10 ), 1ul );
+        }
+        else if ( index + 1 < argc and name == "--output" )
+        {
+            output = argv[ ++index ];
+        }
+        else
+        {
+            fprintf( stderr, "Usage: micro_benchmark_suite [--filter TEXT] [--min-time S] [--repetitions N] [--json] [--output FILE]\n" );
+            return EXIT_FAILURE;
+        }
+    }
+    
+    Harness harness;
+    register_uri_benchmarks( harness );
+    register_string_benchmarks( harness );
+    register_common_benchmarks( harness );
+    register_web_socket_benchmarks( harness );
+    
+    const auto body = Harness::report( harness.run( filter, minimum_time, repetitions ), json );
+    
+    if ( output.empty( ) )
+    {
+        fputs( body.data( ), stdout );
+        return EXIT_SUCCESS;
+    }
+    
+    auto file = fopen( output.data( ), "w" );
+    auto written = file not_eq nullptr and fputs( body.data( ), file ) >= 0;
+    
+    if ( file not_eq nullptr )
+    {
+        written = ( fclose( file ) == 0 ) and written;
+    }
+    
+    if ( not written )
+    {
+        fprintf( stderr, "Failed to write results to '%s'.\n", output.data( ) );
+        return EXIT_FAILURE;
+    }
+    
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <string>
+
+//Project Includes
+#include <corvusoft/restbed/string.hpp>
+#include "harness.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::size_t;
+using std::string;
+using std::uint64_t;
+using std::to_string;
+
+//Project Namespaces
+using restbed::String;
+
+//External Namespaces
+
+void register_string_benchmarks( Harness& harness )
+{
+    static const string header = "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/58.0.3029.110 Safari/537.36";
+    static string list = "";
+    static string path = "";
+    
+    for ( size_t index = 0; index < 64; index++ )
+    {
+        list += ( index == 0 ) ? "" : ",";
+        list += "token" + to_string( index );
+        path += "//segment" + to_string( index );
+    }
+    
+    harness.add( "string/split/64", list.size( ), [ ]( const uint64_t iterations )
+    {
+        for ( uint64_t iteration = 0; iteration < iterations; iteration++ )
+        {
+            const auto tokens = String::split( list, ',' );
+            keep( tokens );
+        }
+    } );
+    
+    harness.add( "string/replace/path", path.size( ), [ ]( const uint64_t iterations )
+    {
+        for ( uint64_t iteration = 0; iteration < iterations; iteration++ )
+        {
+            const auto value = String::replace( "//", "/", path );
+            keep( value );
+        }
+    } );
+    
+    harness.add( "string/replace/absent", header.size( ), [ ]( const uint64_t iterations )
+    {
+        for ( uint64_t iteration = 0; iteration < iterations; iteration++ )
+        {
+            const auto value = String::replace( "+", " ", header );
+            keep( value );
+        }
+    } );
+    
+    harness.add( "string/format/log", 0, [ ]( const uint64_t iterations )
+    {
+        for ( uint64_t iteration = 0; iteration < iterations; iteration++ )
+        {
+            const auto value = String::format( "Incoming '%s' request from '%s' for route '%s'.", "GET", "[::ffff:127.0.0.1]:53412", "/resource/1234" );
+            keep( value );
+        }
+    } );
+    
+    harness.add( "string/lowercase/header", header.size( ), [ ]( const uint64_t iterations )
+    {
+        for ( uint64_t iteration = 0; iteration < iterations; iteration++ )
+        {
+            const auto value = String::lowercase( header );
+            keep( value );
+        }
+    } );
+    
+    harness.add( "string/uppercase/header", header.size( ), [ ]( const uint64_t iterations )
+    {
+        for ( uint64_t iteration = 0; iteration < iterations; iteration++ )
+        {
+            const auto value = String::uppercase( header );
+            keep( value );
+        }
+    } );
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <string>
+#include <memory>
+
+//Project Includes
+#include <corvusoft/restbed/byte.hpp>
+#include <corvusoft/restbed/web_socket_message.hpp>
+#include "corvusoft/restbed/detail/web_socket_manager_impl.hpp"
+#include "harness.hpp"
+
+//External Includes
+
+//System Namespaces
+using std::size_t;
+using std::string;
+using std::uint64_t;
+using std::shared_ptr;
+using std::make_shared;
+
+//Project Namespaces
+using restbed::Bytes;
+using restbed::WebSocketMessage;
+using restbed::detail::WebSocketManagerImpl;
+
+//External Namespaces
+
+static void add_frame_benchmarks( Harness& harness, const char* name, const size_t length )
+{
+    auto manager = make_shared< WebSocketManagerImpl >( );
+    auto unmasked = make_shared< WebSocketMessage >( WebSocketMessage::BINARY_FRAME, Bytes( length, 'x' ) );
+    auto masked = make_shared< WebSocketMessage >( WebSocketMessage::BINARY_FRAME, Bytes( length, 'x' ), 0x12345678 );
+    auto frame = manager->compose( masked );
+    
+    harness.add( string( "web_socket/compose/" ) + name, length, [ manager, unmasked ]( const uint64_t iterations )
+    {
+        for ( uint64_t iteration = 0; iteration < iterations; iteration++ )
+        {
+            const auto value = manager->compose( unmasked );
+            keep( value );
+        }
+    } );
+    
+    harness.add( string( "web_socket/parse/" ) + name, length, [ manager, frame ]( const uint64_t iterations )
+    {
+        for ( uint64_t iteration = 0; iteration < iterations; iteration++ )
+        {
+            const auto message = manager->parse( frame );
+            keep( message );
+        }
+    } );
+}
+
+void register_web_socket_benchmarks( Harness& harness )
+{
+    add_frame_benchmarks( harness, "small", 125 );
+    add_frame_benchmarks( harness, "large", 60000 );
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <string>
+#include <vector>
+#include <utility>
+
+//Project Includes
+#include "corvusoft/restbed/async_logger.hpp"
+
+//External Includes
+#include <catch.hpp>
+
+//System Namespaces
+using std::pair;
+using std::string;
+using std::vector;
+using std::make_pair;
+using std::chrono::milliseconds;
+
+//Project Namespaces
+using restbed::Logger;
+using restbed::AsyncLogger;
+
+//External Namespaces
+
+TEST_CASE( "validate default instance values", "[async_logger]" )
+{
+    const AsyncLogger logger;
+    REQUIRE( logger.get_capacity( ) == 1024 );
+    REQUIRE( logger.get_mode( ) == AsyncLogger::IMMEDIATE );
+    REQUIRE( logger.get_flush_interval( ) == milliseconds( 10 ) );
+    REQUIRE( logger.is_enabled( Logger::INFO ) );
+    REQUIRE( logger.is_enabled( Logger::SECURITY ) );
+}
+
+TEST_CASE( "validate setters modify default values", "[async_logger]" )
+{
+    AsyncLogger logger;
+    logger.set_capacity( 64 );
+    logger.set_mode( AsyncLogger::DEFERRED );
+    logger.set_flush_interval( milliseconds( 250 ) );
+    logger.set_enabled( Logger::INFO, false );
+    
+    REQUIRE( logger.get_capacity( ) == 64 );
+    REQUIRE( logger.get_mode( ) == AsyncLogger::DEFERRED );
+    REQUIRE( logger.get_flush_interval( ) == milliseconds( 250 ) );
+    REQUIRE_FALSE( logger.is_enabled( Logger::INFO ) );
+    REQUIRE( logger.is_enabled( Logger::DEBUG ) );
+}
+
+TEST_CASE( "immediate mode formats entries", "[async_logger]" )
+{
+    vector< pair< Logger::Level, string > > entries;
+    
+    AsyncLogger logger;
+    logger.set_sink( [ &entries ]( const Logger::Level level, const string & message )
+    {
+        entries.push_back( make_pair( level, message ) );
+    } );
+    
+    logger.start( nullptr );
+    logger.log( Logger::WARNING, "Incoming '%s' request from '%s' on port %i.", "GET", "127.0.0.1", 1984 );
+    logger.log_if( false, Logger::WARNING, "Ignored %s", "entry" );
+    logger.stop( );
+    
+    REQUIRE( entries.size( ) == 1 );
+    REQUIRE( entries[ 0 ].first == Logger::WARNING );
+    REQUIRE( entries[ 0 ].second == "Incoming 'GET' request from '127.0.0.1' on port 1984." );
+}
+
+TEST_CASE( "deferred mode formats entries on drain", "[async_logger]" )
+{
+    vector< string > entries;
+    
+    AsyncLogger logger;
+    logger.set_mode( AsyncLogger::DEFERRED );
+    logger.set_sink( [ &entries ]( const Logger::Level, const string & message )
+    {
+        entries.push_back( message );
+    } );
+    
+    logger.start( nullptr );
+    
+    string origin = "[::1]:4321";
+    logger.log( Logger::INFO, "'%s' connected %lu times, %5.2f%% [%-4d|%x|%c] %*d", origin.data( ), 12ul, 99.5, 7, 255u, 'z', 3, 1 );
+    origin.assign( "overwritten" );
+    
+    logger.stop( );
+    
+    REQUIRE( entries.size( ) == 1 );
+    REQUIRE( entries[ 0 ] == "'[::1]:4321' connected 12 times, 99.50% [7   |ff|z]   1" );
+}
+
+TEST_CASE( "filtered levels are discarded", "[async_logger]" )
+{
+    vector< string > entries;
+    
+    AsyncLogger logger;
+    logger.set_enabled( Logger::DEBUG, false );
+    logger.set_sink( [ &entries ]( const Logger::Level, const string & message )
+    {
+        entries.push_back( message );
+    } );
+    
+    logger.log( Logger::DEBUG, "filtered" );
+    logger.log( Logger::ERROR, "accepted" );
+    logger.flush( );
+    
+    REQUIRE( entries.size( ) == 1 );
+    REQUIRE( entries[ 0 ] == "accepted" );
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <memory>
+#include <string>
+#include <ciso646>
+#include <stdexcept>
+
+//Project Includes
+#include "corvusoft/restbed/byte.hpp"
+#include "corvusoft/restbed/buffer_chain.hpp"
+
+//External Includes
+#include <catch.hpp>
+
+//System Namespaces
+using std::string;
+using std::out_of_range;
+using std::make_shared;
+
+//Project Namespaces
+using restbed::Byte;
+using restbed::Bytes;
+using restbed::BufferChain;
+
+//External Namespaces
+
+TEST_CASE( "default constructor", "[buffer_chain]" )
+{
+    const BufferChain chain;
+    
+    REQUIRE( chain.is_empty( ) );
+    REQUIRE( chain.get_size( ) == 0 );
+    REQUIRE( chain.flatten( ).empty( ) );
+    REQUIRE( chain.get_segments( ).empty( ) );
+}
+
+TEST_CASE( "append grows across slabs without copying earlier segments", "[buffer_chain]" )
+{
+    const string block( 5000, 'a' );
+    
+    BufferChain chain;
+    chain.append( block );
+    
+    const auto first = chain.get_segments( ).front( ).first;
+    
+    chain.append( block );
+    chain.append( block );
+    
+    REQUIRE( chain.get_size( ) == 15000 );
+    REQUIRE( chain.get_segments( ).size( ) > 1 );
+    REQUIRE( chain.get_segments( ).front( ).first == first );
+    REQUIRE( chain.to_string( ) == block + block + block );
+}
+
+TEST_CASE( "adopted buffers are shared not copied", "[buffer_chain]" )
+{
+    const auto body = make_shared< const Bytes >( Bytes { 'b', 'o', 'd', 'y' } );
+    
+    const BufferChain chain( body );
+    
+    REQUIRE( chain.get_segments( ).size( ) == 1 );
+    REQUIRE( chain.get_segments( ).front( ).first == body->data( ) );
+    REQUIRE( &chain.flatten( ) == body.get( ) );
+}
+
+TEST_CASE( "copies share segments and append independently", "[buffer_chain]" )
+{
+    BufferChain original;
+    original.append( string( "head" ) );
+    
+    BufferChain copy( original );
+    copy.append( string( "-copy" ) );
+    original.append( string( "-original" ) );
+    
+    REQUIRE( copy.get_segments( ).front( ).first == original.get_segments( ).front( ).first );
+    REQUIRE( copy.to_string( ) == "head-copy" );
+    REQUIRE( original.to_string( ) == "head-original" );
+}
+
+TEST_CASE( "slice and consume", "[buffer_chain]" )
+{
+    BufferChain chain( string( "hello" ) );
+    chain.append( string( " big " ) );
+    chain.append( Bytes { 'w', 'o', 'r', 'l', 'd' } );
+    
+    REQUIRE( chain.slice( 3, 6 ).to_string( ) == "lo big" );
+    REQUIRE( chain.slice( 0, 0 ).is_empty( ) );
+    REQUIRE_THROWS_AS( chain.slice( 10, 6 ), out_of_range );
+    
+    chain.consume( 7 );
+    REQUIRE( chain.to_string( ) == "ig world" );
+    
+    chain.consume( 100 );
+    REQUIRE( chain.is_empty( ) );
+}
+
+TEST_CASE( "flatten coalesces segments", "[buffer_chain]" )
+{
+    BufferChain chain( string( "one" ) );
+    chain.append( string( "two" ) );
+    
+    const Bytes expectation = { 'o', 'n', 'e', 't', 'w', 'o' };
+    REQUIRE( chain.flatten( ) == expectation );
+    REQUIRE( chain.get_segments( ).size( ) == 1 );
+    REQUIRE( chain == BufferChain( expectation ) );
+    REQUIRE( chain not_eq BufferChain( string( "onetwx" ) ) );
+}
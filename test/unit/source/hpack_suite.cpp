@@ -0,0 +1,188 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <string>
+#include <ciso646>
+#include <stdexcept>
+
+//Project Includes
+#include "corvusoft/restbed/byte.hpp"
+#include "corvusoft/restbed/detail/hpack_impl.hpp"
+
+//External Includes
+#include <catch.hpp>
+
+//System Namespaces
+using std::string;
+using std::runtime_error;
+
+//Project Namespaces
+using restbed::Byte;
+using restbed::Bytes;
+using restbed::detail::HpackImpl;
+
+//External Namespaces
+
+static Bytes from_hex( const string& value )
+{
+    Bytes data;
+    string digits;
+    
+    for ( const auto character : value )
+    {
+        if ( character not_eq ' ' )
+        {
+            digits.push_back( character );
+        }
+    }
+    
+    for ( size_t index = 0; index + 1 < digits.length( ); index += 2 )
+    {
+        data.push_back( static_cast< Byte >( std::stoul( digits.substr( index, 2 ), nullptr, 16 ) ) );
+    }
+    
+    return data;
+}
+
+static HpackImpl::HeaderList decode( HpackImpl& decoder, const string& block )
+{
+    const auto data = from_hex( block );
+    
+    HpackImpl::HeaderList headers;
+    decoder.decode( data.data( ), data.size( ), headers );
+    
+    return headers;
+}
+
+TEST_CASE( "decode request blocks without huffman coding", "[hpack]" )
+{
+    HpackImpl decoder;
+    
+    HpackImpl::HeaderList expectation = { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" } };
+    REQUIRE( decode( decoder, "8286 8441 0f77 7777 2e65 7861 6d70 6c65 2e63 6f6d" ) == expectation );
+    REQUIRE( decoder.get_size( ) == 57 );
+    
+    expectation.emplace_back( "cache-control", "no-cache" );
+    REQUIRE( decode( decoder, "8286 84be 5808 6e6f 2d63 6163 6865" ) == expectation );
+    REQUIRE( decoder.get_size( ) == 110 );
+    
+    expectation = { { ":method", "GET" }, { ":scheme", "https" }, { ":path", "/index.html" }, { ":authority", "www.example.com" }, { "custom-key", "custom-value" } };
+    REQUIRE( decode( decoder, "8287 85bf 400a 6375 7374 6f6d 2d6b 6579 0c63 7573 746f 6d2d 7661 6c75 65" ) == expectation );
+    REQUIRE( decoder.get_size( ) == 164 );
+}
+
+TEST_CASE( "decode request blocks with huffman coding", "[hpack]" )
+{
+    HpackImpl decoder;
+    
+    HpackImpl::HeaderList expectation = { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" } };
+    REQUIRE( decode( decoder, "8286 8441 8cf1 e3c2 e5f2 3a6b a0ab 90f4 ff" ) == expectation );
+    
+    expectation.emplace_back( "cache-control", "no-cache" );
+    REQUIRE( decode( decoder, "8286 84be 5886 a8eb 1064 9cbf" ) == expectation );
+    
+    expectation = { { ":method", "GET" }, { ":scheme", "https" }, { ":path", "/index.html" }, { ":authority", "www.example.com" }, { "custom-key", "custom-value" } };
+    REQUIRE( decode( decoder, "8287 85bf 4088 25a8 49e9 5ba9 7d7f 8925 a849 e95b b8e8 b4bf" ) == expectation );
+    REQUIRE( decoder.get_size( ) == 164 );
+}
+
+TEST_CASE( "decode response blocks with eviction", "[hpack]" )
+{
+    HpackImpl decoder( 256 );
+    
+    HpackImpl::HeaderList expectation = { { ":status", "302" }, { "cache-control", "private" }, { "date", "Mon, 21 Oct 2013 20:13:21 GMT" }, { "location", "https://www.example.com" } };
+    REQUIRE( decode( decoder, "4882 6402 5885 aec3 771a 4b61 96d0 7abe 9410 54d4 44a8 2005 9504 0b81 66e0 82a6 2d1b ff6e 919d 29ad 1718 63c7 8f0b 97c8 e9ae 82ae 43d3" ) == expectation );
+    REQUIRE( decoder.get_size( ) == 222 );
+    
+    expectation[ 0 ].second = "307";
+    REQUIRE( decode( decoder, "4883 640e ffc1 c0bf" ) == expectation );
+    REQUIRE( decoder.get_size( ) == 222 );
+    
+    expectation = { { ":status", "200" }, { "cache-control", "private" }, { "date", "Mon, 21 Oct 2013 20:13:22 GMT" }, { "location", "https://www.example.com" }, { "content-encoding", "gzip" }, { "set-cookie", "foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600; version=1" } };
+    REQUIRE( decode( decoder, "88c1 6196 d07a be94 1054 d444 a820 0595 040b 8166 e084 a62d 1bff c05a 839b d9ab 77ad 94e7 821d d7f2 e6c7 b335 dfdf cd5b 3960 d5af 2708 7f36 72c1 ab27 0fb5 291f 9587 3160 65c0 03ed 4ee5 b106 3d50 07" ) == expectation );
+    REQUIRE( decoder.get_size( ) == 215 );
+}
+
+TEST_CASE( "encode matches the reference request blocks", "[hpack]" )
+{
+    HpackImpl encoder;
+    
+    Bytes block;
+    encoder.encode( { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" } }, block );
+    REQUIRE( block == from_hex( "8286 8441 8cf1 e3c2 e5f2 3a6b a0ab 90f4 ff" ) );
+    
+    block.clear( );
+    encoder.encode( { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" }, { "cache-control", "no-cache" } }, block );
+    REQUIRE( block == from_hex( "8286 84be 5886 a8eb 1064 9cbf" ) );
+    
+    block.clear( );
+    encoder.encode( { { ":method", "GET" }, { ":scheme", "https" }, { ":path", "/index.html" }, { ":authority", "www.example.com" }, { "custom-key", "custom-value" } }, block );
+    REQUIRE( block == from_hex( "8287 85bf 4088 25a8 49e9 5ba9 7d7f 8925 a849 e95b b8e8 b4bf" ) );
+}
+
+TEST_CASE( "encoded blocks round trip and announce table size changes", "[hpack]" )
+{
+    HpackImpl encoder;
+    HpackImpl decoder;
+    
+    const HpackImpl::HeaderList headers = { { ":status", "200" }, { "content-type", "application/json" }, { "authorization", "secret" }, { "x-trace", string( 3000, 'a' ) } };
+    
+    for ( int pass = 0; pass < 3; pass++ )
+    {
+        Bytes block;
+        encoder.encode( headers, block );
+        
+        HpackImpl::HeaderList result;
+        decoder.decode( block.data( ), block.size( ), result );
+        REQUIRE( result == headers );
+        REQUIRE( decoder.get_size( ) == encoder.get_size( ) );
+    }
+    
+    encoder.set_capacity( 0 );
+    
+    Bytes block;
+    encoder.encode( headers, block );
+    REQUIRE( block.front( ) == 0x20 );
+    
+    HpackImpl::HeaderList result;
+    decoder.decode( block.data( ), block.size( ), result );
+    REQUIRE( result == headers );
+    REQUIRE( decoder.get_size( ) == 0 );
+}
+
+TEST_CASE( "decode rejects malformed blocks", "[hpack]" )
+{
+    HpackImpl decoder;
+    HpackImpl::HeaderList headers;
+    
+    const auto out_of_range = from_hex( "be" );
+    REQUIRE_THROWS_AS( decoder.decode( out_of_range.data( ), out_of_range.size( ), headers ), runtime_error );
+    
+    const auto truncated = from_hex( "4108 6162" );
+    REQUIRE_THROWS_AS( decoder.decode( truncated.data( ), truncated.size( ), headers ), runtime_error );
+    
+    const auto oversized = from_hex( "3fe2 1f" );
+    REQUIRE_THROWS_AS( decoder.decode( oversized.data( ), oversized.size( ), headers ), runtime_error );
+    
+    const auto late_update = from_hex( "823f e11f" );
+    REQUIRE_THROWS_AS( decoder.decode( late_update.data( ), late_update.size( ), headers ), runtime_error );
+}
+
+TEST_CASE( "huffman coding round trips every octet", "[hpack]" )
+{
+    string value;
+    
+    for ( int octet = 0; octet < 256; octet++ )
+    {
+        value.push_back( static_cast< char >( octet ) );
+    }
+    
+    Bytes data;
+    HpackImpl::huffman_encode( value, data );
+    REQUIRE( HpackImpl::huffman_decode( data.data( ), data.size( ) ) == value );
+    
+    const auto padding = from_hex( "ff ff ff ff" );
+    REQUIRE_THROWS_AS( HpackImpl::huffman_decode( padding.data( ), padding.size( ) ), runtime_error );
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <ciso646>
+#include <stdexcept>
+
+//Project Includes
+#include "corvusoft/restbed/byte.hpp"
+#include "corvusoft/restbed/body_file.hpp"
+#include "corvusoft/restbed/multipart_parser.hpp"
+
+//External Includes
+#include <catch.hpp>
+
+//System Namespaces
+using std::string;
+using std::vector;
+using std::multimap;
+using std::shared_ptr;
+using std::invalid_argument;
+
+//Project Namespaces
+using restbed::Byte;
+using restbed::Bytes;
+using restbed::BodyFile;
+using restbed::MultipartParser;
+
+//External Namespaces
+
+static const string body = "preamble\r\n"
+                           "--XyZ\r\n"
+                           "Content-Disposition: form-data; name=\"title\"\r\n"
+                           "\r\n"
+                           "hello\r\n--world\r\n"
+                           "--XyZ  \r\n"
+                           "Content-Disposition: form-data; name=\"upload\"; filename=\"a.txt\"\r\n"
+                           "Content-Type: text/plain\r\n"
+                           "\r\n"
+                           "file\r\ncontents\r\n"
+                           "--XyZ--\r\n"
+                           "epilogue";
+
+struct Part
+{
+    multimap< string, string > headers;
+    
+    string data;
+    
+    shared_ptr< const BodyFile > file;
+};
+
+static vector< Part > parse( MultipartParser& parser, const size_t chunk )
+{
+    vector< Part > parts;
+    
+    parser.set_part_start_handler( [ &parts ]( const multimap< string, string >& headers )
+    {
+        parts.push_back( Part { headers, "", nullptr } );
+    } );
+    
+    parser.set_part_data_handler( [ &parts ]( const Bytes & data )
+    {
+        parts.back( ).data.append( data.begin( ), data.end( ) );
+    } );
+    
+    parser.set_part_end_handler( [ &parts ]( const shared_ptr< const BodyFile > file )
+    {
+        parts.back( ).file = file;
+    } );
+    
+    const Byte* data = reinterpret_cast< const Byte* >( body.data( ) );
+    
+    for ( size_t position = 0; position < body.length( ); position += chunk )
+    {
+        parser.parse( data + position, ( body.length( ) - position < chunk ) ? body.length( ) - position : chunk );
+    }
+    
+    parser.finish( );
+    
+    return parts;
+}
+
+TEST_CASE( "parse parts regardless of how the body is chunked", "[multipart_parser]" )
+{
+    for ( const size_t chunk : { size_t( 1 ), size_t( 2 ), size_t( 7 ), size_t( 64 ), body.length( ) } )
+    {
+        MultipartParser parser( "XyZ" );
+        const auto parts = parse( parser, chunk );
+        
+        REQUIRE( parser.is_complete( ) );
+        REQUIRE( parts.size( ) == 2 );
+        REQUIRE( parts[ 0 ].data == "hello\r\n--world" );
+        REQUIRE( parts[ 0 ].headers.find( "Content-Disposition" )->second == "form-data; name=\"title\"" );
+        REQUIRE( parts[ 1 ].data == "file\r\ncontents" );
+        REQUIRE( parts[ 1 ].headers.find( "Content-Type" )->second == "text/plain" );
+        REQUIRE( parts[ 1 ].file == nullptr );
+    }
+}
+
+TEST_CASE( "spill file parts to disk", "[multipart_parser]" )
+{
+    MultipartParser parser( "XyZ" );
+    parser.set_spill_directory( "/tmp" );
+    
+    const auto parts = parse( parser, 5 );
+    
+    REQUIRE( parts.size( ) == 2 );
+    REQUIRE( parts[ 0 ].file == nullptr );
+    REQUIRE( parts[ 0 ].data == "hello\r\n--world" );
+    REQUIRE( parts[ 1 ].data.empty( ) );
+    REQUIRE( parts[ 1 ].file not_eq nullptr );
+    REQUIRE( parts[ 1 ].file->get_size( ) == 14 );
+    
+    const auto contents = parts[ 1 ].file->read( 0, 14 );
+    REQUIRE( string( contents.begin( ), contents.end( ) ) == "file\r\ncontents" );
+}
+
+TEST_CASE( "reject truncated and malformed bodies", "[multipart_parser]" )
+{
+    MultipartParser truncated( "XyZ" );
+    truncated.parse( Bytes( body.begin( ), body.begin( ) + 60 ) );
+    REQUIRE_FALSE( truncated.is_complete( ) );
+    REQUIRE_THROWS_AS( truncated.finish( ), invalid_argument );
+    
+    const string malformed = "--XyZ\r\nno separator\r\n\r\n";
+    MultipartParser parser( "XyZ" );
+    REQUIRE_THROWS_AS( parser.parse( Bytes( malformed.begin( ), malformed.end( ) ) ), invalid_argument );
+    
+    REQUIRE_THROWS_AS( MultipartParser( "" ), invalid_argument );
+}
@@ -4,7 +4,9 @@
 
 //System Includes
 #include <map>
+#include <limits>
 #include <string>
+#include <cstdint>
 
 //Project Includes
 #include <corvusoft/restbed/request.hpp>
@@ -15,7 +17,9 @@
 //System Namespaces
 using std::map;
 using std::string;
+using std::int64_t;
 using std::multimap;
+using std::uint64_t;
 
 //Project Namespaces
 using restbed::Request;
@@ -141,6 +145,41 @@ TEST_CASE( "validate getter default value", "[request]" )
     }
 }
 
+TEST_CASE( "validate typed getters parse values", "[request]" )
+{
+    Request request;
+    request.add_header( "Limit", " 250" );
+    request.add_header( "Offset", "-9223372036854775808" );
+    request.add_header( "Identifier", "18446744073709551615" );
+    request.add_header( "Overflow", "18446744073709551616" );
+    request.add_header( "Ratio", "0.125" );
+    request.add_header( "Precise", "3.14159265358979323846264338327950288" );
+    request.add_header( "Scientific", "-1.5e-3" );
+    request.add_header( "Huge", "1e400" );
+    request.add_header( "Enabled", "TRUE" );
+    request.add_header( "Disabled", "0" );
+    request.add_header( "Trailing", "42abc" );
+    request.add_header( "Invalid", "abc" );
+    
+    REQUIRE( request.get_header( "Limit", 0 ) == 250 );
+    REQUIRE( request.get_header( "Offset", int64_t( 0 ) ) == std::numeric_limits< int64_t >::min( ) );
+    REQUIRE( request.get_header( "Identifier", uint64_t( 0 ) ) == std::numeric_limits< uint64_t >::max( ) );
+    REQUIRE( request.get_header( "Overflow", uint64_t( 7 ) ) == 7 );
+    REQUIRE( request.get_header( "Identifier", 5 ) == 5 );
+    REQUIRE( request.get_header( "Offset", uint64_t( 3 ) ) == 3 );
+    REQUIRE( request.get_header( "Ratio", 0.0 ) == 0.125 );
+    REQUIRE( request.get_header( "Ratio", 0.0f ) == 0.125f );
+    REQUIRE( request.get_header( "Precise", 0.0 ) == 3.14159265358979323846264338327950288 );
+    REQUIRE( request.get_header( "Scientific", 0.0 ) == -1.5e-3 );
+    REQUIRE( request.get_header( "Huge", 1.0 ) == 1.0 );
+    REQUIRE( request.get_header( "Enabled", false ) == true );
+    REQUIRE( request.get_header( "Disabled", true ) == false );
+    REQUIRE( request.get_header( "Trailing", 0 ) == 42 );
+    REQUIRE( request.get_header( "Invalid", 9 ) == 9 );
+    REQUIRE( request.get_header( "Invalid", 9.5 ) == 9.5 );
+    REQUIRE( request.get_header( "Invalid", true ) == true );
+}
+
 TEST_CASE( "validate set_header overrides previous value", "[request]" )
 {
     Request request;
@@ -179,3 +218,20 @@ TEST_CASE( "validate add_header does not override a previous value", "[request]"
     };
     REQUIRE( headers == expectation );
 }
+
+TEST_CASE( "validate header lookups ignore case", "[request]" )
+{
+    Request request;
+    request.add_header( "Content-Type", "application/json" );
+    request.add_header( "X-Trace", "1" );
+    request.add_header( "x-trace", "2" );
+    
+    REQUIRE( request.has_header( "content-type" ) );
+    REQUIRE( request.get_header_view( "CONTENT-TYPE" ) == "application/json" );
+    REQUIRE( request.get_header_view( "Accept" ).empty( ) );
+    REQUIRE( request.get_header( "X-TRACE", "" ) == "1" );
+    REQUIRE( request.get_headers( "x-Trace" ).size( ) == 2 );
+    
+    request.set_header( "X-TRACE", "3" );
+    REQUIRE( request.get_headers( "x-trace" ) == multimap< string, string >( { { "X-TRACE", "3" } } ) );
+}
@@ -3,7 +3,9 @@
  */
 
 //System Includes
+#include <regex>
 #include <memory>
+#include <stdexcept>
 
 //Project Includes
 #include <corvusoft/restbed/resource.hpp>
@@ -12,6 +14,8 @@
 #include <catch.hpp>
 
 //System Namespaces
+using std::regex_error;
+using std::invalid_argument;
 
 //Project Namespaces
 using restbed::Resource;
@@ -29,3 +33,16 @@ TEST_CASE( "confirm default destructor throws no exceptions", "[resource]" )
     
     REQUIRE_NOTHROW( delete resource );
 }
+
+TEST_CASE( "confirm set_method_handler compiles filters", "[resource]" )
+{
+    Resource resource;
+    const auto callback = [ ]( const std::shared_ptr< restbed::Session > )
+    {
+        return;
+    };
+    
+    REQUIRE_NOTHROW( resource.set_method_handler( "GET", { { "Accept", "application/json" }, { "Content-Type", "text/.*" } }, callback ) );
+    REQUIRE_THROWS_AS( resource.set_method_handler( "GET", { { "Accept", "application/(json" } }, callback ), regex_error );
+    REQUIRE_THROWS_AS( resource.set_method_handler( "", callback ), invalid_argument );
+}
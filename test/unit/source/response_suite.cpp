@@ -5,6 +5,7 @@
 //System Includes
 #include <map>
 #include <string>
+#include <utility>
 
 //Project Includes
 #include <corvusoft/restbed/response.hpp>
@@ -17,7 +18,9 @@ using std::string;
 using std::multimap;
 
 //Project Namespaces
+using restbed::Bytes;
 using restbed::Response;
+using restbed::BufferChain;
 
 //External Namespaces
 
@@ -62,6 +65,34 @@ TEST_CASE( "validate setters modify default values", "[response]" )
     REQUIRE( response.get_status_message( ) == "corvusoft ltd" );
 }
 
+TEST_CASE( "validate set_body moves an rvalue body", "[response]" )
+{
+    Bytes body = { 'a', 'b' };
+    const auto data = body.data( );
+    
+    Response response;
+    response.set_body( std::move( body ) );
+    
+    REQUIRE( response.get_body( ).data( ) == data );
+    REQUIRE( &response.get_body( ) == &response.get_body( ) );
+    REQUIRE( response.get_body( ) == Bytes( { 'a', 'b' } ) );
+}
+
+TEST_CASE( "validate buffer chain body shares segments", "[response]" )
+{
+    BufferChain body( string( "chained" ) );
+    body.append( string( " body" ) );
+    
+    Response response;
+    response.set_body( body );
+    
+    BufferChain value;
+    response.get_body( value );
+    
+    REQUIRE( value.get_segments( ) == body.get_segments( ) );
+    REQUIRE( response.get_body( ) == Bytes( { 'c', 'h', 'a', 'i', 'n', 'e', 'd', ' ', 'b', 'o', 'd', 'y' } ) );
+}
+
 TEST_CASE( "validate getter default value", "[response]" )
 {
     const Response response;
@@ -154,3 +185,20 @@ TEST_CASE( "validate add_header does not override a previous value", "[request]"
     };
     REQUIRE( headers == expectation );
 }
+
+TEST_CASE( "validate header lookups ignore case", "[request]" )
+{
+    Response response;
+    response.add_header( "Content-Type", "application/json" );
+    response.add_header( "X-Trace", "1" );
+    response.add_header( "x-trace", "2" );
+    
+    REQUIRE( response.has_header( "content-type" ) );
+    REQUIRE( response.get_header_view( "CONTENT-TYPE" ) == "application/json" );
+    REQUIRE( response.get_header_view( "Accept" ).empty( ) );
+    REQUIRE( response.get_header( "X-TRACE", "" ) == "1" );
+    REQUIRE( response.get_headers( "x-Trace" ).size( ) == 2 );
+    
+    response.set_header( "X-TRACE", "3" );
+    REQUIRE( response.get_headers( "x-trace" ) == multimap< string, string >( { { "X-TRACE", "3" } } ) );
+}
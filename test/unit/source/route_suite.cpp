@@ -0,0 +1,54 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <memory>
+#include <string>
+#include <stdexcept>
+
+//Project Includes
+#include <corvusoft/restbed/route.hpp>
+
+//External Includes
+#include <catch.hpp>
+
+//System Namespaces
+using std::string;
+using std::shared_ptr;
+using std::invalid_argument;
+
+//Project Namespaces
+using restbed::Route;
+using restbed::Session;
+
+//External Namespaces
+
+TEST_CASE( "confirm path constructor throws no exceptions", "[route]" )
+{
+    REQUIRE_NOTHROW( Route< >( "/" ) );
+    REQUIRE_NOTHROW( ( Route< string, int >( "/queues/{name}/messages/{id}" ) ) );
+    REQUIRE_NOTHROW( ( Route< string, int >( "/queues/{name:string}/messages/{ id: int }" ) ) );
+    REQUIRE_NOTHROW( ( Route< bool, unsigned int, double >( "/{flag:bool}/{count:uint}/{ratio:float}" ) ) );
+}
+
+TEST_CASE( "confirm path constructor rejects mismatched declarations", "[route]" )
+{
+    REQUIRE_THROWS_AS( Route< int >( "/messages" ), invalid_argument );
+    REQUIRE_THROWS_AS( Route< >( "/messages/{id}" ), invalid_argument );
+    REQUIRE_THROWS_AS( Route< int >( "/messages/{id" ), invalid_argument );
+    REQUIRE_THROWS_AS( Route< int >( "/messages/{:int}" ), invalid_argument );
+    REQUIRE_THROWS_AS( Route< int >( "/messages/{id:string}" ), invalid_argument );
+    REQUIRE_THROWS_AS( Route< unsigned int >( "/messages/{id:int}" ), invalid_argument );
+}
+
+TEST_CASE( "confirm get_resource returns a publishable resource", "[route]" )
+{
+    Route< int > route( "/messages/{id:int}" );
+    
+    REQUIRE( route.get_resource( ) not_eq nullptr );
+    REQUIRE_NOTHROW( route.set_method_handler( "GET", [ ]( const shared_ptr< Session >, const int& )
+    {
+        return;
+    } ) );
+}
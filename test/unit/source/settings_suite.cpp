@@ -33,10 +33,17 @@ TEST_CASE( "validate default instance values", "[settings]" )
     REQUIRE( settings.get_worker_limit( ) == 0 );
     REQUIRE( settings.get_properties( ).empty( ) );
     REQUIRE( settings.get_bind_address( ).empty( ) );
+    REQUIRE( settings.get_body_spill_threshold( ) == 0 );
+    REQUIRE( settings.get_body_spill_directory( ) == "/tmp" );
+    REQUIRE( settings.get_pipeline_limit( ) == 0 );
+    REQUIRE( settings.get_keep_alive_limit( ) == 0 );
+    REQUIRE( settings.get_http2_enabled( ) == false );
+    REQUIRE( settings.get_http2_stream_limit( ) == 100 );
     REQUIRE( settings.get_connection_limit( ) == 128 );
     REQUIRE( settings.get_default_headers( ).empty( ) );
     REQUIRE( settings.get_case_insensitive_uris( ) == true );
     REQUIRE( settings.get_connection_timeout( ) == milliseconds( 5000 ) );
+    REQUIRE( settings.get_keep_alive_timeout( ) == milliseconds( 0 ) );
     
     map< int, string > expectation =
     {
@@ -118,8 +125,15 @@ TEST_CASE( "validate setters modify default values", "[settings]" )
     settings.set_root( "/resources" );
     settings.set_connection_limit( 1 );
     settings.set_bind_address( "::1" );
+    settings.set_body_spill_threshold( 1024 );
+    settings.set_body_spill_directory( "/var/tmp" );
+    settings.set_pipeline_limit( 8 );
+    settings.set_keep_alive_limit( 100 );
+    settings.set_http2_enabled( true );
+    settings.set_http2_stream_limit( 16 );
     settings.set_case_insensitive_uris( false );
     settings.set_connection_timeout( milliseconds( 30 ) );
+    settings.set_keep_alive_timeout( milliseconds( 15 ) );
     settings.set_properties( { { "name", "value" } } );
     settings.set_default_headers( { { "Connection", "close" } } );
     
@@ -127,9 +141,16 @@ TEST_CASE( "validate setters modify default values", "[settings]" )
     REQUIRE( settings.get_root( ) == "/resources" );
     REQUIRE( settings.get_worker_limit( ) == 4 );
     REQUIRE( settings.get_bind_address( ) == "::1" );
+    REQUIRE( settings.get_body_spill_threshold( ) == 1024 );
+    REQUIRE( settings.get_body_spill_directory( ) == "/var/tmp" );
+    REQUIRE( settings.get_pipeline_limit( ) == 8 );
+    REQUIRE( settings.get_keep_alive_limit( ) == 100 );
+    REQUIRE( settings.get_http2_enabled( ) == true );
+    REQUIRE( settings.get_http2_stream_limit( ) == 16 );
     REQUIRE( settings.get_connection_limit( ) == 1 );
     REQUIRE( settings.get_case_insensitive_uris( ) == false );
     REQUIRE( settings.get_connection_timeout( ) == milliseconds( 30 ) );
+    REQUIRE( settings.get_keep_alive_timeout( ) == milliseconds( 15 ) );
     
     map< string, string > properties_expectation = { { "name", "value" } };
     REQUIRE( settings.get_properties( ) == properties_expectation );
@@ -63,6 +63,26 @@ TEST_CASE( "empty to uppercase", "[string]" )
     REQUIRE( String::uppercase( "" ) == "" );
 }
 
+TEST_CASE( "lowercase in place", "[string]" )
+{
+    string value = "CoRvUSoFt-1984 \xC3\x89";
+    String::lowercase_in_place( value );
+    REQUIRE( value == "corvusoft-1984 \xC3\x89" );
+}
+
+TEST_CASE( "uppercase in place", "[string]" )
+{
+    string value = "CoRvUSoFt-1984";
+    String::uppercase_in_place( value );
+    REQUIRE( value == "CORVUSOFT-1984" );
+}
+
+TEST_CASE( "format exceeding stack buffer", "[string]" )
+{
+    const string value( 4096, 'x' );
+    REQUIRE( String::format( "%s-%d", value.data( ), 42 ) == value + "-42" );
+}
+
 TEST_CASE( "format", "[string]" )
 {
     REQUIRE( String::format( "Corvusoft %s", "Solutions" ) == "Corvusoft Solutions" );
@@ -94,6 +114,16 @@ TEST_CASE( "split with empty delimiter", "[string]" )
     REQUIRE( String::split( "Corvusoft Solutions", expectation ) == vector< string >( { "Corvusoft Solutions" } ) );
 }
 
+TEST_CASE( "split into tokens", "[string]" )
+{
+    vector< String::Token > tokens { { 9, 9 } };
+    String::split( "/queues//events/", '/', tokens );
+    REQUIRE( tokens == vector< String::Token >( { { 1, 6 }, { 9, 6 } } ) );
+    
+    String::split( "", '/', tokens );
+    REQUIRE( tokens.empty( ) );
+}
+
 TEST_CASE( "join map to string", "[string]" )
 {
     multimap< string, string > values = { { "fields", "id,rev" }, { "sort", "rev" } };
@@ -203,3 +233,32 @@ TEST_CASE( "replace with empty arguments", "[string]" )
 {
     REQUIRE( String::replace( "", "", "" ) == "" );
 }
+
+TEST_CASE( "replace repeats until no match", "[string]" )
+{
+    REQUIRE( String::replace( "//", "/", "/resources////events//" ) == "/resources/events/" );
+}
+
+TEST_CASE( "replace case insensitive", "[string]" )
+{
+    REQUIRE( String::remove( "file://", "FILE:///tmp/key.pem", String::CASE_INSENSITIVE ) == "/tmp/key.pem" );
+    REQUIRE( String::replace( "DOT", "ping", "dot Dash doT", String::CASE_INSENSITIVE ) == "ping Dash ping" );
+}
+
+TEST_CASE( "replace with substitute containing target", "[string]" )
+{
+    REQUIRE( String::replace( "a", "aa", "banana" ) == "baanaanaa" );
+}
+
+TEST_CASE( "replace with regular expression characters", "[string]" )
+{
+    REQUIRE( String::replace( ".*", "+", "a.*b.*c" ) == "a+b+c" );
+}
+
+TEST_CASE( "equals", "[string]" )
+{
+    REQUIRE( String::equals( "Content-Type", "Content-Type" ) );
+    REQUIRE_FALSE( String::equals( "Content-Type", "content-type" ) );
+    REQUIRE( String::equals( "Content-Type", "content-TYPE", String::CASE_INSENSITIVE ) );
+    REQUIRE_FALSE( String::equals( "Content-Type", "Content-Length", String::CASE_INSENSITIVE ) );
+}
@@ -54,9 +54,35 @@ TEST_CASE( "ipv6 constructor", "[uri]" )
     REQUIRE( value == "http://username:password@[2001:0db8:85a3:0000:0000:8a2e:0370:7334]:80/resources/index.html?q=bear&b=cubs#frag1" );
 }
 
+TEST_CASE( "ipv6 components", "[uri]" )
+{
+    Uri uri( "https://username@[2001:db8::7334]:8443/resources?q=bear#frag1" );
+    REQUIRE( uri.get_port( ) == 8443 );
+    REQUIRE( uri.get_path( ) == "/resources" );
+    REQUIRE( uri.get_query( ) == "q=bear" );
+    REQUIRE( uri.get_scheme( ) == "https" );
+    REQUIRE( uri.get_fragment( ) == "frag1" );
+    REQUIRE( uri.get_username( ) == "username" );
+    REQUIRE( uri.get_password( ) == "" );
+    REQUIRE( uri.get_authority( ) == "[2001:db8::7334]" );
+}
+
+TEST_CASE( "assignment operator components", "[uri]" )
+{
+    Uri uri( "http://localhost:1984/resources/index.html" );
+    uri = Uri( "ws://restq.corvusoft.co.uk:443/queues?name=events" );
+    
+    REQUIRE( uri.get_port( ) == 443 );
+    REQUIRE( uri.get_path( ) == "/queues" );
+    REQUIRE( uri.get_query( ) == "name=events" );
+    REQUIRE( uri.get_authority( ) == "restq.corvusoft.co.uk" );
+}
+
 TEST_CASE( "invalid constructor", "[uri]" )
 {
     REQUIRE_THROWS_AS( Uri( "---_)(*&" ), invalid_argument );
+    REQUIRE_THROWS_AS( Uri( "http://localhost/a?b?c" ), invalid_argument );
+    REQUIRE_THROWS_AS( Uri( "http://[::1]" ), invalid_argument );
 }
 
 TEST_CASE( "empty constructor", "[uri]" )
@@ -157,16 +183,23 @@ TEST_CASE( "empty parse", "[uri]" )
 TEST_CASE( "decode", "[uri]" )
 {
     REQUIRE( Uri::decode( "file:///tmp/a%2Eb/tmp_20482932.txt" ) == "file:///tmp/a.b/tmp_20482932.txt" );
+    REQUIRE( Uri::decode( "%e2%82%ac+%41" ) == "\xE2\x82\xAC+A" );
+    REQUIRE( Uri::decode( "100%" ) == "100%" );
+    REQUIRE( Uri::decode( "%zz%4" ) == "%zz%4" );
 }
 
 TEST_CASE( "decode_parameter", "[uri]" )
 {
     REQUIRE( Uri::decode_parameter( "Corvusoft+Solutions" ) == "Corvusoft Solutions" );
+    REQUIRE( Uri::decode_parameter( "a%2Bb++c" ) == "a+b  c" );
 }
 
 TEST_CASE( "encode", "[uri]" )
 {
     REQUIRE( Uri::encode( "a=b" ) == "a%3Db" );
+    REQUIRE( Uri::encode( "" ) == "" );
+    REQUIRE( Uri::encode( "plain-text_value.txt" ) == "plain-text_value.txt" );
+    REQUIRE( Uri::encode( " \"<>#%{}|\\^~[]`$&+,/:;=?@" ) == "%20%22%3C%3E%23%25%7B%7D%7C%5C%5E%7E%5B%5D%60%24%26%2B%2C%2F%3A%3B%3D%3F%40" );
 }
 
 TEST_CASE( "encode parameter", "[uri]" )
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2013-2017, Corvusoft Ltd, All Rights Reserved.
+ */
+
+//System Includes
+#include <map>
+#include <string>
+
+//Project Includes
+#include "corvusoft/restbed/byte.hpp"
+#include "corvusoft/restbed/urlencoded_parser.hpp"
+
+//External Includes
+#include <catch.hpp>
+
+//System Namespaces
+using std::string;
+using std::multimap;
+
+//Project Namespaces
+using restbed::Byte;
+using restbed::UrlencodedParser;
+
+//External Namespaces
+
+TEST_CASE( "decode parameters regardless of how the body is chunked", "[urlencoded_parser]" )
+{
+    const string body = "name=John+Doe&city=K%C3%B8benhavn&&flag&name=second";
+    
+    const multimap< string, string > expectation =
+    {
+        { "name", "John Doe" },
+        { "city", "K\xC3\xB8" "benhavn" },
+        { "flag", "flag" },
+        { "name", "second" }
+    };
+    
+    for ( size_t chunk = 1; chunk <= body.length( ); chunk++ )
+    {
+        multimap< string, string > parameters;
+        
+        UrlencodedParser parser;
+        
+        for ( size_t position = 0; position < body.length( ); position += chunk )
+        {
+            const size_t length = ( body.length( ) - position < chunk ) ? body.length( ) - position : chunk;
+            parser.parse( reinterpret_cast< const Byte* >( body.data( ) ) + position, length, parameters );
+        }
+        
+        parser.finish( parameters );
+        
+        REQUIRE( parameters == expectation );
+    }
+}
+
+TEST_CASE( "empty body yields no parameters", "[urlencoded_parser]" )
+{
+    multimap< string, string > parameters;
+    
+    UrlencodedParser parser;
+    parser.parse( { }, parameters );
+    parser.finish( parameters );
+    
+    REQUIRE( parameters.empty( ) );
+}
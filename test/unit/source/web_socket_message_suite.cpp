@@ -4,6 +4,7 @@
 
 //System Includes
 #include <tuple>
+#include <utility>
 
 //Project Includes
 #include <corvusoft/restbed/web_socket_message.hpp>
@@ -16,6 +17,7 @@ using std::tuple;
 using std::make_tuple;
 
 //Project Namespaces
+using restbed::Bytes;
 using restbed::WebSocketMessage;
 
 //External Namespaces
@@ -83,3 +85,22 @@ TEST_CASE( "validate mask and mask_flag setter logic", "[web_socket_message]" )
     REQUIRE( message.get_mask( ) == 123424 );
     REQUIRE( message.get_mask_flag( ) == true );
 }
+
+TEST_CASE( "validate rvalue data is moved", "[web_socket_message]" )
+{
+    Bytes data( 200, 'a' );
+    const auto address = data.data( );
+    
+    const WebSocketMessage message( WebSocketMessage::BINARY_FRAME, std::move( data ) );
+    
+    REQUIRE( message.get_data( ).data( ) == address );
+    REQUIRE( message.get_length( ) == 126 );
+    REQUIRE( message.get_extended_length( ) == 200 );
+    
+    WebSocketMessage other;
+    Bytes replacement = { 'b' };
+    const auto replacement_address = replacement.data( );
+    other.set_data( std::move( replacement ) );
+    
+    REQUIRE( other.get_data( ).data( ) == replacement_address );
+}